@@ -20,9 +20,37 @@ namespace sereno
         VTK_FLOAT,
 		VTK_UNSIGNED_CHAR,
         VTK_CHAR,
+        VTK_UNSIGNED_SHORT,
+        VTK_HALF_FLOAT,
         VTK_NO_VALUE_FORMAT
     }
 
+	/// <summary>
+	/// Linear mapping of normalized values : value = Scale*normalized + Offset.
+	/// </summary>
+	[StructLayout(LayoutKind.Sequential)]
+	public struct VTKQuantization
+	{
+		/// <summary>
+		/// The value of one normalized step
+		/// </summary>
+		public double Scale;
+
+		/// <summary>
+		/// The value of the normalized value 0 (the minimum value)
+		/// </summary>
+		public double Offset;
+	};
+
+	/// <summary>
+	/// The format of the indices of element buffers.
+	/// </summary>
+    public enum VTKIndexFormat
+    {
+        VTK_INDEX_UINT16 = 0,
+        VTK_INDEX_UINT32
+    }
+
 	/// <summary>
 	/// The VTK GLMode.
 	/// </summary>
@@ -32,6 +60,7 @@ namespace sereno
         VTK_GL_TRIANGLE_STIP,
         VTK_GL_LINE_STRIP,
         VTK_GL_POINTS,
+        VTK_GL_LINES,
         VTK_GL_NO_MODE
     }
 
@@ -71,6 +100,120 @@ namespace sereno
 		public double[] Origin;
 	};
 
+	/// <summary>
+	/// A box of points of a structured points dataset, read with a step.
+	/// </summary>
+	[StructLayout(LayoutKind.Sequential)]
+	public struct VTKSubVolume
+	{
+		/// <summary>
+		/// The first point of the box along each axis
+		/// </summary>
+		[MarshalAs(UnmanagedType.ByValArray, SizeConst = 3)]
+		public UInt32[] First;
+
+		/// <summary>
+		/// The last point (included) of the box along each axis
+		/// </summary>
+		[MarshalAs(UnmanagedType.ByValArray, SizeConst = 3)]
+		public UInt32[] Last;
+
+		/// <summary>
+		/// The step between two points read along each axis (1 == every point)
+		/// </summary>
+		[MarshalAs(UnmanagedType.ByValArray, SizeConst = 3)]
+		public UInt32[] Step;
+	};
+
+
+	/// <summary>
+	/// Statistics of one component of an array, computed while decoding it. NaN and infinite values are not part of Min, Max and Mean.
+	/// </summary>
+	[StructLayout(LayoutKind.Sequential)]
+	public struct VTKComponentStats
+	{
+		/// <summary>
+		/// The minimum value (0 if there is no finite value)
+		/// </summary>
+		public double Min;
+
+		/// <summary>
+		/// The maximum value (0 if there is no finite value)
+		/// </summary>
+		public double Max;
+
+		/// <summary>
+		/// The mean value (0 if there is no finite value)
+		/// </summary>
+		public double Mean;
+
+		/// <summary>
+		/// The number of NaN values
+		/// </summary>
+		public UInt64 NbNaN;
+	};
+
+	/// <summary>
+	/// An array read by a batch read (see VTKParser.ParseArrays).
+	/// </summary>
+	[StructLayout(LayoutKind.Sequential)]
+	public struct VTKArrayRead
+	{
+		/// <summary>
+		/// The offset of the array in the file
+		/// </summary>
+		public UIntPtr        Offset;
+
+		/// <summary>
+		/// The number of values to read
+		/// </summary>
+		public UIntPtr        NbValues;
+
+		/// <summary>
+		/// The values format
+		/// </summary>
+		public VTKValueFormat  Format;
+
+		/// <summary>
+		/// The format of the values written in Dest. VTK_NO_VALUE_FORMAT == Format
+		/// </summary>
+		public VTKValueFormat  DestFormat;
+
+		/// <summary>
+		/// The buffer to fill. IntPtr.Zero == allocated by the read (needs to be freed using VTKParser_free)
+		/// </summary>
+		public IntPtr          Dest;
+
+		/// <summary>
+		/// The size (in bytes) of Dest. Not used if Dest == IntPtr.Zero
+		/// </summary>
+		public UIntPtr         Capacity;
+
+		/// <summary>
+		/// 1 == normalize the values onto the whole range of DestFormat (VTK_UNSIGNED_CHAR or VTK_UNSIGNED_SHORT), 0 otherwise
+		/// </summary>
+		public byte            Normalize;
+
+		/// <summary>
+		/// Set by the read : 1 if the array has been read, 0 otherwise
+		/// </summary>
+		public byte            Success;
+
+		/// <summary>
+		/// Set by the read of normalized values : the mapping to get the values back
+		/// </summary>
+		public VTKQuantization Quantization;
+
+		/// <summary>
+		/// The number of components per tuple (e.g., 3 for points). Used by Stats
+		/// </summary>
+		public UInt32          NbComponents;
+
+		/// <summary>
+		/// If not IntPtr.Zero, receives the statistics (VTKComponentStats) of each of the NbComponents components (pinned or native memory)
+		/// </summary>
+		public IntPtr          Stats;
+	};
 
 	/// <summary>
 	/// VTK cell construction structure. It contains meta data about celle construction (buffer size, etc.).
@@ -104,6 +247,46 @@ namespace sereno
 		public char      Error;
     }
 
+	/// <summary>
+	/// VTK cell construction structure of every rendering mode, computed in one pass. Arrays are indexed by VTKGLMode.
+	/// </summary>
+	[StructLayout(LayoutKind.Sequential)]
+    public struct VTKMultiCellConstruction
+    {
+        /// <summary>
+        /// Buffer size needed to store the data of each mode
+        /// </summary>
+		[MarshalAs(UnmanagedType.ByValArray, SizeConst = (int)VTKGLMode.VTK_GL_NO_MODE)]
+        public UInt32[] Size;
+
+        /// <summary>
+        /// The position of each mode if every mode is stored in the same buffer
+        /// </summary>
+		[MarshalAs(UnmanagedType.ByValArray, SizeConst = (int)VTKGLMode.VTK_GL_NO_MODE)]
+        public UInt32[] Offset;
+
+        /// <summary>
+        /// The number of cells of each mode
+        /// </summary>
+		[MarshalAs(UnmanagedType.ByValArray, SizeConst = (int)VTKGLMode.VTK_GL_NO_MODE)]
+        public UInt32[] NbCells;
+
+        /// <summary>
+        /// The number of cells parsed
+        /// </summary>
+		public UInt32    NbParsedCells;
+
+        /// <summary>
+        /// What is the offset to apply to the cells data for getting to the next cells to parse ?
+        /// </summary>
+		public UInt32    Next;
+
+        /// <summary>
+        /// Was there an error ? (0 == false, 1 == true)
+        /// </summary>
+		public char      Error;
+    }
+
     /// <summary>
     ///  VTK Point descriptor for Unstructured Grid
     /// </summary>
@@ -126,6 +309,24 @@ namespace sereno
         public UInt64         Offset;
     }
 
+    /// <summary>
+    ///  VTK Structured Grid descriptor. The connectivity is implicit
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct VTKGrid
+    {
+        /// <summary>
+        /// The size of the grid
+        /// </summary>
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 3)]
+        public UInt32[] Size;
+
+        /// <summary>
+        /// The point positions
+        /// </summary>
+        public VTKPointPositions PtsPos;
+    }
+
     /// <summary>
     /// VTK Cell Types descriptor for Unstructured Grid
     /// </summary>
@@ -179,6 +380,14 @@ namespace sereno
 
         [DllImport("serenoVTKParser")]
         public extern static byte VTKParser_parse(IntPtr parser);
+        [DllImport("serenoVTKParser")]
+        public extern static void VTKParser_setNbThreads(IntPtr parser, UInt32 nbThreads);
+        [DllImport("serenoVTKParser")]
+        public extern static void VTKParser_setParallelThreshold(IntPtr parser, UIntPtr size);
+        [DllImport("serenoVTKParser")]
+        public extern static void VTKParser_setCacheEnabled(IntPtr parser, byte enable, [MarshalAs(UnmanagedType.LPStr)] String directory);
+        [DllImport("serenoVTKParser")]
+        public extern static byte VTKParser_isLoadedFromCache(IntPtr parser);
 
 		[DllImport("serenoVTKParser")]
 		public extern static VTKDatasetType VTKParser_getDatasetType(IntPtr parser);
@@ -187,6 +396,28 @@ namespace sereno
 		[DllImport("serenoVTKParser")]
 		public unsafe extern static IntPtr VTKParser_getStructuredPointsDescriptor(IntPtr parser);
 
+        //Structured grid
+        [DllImport("serenoVTKParser")]
+        public extern static IntPtr VTKParser_getStructuredGridDescriptor(IntPtr parser);
+        [DllImport("serenoVTKParser")]
+        public extern static IntPtr VTKParser_parseAllStructuredGridPoints(IntPtr parser);
+        [DllImport("serenoVTKParser")]
+        public extern static IntPtr VTKParser_parseAllStructuredGridPointsAs(IntPtr parser, VTKValueFormat destFormat);
+        [DllImport("serenoVTKParser")]
+        public extern static byte VTKParser_parseAllStructuredGridPointsInto(IntPtr parser, IntPtr dest, UIntPtr capacity);
+        [DllImport("serenoVTKParser")]
+        public unsafe extern static IntPtr VTKParser_parseAllStructuredGridPointsWithStats(IntPtr parser, VTKComponentStats* bounds);
+        [DllImport("serenoVTKParser")]
+        public extern static UInt32 VTKParser_getStructuredGridNbCells(IntPtr parser);
+        [DllImport("serenoVTKParser")]
+        public extern static Int32 VTKParser_getStructuredGridCellType(IntPtr parser);
+        [DllImport("serenoVTKParser")]
+        public extern static byte VTKParser_fillStructuredGridCellElementBuffer(IntPtr parser, UInt32 firstCell, UInt32 nbCells, IntPtr buffer, VTKIndexFormat format);
+        [DllImport("serenoVTKParser")]
+        public extern static UIntPtr VTKParser_getStructuredGridBoundaryElementBufferSize(IntPtr parser);
+        [DllImport("serenoVTKParser")]
+        public extern static byte VTKParser_fillStructuredGridBoundaryElementBuffer(IntPtr parser, IntPtr buffer, VTKIndexFormat format);
+
         //Unstructured grid
         [DllImport("serenoVTKParser")]
         public extern static VTKPointPositions VTKParser_getUnstructuredGridPointDescriptor(IntPtr parser);
@@ -195,17 +426,45 @@ namespace sereno
         [DllImport("serenoVTKParser")]
         public extern static VTKCells VTKParser_getUnstructuredGridCellDescriptor(IntPtr parser);
         [DllImport("serenoVTKParser")]
+        public extern static byte VTKParser_buildUnstructuredGridCellIndex(IntPtr parser);
+        [DllImport("serenoVTKParser")]
+        public unsafe extern static UInt32* VTKParser_getUnstructuredGridCellIndex(IntPtr parser);
+        [DllImport("serenoVTKParser")]
         public unsafe extern static IntPtr VTKParser_parseAllUnstructuredGridCellsComposition(IntPtr parser);
         [DllImport("serenoVTKParser")]
         public unsafe extern static IntPtr VTKParser_parseAllUnstructuredGridCellTypes(IntPtr parser);
         [DllImport("serenoVTKParser")]
         public extern static IntPtr VTKParser_parseAllUnstructuredGridPoints(IntPtr parser);
         [DllImport("serenoVTKParser")]
+        public extern static IntPtr VTKParser_parseAllUnstructuredGridPointsAs(IntPtr parser, VTKValueFormat destFormat);
+        [DllImport("serenoVTKParser")]
+        public unsafe extern static IntPtr VTKParser_parseAllUnstructuredGridPointsWithStats(IntPtr parser, VTKComponentStats* bounds);
+        [DllImport("serenoVTKParser")]
         public unsafe extern static VTKCellConstruction VTKParser_getCellConstructionDescriptor(UInt32 nbCells, Int32* cellValues, Int32* cellTypes);
         [DllImport("serenoVTKParser")]
         public unsafe extern static void VTKParser_fillUnstructuredGridCellBuffer(IntPtr parser, UInt32 nbCells, IntPtr ptValues, Int32* cellValues, Int32* cellTypes, IntPtr buffer, VTKValueFormat destFormat);
 		[DllImport("serenoVTKParser")]
 		public unsafe extern static void VTKParser_fillUnstructuredGridCellElementBuffer(IntPtr parser, UInt32 nbCells, Int32* cellValues, Int32* cellTypes, Int32* buffer);
+        [DllImport("serenoVTKParser")]
+        public unsafe extern static VTKMultiCellConstruction VTKParser_getMultiCellConstructionDescriptor(UInt32 nbCells, Int32* cellValues, Int32* cellTypes);
+        [DllImport("serenoVTKParser")]
+        public unsafe extern static void VTKParser_fillUnstructuredGridCellBuffers(IntPtr parser, UInt32 nbCells, IntPtr ptValues, Int32* cellValues, Int32* cellTypes, IntPtr* buffers, VTKValueFormat destFormat);
+        [DllImport("serenoVTKParser")]
+        public unsafe extern static void VTKParser_fillUnstructuredGridCellElementBuffers(IntPtr parser, UInt32 nbCells, Int32* cellValues, Int32* cellTypes, Int32** buffers);
+        [DllImport("serenoVTKParser")]
+        public unsafe extern static byte VTKParser_computeUnstructuredGridMortonOrder(IntPtr parser, IntPtr points, UInt32 nbCells, Int32* cellValues, UIntPtr nbValues, UInt32* pointOrder, UInt32* cellOrder);
+        [DllImport("serenoVTKParser")]
+        public unsafe extern static byte VTKParser_permuteTuples(IntPtr parser, IntPtr src, UInt32 nbTuples, UIntPtr tupleSize, UInt32* order, IntPtr dest);
+        [DllImport("serenoVTKParser")]
+        public unsafe extern static byte VTKParser_remapUnstructuredGridCells(IntPtr parser, UInt32 nbCells, Int32* cellValues, UIntPtr nbValues, UInt32 nbPoints, UInt32* pointOrder, UInt32* cellOrder, Int32* dest);
+        [DllImport("serenoVTKParser")]
+        public unsafe extern static UIntPtr VTKParser_getUnstructuredGridCellElementBufferSize(IntPtr parser, UInt32 nbCells, Int32* cellValues, Int32* cellTypes, VTKGLMode mode);
+        [DllImport("serenoVTKParser")]
+        public unsafe extern static byte VTKParser_fillUnstructuredGridCellIndexedElementBuffer(IntPtr parser, UInt32 nbCells, Int32* cellValues, Int32* cellTypes, VTKGLMode mode,
+                                                                                                IntPtr buffer, VTKIndexFormat format);
+        [DllImport("serenoVTKParser")]
+        public unsafe extern static IntPtr VTKParser_extractUnstructuredGridBoundaryElementBuffer(IntPtr parser, UInt32 nbCells, Int32* cellValues, Int32* cellTypes,
+                                                                                                 VTKIndexFormat format, UIntPtr* nbIndices);
 
         //Field Value
         [DllImport("serenoVTKParser")]
@@ -223,6 +482,40 @@ namespace sereno
         [DllImport("serenoVTKParser")]
         public unsafe extern static IntPtr VTKParser_parseAllFieldValues(IntPtr parser, IntPtr val);
         [DllImport("serenoVTKParser")]
+        public unsafe extern static byte VTKParser_parseAllFieldValuesInto(IntPtr parser, IntPtr val, IntPtr dest, UIntPtr capacity);
+        [DllImport("serenoVTKParser")]
+        public unsafe extern static IntPtr VTKParser_parseAllFieldValuesAs(IntPtr parser, IntPtr val, VTKValueFormat destFormat, VTKQuantization* quantization);
+        [DllImport("serenoVTKParser")]
+        public unsafe extern static byte VTKParser_parseAllFieldValuesAsInto(IntPtr parser, IntPtr val, IntPtr dest, UIntPtr capacity, VTKValueFormat destFormat, VTKQuantization* quantization);
+        [DllImport("serenoVTKParser")]
+        public unsafe extern static IntPtr VTKParser_parseAllFieldValuesWithStats(IntPtr parser, IntPtr val, VTKComponentStats* stats);
+        [DllImport("serenoVTKParser")]
+        public unsafe extern static byte VTKParser_parseAllFieldValuesWithStatsInto(IntPtr parser, IntPtr val, IntPtr dest, UIntPtr capacity, VTKComponentStats* stats);
+        [DllImport("serenoVTKParser")]
+        public extern static VTKArrayRead VTKParser_getFieldValuesRead(IntPtr val, IntPtr dest, UIntPtr capacity);
+        [DllImport("serenoVTKParser")]
+        public extern static VTKArrayRead VTKParser_getUnstructuredGridPointsRead(IntPtr parser, IntPtr dest, UIntPtr capacity);
+        [DllImport("serenoVTKParser")]
+        public extern static VTKArrayRead VTKParser_getUnstructuredGridCellsRead(IntPtr parser, IntPtr dest, UIntPtr capacity);
+        [DllImport("serenoVTKParser")]
+        public extern static VTKArrayRead VTKParser_getUnstructuredGridCellTypesRead(IntPtr parser, IntPtr dest, UIntPtr capacity);
+        [DllImport("serenoVTKParser")]
+        public extern static VTKArrayRead VTKParser_getStructuredGridPointsRead(IntPtr parser, IntPtr dest, UIntPtr capacity);
+        [DllImport("serenoVTKParser")]
+        public extern static byte VTKParser_parseArrays(IntPtr parser, [In, Out] VTKArrayRead[] reads, UIntPtr nbReads);
+        [DllImport("serenoVTKParser")]
+        public extern static byte VTKParser_getStructuredPointsSubVolumeDescriptor(IntPtr parser, ref VTKSubVolume box, out VTKStructuredPoints descriptor);
+        [DllImport("serenoVTKParser")]
+        public extern static IntPtr VTKParser_parseStructuredPointsFieldValues(IntPtr parser, IntPtr val, ref VTKSubVolume box, out VTKStructuredPoints descriptor);
+        [DllImport("serenoVTKParser")]
+        public extern static byte VTKParser_parseStructuredPointsFieldValuesInto(IntPtr parser, IntPtr val, ref VTKSubVolume box, IntPtr dest, UIntPtr capacity, out VTKStructuredPoints descriptor);
+        [DllImport("serenoVTKParser")]
+        public extern static byte VTKParser_parseAllUnstructuredGridPointsInto(IntPtr parser, IntPtr dest, UIntPtr capacity);
+        [DllImport("serenoVTKParser")]
+        public unsafe extern static byte VTKParser_parseAllUnstructuredGridCellsCompositionInto(IntPtr parser, Int32* dest, UIntPtr capacity);
+        [DllImport("serenoVTKParser")]
+        public unsafe extern static byte VTKParser_parseAllUnstructuredGridCellTypesInto(IntPtr parser, Int32* dest, UIntPtr capacity);
+        [DllImport("serenoVTKParser")]
         public extern static void VTKParser_free(IntPtr value);
     }
 
@@ -284,7 +577,8 @@ namespace sereno
     }
 
     /// <summary>
-    /// VTK Parser class. Permit to parse (a.k.a read) VTK file object
+    /// VTK Parser class. Permit to parse (a.k.a read) VTK file object.
+    /// Once Parse() has succeeded, the arrays (points, cells, field values) can be read concurrently from several threads with the same parser
     /// </summary>
     public class VTKParser
     {
@@ -315,6 +609,44 @@ namespace sereno
             return VTKInterop.VTKParser_parse(m_parser) != 0;
         }
 
+        /// <summary>
+        /// Set the number of threads used to decode large arrays.
+        /// </summary>
+        /// <param name="nbThreads">The number of threads (caller included). 0 == the number of hardware threads, 1 == serial decoding.</param>
+        public void SetNbThreads(UInt32 nbThreads)
+        {
+            VTKInterop.VTKParser_setNbThreads(m_parser, nbThreads);
+        }
+
+        /// <summary>
+        /// Set the size under which arrays are decoded serially.
+        /// </summary>
+        /// <param name="size">The size in bytes.</param>
+        public void SetParallelThreshold(UInt64 size)
+        {
+            VTKInterop.VTKParser_setParallelThreshold(m_parser, (UIntPtr)size);
+        }
+
+        /// <summary>
+        /// Enable the binary cache sidecar. Must be called before Parse.
+        /// Parse then loads an up to date cache file instead of parsing the VTK file, or writes it.
+        /// </summary>
+        /// <param name="enable">true to use the cache.</param>
+        /// <param name="directory">The directory of the cache files. null or empty == next to the VTK file.</param>
+        public void SetCacheEnabled(bool enable, String directory = null)
+        {
+            VTKInterop.VTKParser_setCacheEnabled(m_parser, (byte)(enable ? 1 : 0), directory);
+        }
+
+        /// <summary>
+        /// Has the last Parse been served by the cache file?
+        /// </summary>
+        /// <returns>true if the data are read from the cache file.</returns>
+        public bool IsLoadedFromCache()
+        {
+            return VTKInterop.VTKParser_isLoadedFromCache(m_parser) != 0;
+        }
+
 		/// <summary>
 		/// Gets the type of the dataset.
 		/// </summary>
@@ -333,6 +665,137 @@ namespace sereno
             return (VTKStructuredPoints)Marshal.PtrToStructure(VTKInterop.VTKParser_getStructuredPointsDescriptor(m_parser), typeof(VTKStructuredPoints));
 		}
 
+        /// <summary>
+        /// Gets the structured grid descriptor.
+        /// </summary>
+        /// <returns>The structured grid descriptor.</returns>
+        public VTKGrid GetStructuredGridDescriptor()
+        {
+            return (VTKGrid)Marshal.PtrToStructure(VTKInterop.VTKParser_getStructuredGridDescriptor(m_parser), typeof(VTKGrid));
+        }
+
+        /// <summary>
+        /// Parse all the Structured Grid Points (x varying fastest, then y, then z).
+        /// </summary>
+        /// <returns>A VTKValue of these points.</returns>
+        public VTKValue ParseAllStructuredGridPoints()
+        {
+            VTKValue val  = new VTKValue();
+            VTKGrid  grid = GetStructuredGridDescriptor();
+
+            val.Value    = VTKInterop.VTKParser_parseAllStructuredGridPoints(m_parser);
+            val.Format   = grid.PtsPos.Format;
+            val.NbValues = grid.PtsPos.NbPoints*3;
+            return val;
+        }
+
+        /// <summary>
+        /// Parse all the Structured Grid Points, converted into another format.
+        /// </summary>
+        /// <param name="destFormat">The format of the returned values.</param>
+        /// <returns>A VTKValue of these points.</returns>
+        public VTKValue ParseAllStructuredGridPoints(VTKValueFormat destFormat)
+        {
+            VTKValue val  = new VTKValue();
+            VTKGrid  grid = GetStructuredGridDescriptor();
+
+            val.Value    = VTKInterop.VTKParser_parseAllStructuredGridPointsAs(m_parser, destFormat);
+            val.Format   = destFormat;
+            val.NbValues = grid.PtsPos.NbPoints*3;
+            return val;
+        }
+
+        /// <summary>
+        /// Parse all the Structured Grid Points, computing their bounding box while decoding them.
+        /// </summary>
+        /// <param name="bounds">The statistics of the x, y and z components : Min and Max are the bounding box, Mean is the centroid.</param>
+        /// <returns>A VTKValue of these points.</returns>
+        public unsafe VTKValue ParseAllStructuredGridPoints(out VTKComponentStats[] bounds)
+        {
+            VTKValue val  = new VTKValue();
+            VTKGrid  grid = GetStructuredGridDescriptor();
+
+            bounds = new VTKComponentStats[3];
+            fixed(VTKComponentStats* b = bounds)
+            {
+                val.Value = VTKInterop.VTKParser_parseAllStructuredGridPointsWithStats(m_parser, b);
+            }
+            val.Format   = grid.PtsPos.Format;
+            val.NbValues = grid.PtsPos.NbPoints*3;
+            return val;
+        }
+
+        /// <summary>
+        /// Parse all the Structured Grid Points into a caller-provided buffer (pinned or native memory)
+        /// </summary>
+        /// <returns>true on success, false otherwise (buffer too small, read error).</returns>
+        /// <param name="dest">The buffer to fill.</param>
+        /// <param name="capacity">The size (in bytes) of the buffer.</param>
+        public bool ParseAllStructuredGridPointsInto(IntPtr dest, UInt64 capacity)
+        {
+            return VTKInterop.VTKParser_parseAllStructuredGridPointsInto(m_parser, dest, (UIntPtr)capacity) != 0;
+        }
+
+        /// <summary>
+        /// Get the number of cells of the structured grid (implicit connectivity).
+        /// </summary>
+        /// <returns>The number of cells.</returns>
+        public UInt32 GetStructuredGridNbCells()
+        {
+            return VTKInterop.VTKParser_getStructuredGridNbCells(m_parser);
+        }
+
+        /// <summary>
+        /// Get the VTK type of the cells of the structured grid (hexahedron, quad, line or vertex).
+        /// </summary>
+        /// <returns>The VTK cell type.</returns>
+        public Int32 GetStructuredGridCellType()
+        {
+            return VTKInterop.VTKParser_getStructuredGridCellType(m_parser);
+        }
+
+        /// <summary>
+        /// Fill an element buffer with the points of a range of cells of the structured grid, generated from the grid dimensions.
+        /// </summary>
+        /// <param name="firstCell">The first cell.</param>
+        /// <param name="nbCells">Nb cells.</param>
+        /// <param name="buffer">Buffer (nbCells * number of points per cell indices).</param>
+        /// <param name="format">The indices format.</param>
+        /// <returns>true on success, false on failure (out of range, index not representable in format).</returns>
+        public bool FillStructuredGridCellElementBuffer(UInt32 firstCell, UInt32 nbCells, IntPtr buffer, VTKIndexFormat format)
+        {
+            return VTKInterop.VTKParser_fillStructuredGridCellElementBuffer(m_parser, firstCell, nbCells, buffer, format) != 0;
+        }
+
+        /// <summary>
+        /// Get the number of indices of the boundary surface of the structured grid.
+        /// </summary>
+        /// <returns>The number of indices.</returns>
+        public UInt64 GetStructuredGridBoundaryElementBufferSize()
+        {
+            return (UInt64)VTKInterop.VTKParser_getStructuredGridBoundaryElementBufferSize(m_parser);
+        }
+
+        /// <summary>
+        /// Fill an indexed triangle element buffer with the boundary surface of the structured grid.
+        /// </summary>
+        /// <param name="buffer">Buffer (GetStructuredGridBoundaryElementBufferSize indices).</param>
+        /// <param name="format">The indices format.</param>
+        /// <returns>true on success, false if a point index cannot be represented in format.</returns>
+        public bool FillStructuredGridBoundaryElementBuffer(IntPtr buffer, VTKIndexFormat format)
+        {
+            return VTKInterop.VTKParser_fillStructuredGridBoundaryElementBuffer(m_parser, buffer, format) != 0;
+        }
+
+        /// <summary>
+        /// Build the index of the unstructured grid cells, locating any cell in constant time. Call it once after Parse.
+        /// </summary>
+        /// <returns>true on success, false on failure.</returns>
+        public bool BuildUnstructuredGridCellIndex()
+        {
+            return VTKInterop.VTKParser_buildUnstructuredGridCellIndex(m_parser) != 0;
+        }
+
         /// <summary>
         /// Get the values of Cell composition for unstructured grid. Use TODO for getting triangle composition of these cells
         /// </summary>
@@ -408,6 +871,224 @@ namespace sereno
             return val;
         }
 
+        /// <summary>
+        /// Get the concrete Value of a Field Value into a caller-provided buffer (pinned or native memory)
+        /// </summary>
+        /// <returns>true on success, false otherwise (buffer too small, read error).</returns>
+        /// <param name="fieldVal">The field value descriptor.</param>
+        /// <param name="dest">The buffer to fill.</param>
+        /// <param name="capacity">The size (in bytes) of the buffer.</param>
+        public bool ParseAllFieldValuesInto(VTKFieldValue fieldVal, IntPtr dest, UInt64 capacity)
+        {
+            return VTKInterop.VTKParser_parseAllFieldValuesInto(m_parser, fieldVal.NativePtr, dest, (UIntPtr)capacity) != 0;
+        }
+
+        /// <summary>
+        /// Get the concrete Value of a Field Value, converted into another format while decoding (e.g., VTK_DOUBLE to VTK_FLOAT, VTK_FLOAT to VTK_HALF_FLOAT)
+        /// </summary>
+        /// <returns>The VTK value. Its Value is IntPtr.Zero on error.</returns>
+        /// <param name="fieldVal">The field value descriptor.</param>
+        /// <param name="destFormat">The format of the returned values.</param>
+        public unsafe VTKValue ParseAllFieldValues(VTKFieldValue fieldVal, VTKValueFormat destFormat)
+        {
+            VTKValue val = new VTKValue();
+            val.NbValues = fieldVal.NbTuples * fieldVal.NbValuesPerTuple;
+            val.Value    = VTKInterop.VTKParser_parseAllFieldValuesAs(m_parser, fieldVal.NativePtr, destFormat, null);
+            val.Format   = destFormat;
+
+            return val;
+        }
+
+        /// <summary>
+        /// Get the concrete Value of a Field Value, normalized onto the whole range of destFormat (VTK_UNSIGNED_CHAR or VTK_UNSIGNED_SHORT). NaN are mapped to 0
+        /// </summary>
+        /// <returns>The VTK value. Its Value is IntPtr.Zero on error.</returns>
+        /// <param name="fieldVal">The field value descriptor.</param>
+        /// <param name="destFormat">The format of the returned values.</param>
+        /// <param name="quantization">The mapping to get the values back (value = Scale*normalized + Offset).</param>
+        public unsafe VTKValue ParseAllFieldValuesNormalized(VTKFieldValue fieldVal, VTKValueFormat destFormat, out VTKQuantization quantization)
+        {
+            VTKQuantization q = new VTKQuantization();
+            VTKValue val = new VTKValue();
+            val.NbValues = fieldVal.NbTuples * fieldVal.NbValuesPerTuple;
+            val.Value    = VTKInterop.VTKParser_parseAllFieldValuesAs(m_parser, fieldVal.NativePtr, destFormat, &q);
+            val.Format   = destFormat;
+
+            quantization = q;
+            return val;
+        }
+
+        /// <summary>
+        /// Get the concrete Value of a Field Value, computing the statistics of each component (e.g., the range of a colormap) while decoding it
+        /// </summary>
+        /// <returns>The VTK value. Its Value is IntPtr.Zero on error.</returns>
+        /// <param name="fieldVal">The field value descriptor.</param>
+        /// <param name="stats">The statistics of each component (NbValuesPerTuple values).</param>
+        public unsafe VTKValue ParseAllFieldValues(VTKFieldValue fieldVal, out VTKComponentStats[] stats)
+        {
+            VTKValue val = new VTKValue();
+            val.NbValues = fieldVal.NbTuples * fieldVal.NbValuesPerTuple;
+            val.Format   = fieldVal.Format;
+
+            stats = new VTKComponentStats[fieldVal.NbValuesPerTuple];
+            fixed(VTKComponentStats* s = stats)
+            {
+                val.Value = VTKInterop.VTKParser_parseAllFieldValuesWithStats(m_parser, fieldVal.NativePtr, s);
+            }
+            return val;
+        }
+
+        /// <summary>
+        /// Get the concrete Value of a Field Value into a caller-provided buffer (pinned or native memory), computing the statistics of each component while decoding it
+        /// </summary>
+        /// <returns>true on success, false otherwise (buffer too small, read error).</returns>
+        /// <param name="fieldVal">The field value descriptor.</param>
+        /// <param name="dest">The buffer to fill.</param>
+        /// <param name="capacity">The size (in bytes) of the buffer.</param>
+        /// <param name="stats">The statistics of each component (NbValuesPerTuple values).</param>
+        public unsafe bool ParseAllFieldValuesInto(VTKFieldValue fieldVal, IntPtr dest, UInt64 capacity, out VTKComponentStats[] stats)
+        {
+            stats = new VTKComponentStats[fieldVal.NbValuesPerTuple];
+            fixed(VTKComponentStats* s = stats)
+            {
+                return VTKInterop.VTKParser_parseAllFieldValuesWithStatsInto(m_parser, fieldVal.NativePtr, dest, (UIntPtr)capacity, s) != 0;
+            }
+        }
+
+        /// <summary>
+        /// Get the concrete Values of several Field Values at once, in one forward sweep of the file (see ParseArrays)
+        /// </summary>
+        /// <returns>The VTK values, in the order of fieldVals. The Value of a field value not read is IntPtr.Zero.</returns>
+        /// <param name="fieldVals">The field value descriptors.</param>
+        public VTKValue[] ParseAllFieldValues(VTKFieldValue[] fieldVals)
+        {
+            VTKArrayRead[] reads = new VTKArrayRead[fieldVals.Length];
+            for(int i = 0; i < fieldVals.Length; i++)
+                reads[i] = GetFieldValuesRead(fieldVals[i], IntPtr.Zero, 0);
+            ParseArrays(reads);
+
+            VTKValue[] vals = new VTKValue[fieldVals.Length];
+            for(int i = 0; i < fieldVals.Length; i++)
+            {
+                vals[i]          = new VTKValue();
+                vals[i].NbValues = fieldVals[i].NbTuples * fieldVals[i].NbValuesPerTuple;
+                vals[i].Value    = (reads[i].Success != 0 ? reads[i].Dest : IntPtr.Zero);
+                vals[i].Format   = fieldVals[i].Format;
+            }
+            return vals;
+        }
+
+        /// <summary>
+        /// Get the read of all the values of a Field Value, for ParseArrays
+        /// </summary>
+        /// <returns>The read.</returns>
+        /// <param name="fieldVal">The field value descriptor.</param>
+        /// <param name="dest">The buffer to fill (pinned or native memory). IntPtr.Zero == allocated by ParseArrays.</param>
+        /// <param name="capacity">The size (in bytes) of the buffer.</param>
+        public VTKArrayRead GetFieldValuesRead(VTKFieldValue fieldVal, IntPtr dest, UInt64 capacity)
+        {
+            return VTKInterop.VTKParser_getFieldValuesRead(fieldVal.NativePtr, dest, (UIntPtr)capacity);
+        }
+
+        /// <summary>
+        /// Get the read of all the unstructured grid points, for ParseArrays. See GetFieldValuesRead
+        /// </summary>
+        public VTKArrayRead GetUnstructuredGridPointsRead(IntPtr dest, UInt64 capacity)
+        {
+            return VTKInterop.VTKParser_getUnstructuredGridPointsRead(m_parser, dest, (UIntPtr)capacity);
+        }
+
+        /// <summary>
+        /// Get the read of the unstructured grid cells values, for ParseArrays. See GetFieldValuesRead
+        /// </summary>
+        public VTKArrayRead GetUnstructuredGridCellsRead(IntPtr dest, UInt64 capacity)
+        {
+            return VTKInterop.VTKParser_getUnstructuredGridCellsRead(m_parser, dest, (UIntPtr)capacity);
+        }
+
+        /// <summary>
+        /// Get the read of the unstructured grid cells types, for ParseArrays. See GetFieldValuesRead
+        /// </summary>
+        public VTKArrayRead GetUnstructuredGridCellTypesRead(IntPtr dest, UInt64 capacity)
+        {
+            return VTKInterop.VTKParser_getUnstructuredGridCellTypesRead(m_parser, dest, (UIntPtr)capacity);
+        }
+
+        /// <summary>
+        /// Get the read of all the structured grid points, for ParseArrays. See GetFieldValuesRead
+        /// </summary>
+        public VTKArrayRead GetStructuredGridPointsRead(IntPtr dest, UInt64 capacity)
+        {
+            return VTKInterop.VTKParser_getStructuredGridPointsRead(m_parser, dest, (UIntPtr)capacity);
+        }
+
+        /// <summary>
+        /// Read several arrays at once : the reads are sorted by offset, the file is swept once forward and the arrays are decoded concurrently
+        /// </summary>
+        /// <returns>true if every array has been read, false otherwise (see the Success field of each read).</returns>
+        /// <param name="reads">The arrays to read. Their Dest (if IntPtr.Zero) and Success fields are set.</param>
+        public bool ParseArrays(VTKArrayRead[] reads)
+        {
+            return VTKInterop.VTKParser_parseArrays(m_parser, reads, (UIntPtr)reads.Length) != 0;
+        }
+
+        /// <summary>
+        /// Get the structured points descriptor of a sub-volume (size, and spacing and origin adjusted to the box and the steps)
+        /// </summary>
+        /// <returns>true if the box is valid, false otherwise.</returns>
+        /// <param name="box">The sub-volume.</param>
+        /// <param name="descriptor">The descriptor of the sub-volume.</param>
+        public bool GetStructuredPointsSubVolumeDescriptor(VTKSubVolume box, out VTKStructuredPoints descriptor)
+        {
+            return VTKInterop.VTKParser_getStructuredPointsSubVolumeDescriptor(m_parser, ref box, out descriptor) != 0;
+        }
+
+        /// <summary>
+        /// Get a sub-volume (optionally downsampled) of a point Field Value of a structured points dataset. Only the rows of the box are read
+        /// </summary>
+        /// <returns>The values of the sub-volume, null on error (invalid box, not a point field value).</returns>
+        /// <param name="fieldVal">The point field value descriptor.</param>
+        /// <param name="box">The sub-volume to read.</param>
+        /// <param name="descriptor">The structured points descriptor of the values returned.</param>
+        public VTKValue ParseStructuredPointsFieldValues(VTKFieldValue fieldVal, VTKSubVolume box, out VTKStructuredPoints descriptor)
+        {
+            IntPtr data = VTKInterop.VTKParser_parseStructuredPointsFieldValues(m_parser, fieldVal.NativePtr, ref box, out descriptor);
+            if(data == IntPtr.Zero)
+                return null;
+
+            VTKValue val = new VTKValue();
+            val.NbValues = (UInt64)descriptor.Size[0] * descriptor.Size[1] * descriptor.Size[2] * fieldVal.NbValuesPerTuple;
+            val.Value    = data;
+            val.Format   = fieldVal.Format;
+
+            return val;
+        }
+
+        /// <summary>
+        /// Get a sub-volume (optionally downsampled) of a point Field Value of a structured points dataset into a caller-provided buffer (pinned or native memory)
+        /// </summary>
+        /// <returns>true on success, false otherwise (invalid box, not a point field value, buffer too small).</returns>
+        /// <param name="fieldVal">The point field value descriptor.</param>
+        /// <param name="box">The sub-volume to read.</param>
+        /// <param name="dest">The buffer to fill.</param>
+        /// <param name="capacity">The size (in bytes) of the buffer.</param>
+        /// <param name="descriptor">The structured points descriptor of the values written.</param>
+        public bool ParseStructuredPointsFieldValuesInto(VTKFieldValue fieldVal, VTKSubVolume box, IntPtr dest, UInt64 capacity, out VTKStructuredPoints descriptor)
+        {
+            return VTKInterop.VTKParser_parseStructuredPointsFieldValuesInto(m_parser, fieldVal.NativePtr, ref box, dest, (UIntPtr)capacity, out descriptor) != 0;
+        }
+
+        /// <summary>
+        /// Parse all the Unstructured Grid Points into a caller-provided buffer (pinned or native memory)
+        /// </summary>
+        /// <returns>true on success, false otherwise (buffer too small, read error).</returns>
+        /// <param name="dest">The buffer to fill.</param>
+        /// <param name="capacity">The size (in bytes) of the buffer.</param>
+        public bool ParseAllUnstructuredGridPointsInto(IntPtr dest, UInt64 capacity)
+        {
+            return VTKInterop.VTKParser_parseAllUnstructuredGridPointsInto(m_parser, dest, (UIntPtr)capacity) != 0;
+        }
+
         /// <summary>
         /// Parse all the Unstructured Grid Points available in this dataset.   
         /// Use FillUnstructuredGridCellBuffer for getting triangle composition of these cells 
@@ -440,6 +1121,90 @@ namespace sereno
             }
         }
 
+        /// <summary>
+        /// Parse all the Unstructured Grid Points, converted into another format.
+        /// Use with FillUnstructuredGridCellIndexedElementBuffer to upload every point only once.
+        /// </summary>
+        /// <param name="destFormat">The format of the returned values.</param>
+        /// <returns>A VTKValue of these points.</returns>
+        public VTKValue ParseAllUnstructuredGridPoints(VTKValueFormat destFormat)
+        {
+            VTKValue          val = new VTKValue();
+            VTKPointPositions pos = VTKInterop.VTKParser_getUnstructuredGridPointDescriptor(m_parser);
+
+            val.Value    = VTKInterop.VTKParser_parseAllUnstructuredGridPointsAs(m_parser, destFormat);
+            val.Format   = destFormat;
+            val.NbValues = pos.NbPoints*3;
+            return val;
+        }
+
+        /// <summary>
+        /// Parse all the Unstructured Grid Points, computing their bounding box while decoding them.
+        /// </summary>
+        /// <param name="bounds">The statistics of the x, y and z components : Min and Max are the bounding box, Mean is the centroid.</param>
+        /// <returns>A VTKValue of these points.</returns>
+        public unsafe VTKValue ParseAllUnstructuredGridPoints(out VTKComponentStats[] bounds)
+        {
+            VTKValue          val = new VTKValue();
+            VTKPointPositions pos = VTKInterop.VTKParser_getUnstructuredGridPointDescriptor(m_parser);
+
+            bounds = new VTKComponentStats[3];
+            fixed(VTKComponentStats* b = bounds)
+            {
+                val.Value = VTKInterop.VTKParser_parseAllUnstructuredGridPointsWithStats(m_parser, b);
+            }
+            val.Format   = pos.Format;
+            val.NbValues = pos.NbPoints*3;
+            return val;
+        }
+
+        /// <summary>
+        /// Get the number of indices of the cells rendered with a given mode.
+        /// </summary>
+        /// <param name="nbCells">Nb cells.</param>
+        /// <param name="cellValues">Cell values.</param>
+        /// <param name="cellTypes">Cell types.</param>
+        /// <param name="mode">The rendering mode of the cells to take into account.</param>
+        /// <returns>The number of indices.</returns>
+        public unsafe UInt64 GetUnstructuredGridCellElementBufferSize(UInt32 nbCells, VTKValue cellValues, VTKValue cellTypes, VTKGLMode mode)
+        {
+            return (UInt64)VTKInterop.VTKParser_getUnstructuredGridCellElementBufferSize(m_parser, nbCells, (Int32*)cellValues.Value, (Int32*)cellTypes.Value, mode);
+        }
+
+        /// <summary>
+        /// Fill an indexed element buffer with the cells rendered with a given mode. The indices refer to the dataset points.
+        /// </summary>
+        /// <param name="nbCells">Nb cells.</param>
+        /// <param name="cellValues">Cell values.</param>
+        /// <param name="cellTypes">Cell types.</param>
+        /// <param name="mode">The rendering mode of the cells to write.</param>
+        /// <param name="buffer">Buffer (GetUnstructuredGridCellElementBufferSize indices).</param>
+        /// <param name="format">The indices format.</param>
+        /// <returns>true on success, false if a point index cannot be represented in format.</returns>
+        public unsafe bool FillUnstructuredGridCellIndexedElementBuffer(UInt32 nbCells, VTKValue cellValues, VTKValue cellTypes, VTKGLMode mode, IntPtr buffer, VTKIndexFormat format)
+        {
+            return VTKInterop.VTKParser_fillUnstructuredGridCellIndexedElementBuffer(m_parser, nbCells, (Int32*)cellValues.Value, (Int32*)cellTypes.Value, mode, buffer, format) != 0;
+        }
+
+        /// <summary>
+        /// Extract the boundary surface of the cells (faces of 3D cells not shared with another cell, and 2D cells) as an indexed triangle element buffer.
+        /// </summary>
+        /// <param name="nbCells">Nb cells.</param>
+        /// <param name="cellValues">Cell values.</param>
+        /// <param name="cellTypes">Cell types.</param>
+        /// <param name="format">The indices format.</param>
+        /// <returns>The indices (VTK_GL_TRIANGLES). Value is IntPtr.Zero on error.</returns>
+        public unsafe VTKValue ExtractUnstructuredGridBoundaryElementBuffer(UInt32 nbCells, VTKValue cellValues, VTKValue cellTypes, VTKIndexFormat format)
+        {
+            VTKValue val = new VTKValue();
+            UIntPtr  nb  = UIntPtr.Zero;
+
+            val.Value    = VTKInterop.VTKParser_extractUnstructuredGridBoundaryElementBuffer(m_parser, nbCells, (Int32*)cellValues.Value, (Int32*)cellTypes.Value, format, &nb);
+            val.Format   = VTKValueFormat.VTK_NO_VALUE_FORMAT;
+            val.NbValues = (UInt64)nb;
+            return val;
+        }
+
         /// <summary>
         /// Gets the field values descriptor.
         /// </summary>
@@ -482,6 +1247,93 @@ namespace sereno
             }
         }
 
+		/// <summary>
+		/// Gets the construction descriptor of every rendering mode in one pass.
+		/// </summary>
+		/// <returns>The multi-mode cell construction descriptor.</returns>
+		/// <param name="nbCells">Nb cells.</param>
+		/// <param name="cellValues">Cell values.</param>
+		/// <param name="cellTypes">Cell types.</param>
+        public static VTKMultiCellConstruction GetMultiCellConstructionDescriptor(UInt32 nbCells, VTKValue cellValues, VTKValue cellTypes)
+        {
+            unsafe
+            { 
+                return VTKInterop.VTKParser_getMultiCellConstructionDescriptor(nbCells, (Int32*)cellValues.Value, (Int32*)cellTypes.Value);
+            }
+        }
+
+		/// <summary>
+		/// Fills the vertex buffers of every rendering mode in one sweep.
+		/// </summary>
+		/// <param name="nbCells">Nb cells.</param>
+		/// <param name="ptValues">Point values.</param>
+		/// <param name="cellValues">Cell values.</param>
+		/// <param name="cellTypes">Cell types.</param>
+		/// <param name="buffers">One buffer per VTKGLMode. IntPtr.Zero skips the cells of this mode.</param>
+		/// <param name="destFormat">Destination format.</param>
+		public unsafe void FillUnstructuredGridCellBuffers(UInt32 nbCells, VTKValue ptValues, VTKValue cellValues, VTKValue cellTypes, IntPtr[] buffers, VTKValueFormat destFormat = VTKValueFormat.VTK_NO_VALUE_FORMAT)
+        {
+            fixed(IntPtr* b = buffers)
+            {
+                VTKInterop.VTKParser_fillUnstructuredGridCellBuffers(m_parser, nbCells, ptValues.Value, (Int32*)cellValues.Value, (Int32*)cellTypes.Value, b, destFormat);
+            }
+        }
+
+		/// <summary>
+		/// Computes a Z-order (Morton) reordering of the unstructured grid : points sorted by the Morton code of their position, cells by the Morton code of their centroid.
+		/// Apply it with PermuteTuples (points, cell types, field values) and RemapUnstructuredGridCells (cell values).
+		/// </summary>
+		/// <returns>true on success, false on failure (not an unstructured grid, corrupted cells).</returns>
+		/// <param name="ptValues">Point values.</param>
+		/// <param name="nbCells">Nb cells. 0 reorders only the points.</param>
+		/// <param name="cellValues">Cell values (their NbValues bounds the cells).</param>
+		/// <param name="pointOrder">Filled with the index, before reordering, of each point (nbPoints values).</param>
+		/// <param name="cellOrder">Filled with the index, before reordering, of each cell (nbCells values).</param>
+        public unsafe bool ComputeUnstructuredGridMortonOrder(VTKValue ptValues, UInt32 nbCells, VTKValue cellValues, UInt32[] pointOrder, UInt32[] cellOrder)
+        {
+            fixed(UInt32* p = pointOrder)
+            fixed(UInt32* c = cellOrder)
+            {
+                return VTKInterop.VTKParser_computeUnstructuredGridMortonOrder(m_parser, ptValues.Value, nbCells, cellValues == null ? null : (Int32*)cellValues.Value, (UIntPtr)(cellValues == null ? 0 : cellValues.NbValues), p, c) != 0;
+            }
+        }
+
+		/// <summary>
+		/// Reorders an array of tuples (points, cell types, field values) : dest[i] = src[order[i]].
+		/// </summary>
+		/// <returns>true on success, false on failure (order out of range).</returns>
+		/// <param name="src">The tuples to reorder.</param>
+		/// <param name="nbTuples">Nb tuples.</param>
+		/// <param name="tupleSize">The size (in bytes) of a tuple.</param>
+		/// <param name="order">The order (see ComputeUnstructuredGridMortonOrder).</param>
+		/// <param name="dest">The buffer to fill (nbTuples*tupleSize bytes).</param>
+        public unsafe bool PermuteTuples(VTKValue src, UInt32 nbTuples, UInt64 tupleSize, UInt32[] order, IntPtr dest)
+        {
+            fixed(UInt32* o = order)
+            {
+                return VTKInterop.VTKParser_permuteTuples(m_parser, src.Value, nbTuples, (UIntPtr)tupleSize, o, dest) != 0;
+            }
+        }
+
+		/// <summary>
+		/// Reorders the cell values and remaps their point indices after a reordering of the points.
+		/// </summary>
+		/// <returns>true on success, false on failure (corrupted cells, point index out of range, pointOrder not a permutation).</returns>
+		/// <param name="nbCells">Nb cells.</param>
+		/// <param name="cellValues">Cell values (their NbValues bounds the cells).</param>
+		/// <param name="nbPoints">Nb points.</param>
+		/// <param name="pointOrder">The order of the points.</param>
+		/// <param name="cellOrder">The order of the cells. null keeps the cells order.</param>
+		/// <param name="dest">The buffer to fill, as large as cellValues.</param>
+        public unsafe bool RemapUnstructuredGridCells(UInt32 nbCells, VTKValue cellValues, UInt32 nbPoints, UInt32[] pointOrder, UInt32[] cellOrder, IntPtr dest)
+        {
+            fixed(UInt32* p = pointOrder)
+            fixed(UInt32* c = cellOrder)
+            {
+                return VTKInterop.VTKParser_remapUnstructuredGridCells(m_parser, nbCells, (Int32*)cellValues.Value, (UIntPtr)cellValues.NbValues, nbPoints, p, c, (Int32*)dest) != 0;
+            }
+        }
+
 		/// <summary>
 		/// Gets the size of the format.
 		/// </summary>
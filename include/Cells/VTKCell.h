@@ -46,6 +46,21 @@ extern "C"{
          */
         typedef int32_t  (*VTKCELL_NBPOINTS)();
 
+        /**
+         * \brief  Fill the vertex buffer "buffer" with consecutive cells of the same type.
+         * The points format and the destination format are fixed by the function (see VTKCellVT::fillBuffers), so no format is tested per vertex
+         *
+         * \param pts the points data
+         * \param cellValues[in, out] the data of the first cell (numberOfPoints, indiceOfPoints1, etc.). Points afterward to the cell following the last one filled
+         * \param nbCells the number of cells to fill
+         * \param buffer the buffer to write
+         * \return the number of vertices written
+         */
+        typedef size_t   (*VTKCELL_FILLBUFFERS)(const void* pts, int32_t** cellValues, uint32_t nbCells, void* buffer);
+
+/** \brief  The number of points formats having a specialized fill function : VTK_INT, VTK_DOUBLE and VTK_FLOAT (the first VTKValueFormat values)*/
+#define VTK_CELL_NB_PTS_FORMATS 3
+
         /** \brief  VTK Cell virtual table. Each parameter is a function pointer to a service on the cell*/
         typedef struct VTKCellVT_
         {
@@ -54,43 +69,29 @@ extern "C"{
             VTKCELL_SIZEBUFFER        sizeBuffer;        /*!< Get the size of the buffer */
             VTKCELL_GETMODE           getMode;           /*!< Get the rendering mode of this cell*/
             VTKCELL_NBPOINTS          nbPoints;          /*!< Get the number of points per cell. -1 if no limits*/
+            VTKCELL_FILLBUFFERS       fillBuffers[VTK_CELL_NB_PTS_FORMATS][VTK_CELL_NB_PTS_FORMATS]; /*!< Fill the vertex buffer of consecutive cells, indexed by [ptsFormat][destFormat]*/
         }VTKCellVT;
 
-#define VTK_CELL_FILL_PTS_BUFFER(t1)                                        \
-    for(uint32_t i = 0; i < 3; i++)                                         \
-        switch(destFormat)                                                  \
-        {                                                                   \
-            case VTK_INT:                                                   \
-                ((int*)buffer)[i+bufferOffset] = ((t1*)pts)[i+ptsOffset];   \
-                break;                                                      \
-            case VTK_FLOAT:                                                 \
-                ((float*)buffer)[i+bufferOffset] = ((t1*)pts)[i+ptsOffset]; \
-                break;                                                      \
-            case VTK_DOUBLE:                                                \
-                ((double*)buffer)[i+bufferOffset] = ((t1*)pts)[i+ptsOffset];\
-                break;                                                      \
-            default:                                                        \
-                break;                                                      \
-        }                                                                   \
-
-        inline void VTKCell_fillPtsBuffer(void* pts, VTKValueFormat ptsFormat, void* buffer, int32_t ptsOffset, int32_t bufferOffset, VTKValueFormat destFormat)
+        /**
+         * \brief  Get the function filling the vertex buffer of consecutive cells for a given points format and destination format
+         * \param cell the cell virtual table
+         * \param ptsFormat the format of the points data
+         * \param destFormat the format of the destination buffer
+         * \return the fill function, NULL if one of the formats is not supported (only VTK_INT, VTK_DOUBLE and VTK_FLOAT are)
+         */
+        inline VTKCELL_FILLBUFFERS VTKCell_getFillBuffers(const VTKCellVT* cell, VTKValueFormat ptsFormat, VTKValueFormat destFormat)
         {
-            switch(ptsFormat)
-            {
-                case VTK_INT:
-                    VTK_CELL_FILL_PTS_BUFFER(int)
-                    break;
-                case VTK_FLOAT:
-                    VTK_CELL_FILL_PTS_BUFFER(float)
-                    break;
-                case VTK_DOUBLE:
-                    VTK_CELL_FILL_PTS_BUFFER(double)
-                    break;
-                default:
-                    break;
-            }
+            if((uint32_t)ptsFormat >= VTK_CELL_NB_PTS_FORMATS || (uint32_t)destFormat >= VTK_CELL_NB_PTS_FORMATS)
+                return NULL;
+            return cell->fillBuffers[ptsFormat][destFormat];
         }
-#undef VTK_CELL_FILL_PTS_BUFFER
+
+        /**
+         * \brief  Get the virtual table of a cell type
+         * \param type the VTKCellType
+         * \return the VTKCellVT handling this cell type, NULL if this cell type is not supported
+         */
+        DllExport const VTKCellVT* VTKCell_getVT(int32_t type);
 #ifdef __cplusplus
     }
 }
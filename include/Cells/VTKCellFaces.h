@@ -0,0 +1,33 @@
+#ifndef  VTKCELLFACES_INC
+#define  VTKCELLFACES_INC
+
+#include "VTKParser_C_type.h"
+
+#ifdef __cplusplus
+extern "C"{
+    namespace sereno
+    {
+#endif
+        /** \brief  The maximum number of faces of a linear 3D cell*/
+#define VTK_CELL_MAX_FACES 6
+
+        /** \brief  The faces of a 3D cell. Faces are triangles or quads, oriented outward, and given with point indices relative to the cell*/
+        typedef struct VTKCellFaces_
+        {
+            uint8_t nbFaces;                        /*!< The number of faces*/
+            uint8_t faceSizes[VTK_CELL_MAX_FACES];  /*!< The number of points per face (3 or 4)*/
+            uint8_t faces[VTK_CELL_MAX_FACES][4];   /*!< The point indices of each face*/
+        }VTKCellFaces;
+
+        /**
+         * \brief  Get the faces of a 3D cell type
+         * \param type the VTKCellType
+         * \return the faces of this cell type, NULL if this is not a supported 3D cell type
+         */
+        DllExport const VTKCellFaces* VTKCell_getFaces(int32_t type);
+#ifdef __cplusplus
+    }
+}
+#endif
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef  VTKLINEARCELLS_INC
+#define  VTKLINEARCELLS_INC
+
+#include "Cells/VTKCell.h"
+
+#ifdef __cplusplus
+extern "C"{
+    namespace sereno
+    {
+#endif
+        /* Linear cells. Surfaces and volumes are rendered as triangles (volumes by their faces), lines as lines and vertices as points.
+         * Triangle strips and polygons are converted into triangles, so that cells of different types can share the same buffer*/
+
+        extern const VTKCellVT vtkVertex;        /*!< VTK_CELL_VERTEX*/
+        extern const VTKCellVT vtkPolyVertex;    /*!< VTK_CELL_POLYVERTEX*/
+        extern const VTKCellVT vtkLine;          /*!< VTK_CELL_LINE*/
+        extern const VTKCellVT vtkPolyLine;      /*!< VTK_CELL_POLYLINE*/
+        extern const VTKCellVT vtkTriangle;      /*!< VTK_CELL_TRIANGLE*/
+        extern const VTKCellVT vtkTriangleStrip; /*!< VTK_CELL_TRIANGLE_STRIP*/
+        extern const VTKCellVT vtkPolygon;       /*!< VTK_CELL_POLYGON*/
+        extern const VTKCellVT vtkPixel;         /*!< VTK_CELL_PIXEL*/
+        extern const VTKCellVT vtkQuad;          /*!< VTK_CELL_QUAD*/
+        extern const VTKCellVT vtkTetra;         /*!< VTK_CELL_TETRA*/
+        extern const VTKCellVT vtkVoxel;         /*!< VTK_CELL_VOXEL*/
+        extern const VTKCellVT vtkHexahedron;    /*!< VTK_CELL_HEXAHEDRON*/
+        extern const VTKCellVT vtkPyramid;       /*!< VTK_CELL_PYRAMID*/
+#ifdef __cplusplus
+    }
+}
+#endif
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef  VTKTABLECELL_INC
+#define  VTKTABLECELL_INC
+
+#include "Cells/VTKCell.h"
+
+namespace sereno
+{
+    /* Generic implementation of the cells having a fixed number of points.
+     * Each cell is described by a compile-time table of point indices (relative to the cell) : one entry per vertex written.
+     * e.g., a quad rendered as triangles is {0, 1, 2, 0, 2, 3}*/
+
+    /** \brief  Tessellation of a cell described by a table, used by the fill kernels
+     * \tparam table the point indices written
+     * \tparam size the number of entries of table */
+    template <const uint8_t* table, uint32_t size>
+    struct VTKTableCellLayout
+    {
+        static uint32_t nbVertices(int32_t nbPoints) {return size;}
+        static uint32_t index(uint32_t j) {return table[j];}
+    };
+
+    /**
+     * \brief  Fill kernel of consecutive cells of one type, specialized per (points format, destination format, cell layout). See VTKCELL_FILLBUFFERS
+     * \tparam Layout the cell tessellation : static nbVertices(nbPoints) and index(vertex) functions
+     * \tparam TSrc the points values type
+     * \tparam TDst the buffer values type
+     */
+    template <typename Layout, typename TSrc, typename TDst>
+    size_t VTKCell_fillBuffers(const void* pts, int32_t** cellValues, uint32_t nbCells, void* buffer)
+    {
+        const TSrc* src        = (const TSrc*)pts;
+        TDst*       dest       = (TDst*)buffer;
+        int32_t*    values     = *cellValues;
+        size_t      nbVertices = 0;
+
+        for(uint32_t i = 0; i < nbCells; i++, values += values[0] + 1)
+        {
+            uint32_t n = Layout::nbVertices(values[0]);
+            for(uint32_t j = 0; j < n; j++, dest += 3)
+            {
+                const TSrc* pt = src + 3*(size_t)values[1+Layout::index(j)];
+                dest[0] = (TDst)pt[0];
+                dest[1] = (TDst)pt[1];
+                dest[2] = (TDst)pt[2];
+            }
+            nbVertices += n;
+        }
+
+        *cellValues = values;
+        return nbVertices;
+    }
+
+/**
+ * \brief  Define the VTKCellVT::fillBuffers table of a cell layout, indexed by [ptsFormat][destFormat]
+ * \param ... the cell layout type (see VTKCell_fillBuffers)
+ */
+#define VTK_CELL_FILLBUFFERS(...)                                                                                                           \
+    {{VTKCell_fillBuffers<__VA_ARGS__, int32_t, int32_t>, VTKCell_fillBuffers<__VA_ARGS__, int32_t, double>, VTKCell_fillBuffers<__VA_ARGS__, int32_t, float>}, \
+     {VTKCell_fillBuffers<__VA_ARGS__, double,  int32_t>, VTKCell_fillBuffers<__VA_ARGS__, double,  double>, VTKCell_fillBuffers<__VA_ARGS__, double,  float>}, \
+     {VTKCell_fillBuffers<__VA_ARGS__, float,   int32_t>, VTKCell_fillBuffers<__VA_ARGS__, float,   double>, VTKCell_fillBuffers<__VA_ARGS__, float,   float>}}
+
+    /**
+     * \brief  Fill the vertex buffer of one cell. The kernel is selected once for the cell instead of once per vertex component
+     * \tparam Layout the cell tessellation (see VTKCell_fillBuffers)
+     */
+    template <typename Layout>
+    void VTKCell_fillBuffer(void* pts, VTKValueFormat ptsFormat, int32_t* cellPts, void* buffer, VTKValueFormat destFormat)
+    {
+        static const VTKCELL_FILLBUFFERS kernels[VTK_CELL_NB_PTS_FORMATS][VTK_CELL_NB_PTS_FORMATS] = VTK_CELL_FILLBUFFERS(Layout);
+        if((uint32_t)ptsFormat >= VTK_CELL_NB_PTS_FORMATS || (uint32_t)destFormat >= VTK_CELL_NB_PTS_FORMATS)
+            return;
+        kernels[ptsFormat][destFormat](pts, &cellPts, 1, buffer);
+    }
+
+    /**
+     * \brief  Fill the vertex buffer of a cell described by a table
+     * \tparam table the point indices written
+     * \tparam size the number of entries of table
+     */
+    template <const uint8_t* table, uint32_t size>
+    void VTKTableCell_fillBuffer(void* pts, VTKValueFormat ptsFormat, int32_t* cellPts, void* buffer, VTKValueFormat destFormat)
+    {
+        VTKCell_fillBuffer<VTKTableCellLayout<table, size>>(pts, ptsFormat, cellPts, buffer, destFormat);
+    }
+
+    /**
+     * \brief  Fill the element buffer of a cell described by a table
+     * \tparam table the point indices written
+     * \tparam size the number of entries of table
+     */
+    template <const uint8_t* table, uint32_t size>
+    void VTKTableCell_fillElementBuffer(int32_t* cellPts, int32_t* buffer)
+    {
+        for(uint32_t i = 0; i < size; i++)
+            buffer[i] = cellPts[1+table[i]];
+    }
+
+    /** \brief  Get the size of the buffer of a cell described by a table */
+    template <uint32_t size>
+    uint32_t VTKTableCell_sizeBuffer(int32_t* cellPts)
+    {
+        return size;
+    }
+
+    /** \brief  Get the rendering mode of a cell described by a table */
+    template <VTKGLMode mode>
+    VTKGLMode VTKTableCell_getMode()
+    {
+        return mode;
+    }
+
+    /** \brief  Get the number of points of a cell described by a table */
+    template <int32_t nbPoints>
+    int32_t VTKTableCell_nbPoints()
+    {
+        return nbPoints;
+    }
+}
+
+/**
+ * \brief  Define the VTKCellVT of a cell described by a table
+ * \param table the constexpr uint8_t array of point indices
+ * \param mode the VTKGLMode of the cell
+ * \param nbPoints the number of points of the cell
+ */
+#define VTK_TABLE_CELL_VT(table, mode, nbPoints)                                   \
+    {VTKTableCell_fillBuffer<table, sizeof(table)>,                                \
+     VTKTableCell_fillElementBuffer<table, sizeof(table)>,                         \
+     VTKTableCell_sizeBuffer<sizeof(table)>,                                       \
+     VTKTableCell_getMode<mode>,                                                   \
+     VTKTableCell_nbPoints<nbPoints>,                                              \
+     VTK_CELL_FILLBUFFERS(VTKTableCellLayout<table, sizeof(table)>)}
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef  VTKASYNCLOADER_INC
+#define  VTKASYNCLOADER_INC
+
+#include <cstdint>
+#include <cstdlib>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "VTKParser_C_type.h"
+
+namespace sereno
+{
+    struct VTKParser;
+    struct VTKFieldValue;
+
+    /** \brief  Asynchronous loader of the arrays of a parsed VTK file.
+     * Instead of reading the arrays through the memory mapping (page faults serialized with the decoding), a reader thread issues large aligned reads
+     * (pread, or batched io_uring requests when built with liburing) of the next blocks while a decoder thread converts the previous ones
+     * into the caller buffers (double-buffered pipeline). Requests are served in their submission order.
+     * Arrays already in memory (ASCII files, cache files) are decoded directly by the decoder thread.
+     * The parser and the destination buffers have to stay valid until the corresponding requests are completed */
+    struct DllExport VTKAsyncLoader
+    {
+        public:
+            /** \brief  Function called by the decoder thread once a request is completed
+             * \param success true if the whole array has been written in the destination buffer, false otherwise */
+            typedef std::function<void(bool success)> CompletionFunction;
+
+            /**
+             * \brief  Constructor. Open the VTK file and start the reader and decoder threads
+             * \param parser the parser (already parsed) whose arrays are loaded
+             * \param blockSize the size (in bytes) of each read. Rounded up to a multiple of 4096 bytes, at least 64 KiB
+             */
+            VTKAsyncLoader(const VTKParser& parser, size_t blockSize = 4*1024*1024);
+
+            /* \brief Destructor. Wait for the pending requests, then stop the threads and close the file */
+            ~VTKAsyncLoader();
+
+            /* \brief Is the VTK file opened ? If not (e.g., ASCII file), the arrays are decoded from the parser memory
+             * \return true if the file has been opened, false otherwise */
+            bool isOpen() const;
+
+            /* \brief Are the reads issued through io_uring ?
+             * \return true if io_uring is used, false if pread (or ReadFile) is used */
+            bool isUsingIOUring() const {return m_ring != NULL;}
+
+            /**
+             * \brief  Load an array of the VTK file into a caller-provided buffer, in the host endianness
+             * \param offset the offset (in bytes) of the array in the VTK file
+             * \param nbValues the number of values to load
+             * \param format the values format
+             * \param dest the buffer to fill
+             * \param capacity the size (in bytes) of dest. Needs at least nbValues*VTKValueFormatInt(format) bytes
+             * \param onCompletion function called once the request is completed (can be empty)
+             * \return a future set to true on success, false on failure (buffer too small, out of file, read error)
+             */
+            std::future<bool> load(size_t offset, size_t nbValues, VTKValueFormat format, void* dest, size_t capacity,
+                                   const CompletionFunction& onCompletion = CompletionFunction());
+
+            /* \brief Load all the unstructured grid points. See load()
+             * \param dest the buffer to fill. Verify the point type before casting !
+             * \param capacity the size (in bytes) of dest. Needs at least nbPoints*3*VTKValueFormatInt(format) bytes
+             * \param onCompletion function called once the request is completed (can be empty)
+             * \return a future set to true on success, false on failure */
+            std::future<bool> loadUnstructuredGridPoints(void* dest, size_t capacity, const CompletionFunction& onCompletion = CompletionFunction());
+
+            /* \brief Load the unstructured grid cells values (see VTKParser::parseAllUnstructuredGridCellsComposition). See load()
+             * \param dest the buffer to fill
+             * \param capacity the number of values dest can contain. Needs at least wholeSize values
+             * \param onCompletion function called once the request is completed (can be empty)
+             * \return a future set to true on success, false on failure */
+            std::future<bool> loadUnstructuredGridCells(int32_t* dest, size_t capacity, const CompletionFunction& onCompletion = CompletionFunction());
+
+            /* \brief Load the unstructured grid cells types (see VTKParser::parseAllUnstructuredGridCellTypes). See load()
+             * \param dest the buffer to fill
+             * \param capacity the number of values dest can contain. Needs at least nbCells values
+             * \param onCompletion function called once the request is completed (can be empty)
+             * \return a future set to true on success, false on failure */
+            std::future<bool> loadUnstructuredGridCellTypes(int32_t* dest, size_t capacity, const CompletionFunction& onCompletion = CompletionFunction());
+
+            /* \brief Load all the structured grid points. See load()
+             * \param dest the buffer to fill. Verify the point type before casting !
+             * \param capacity the size (in bytes) of dest. Needs at least nbPoints*3*VTKValueFormatInt(format) bytes
+             * \param onCompletion function called once the request is completed (can be empty)
+             * \return a future set to true on success, false on failure */
+            std::future<bool> loadStructuredGridPoints(void* dest, size_t capacity, const CompletionFunction& onCompletion = CompletionFunction());
+
+            /* \brief Load all the values of a field value (see VTKParser::parseAllFieldValues). See load()
+             * \param fieldData the field value to load
+             * \param dest the buffer to fill
+             * \param capacity the size (in bytes) of dest. Needs at least nbTuples*nbValuePerTuple*VTKValueFormatInt(format) bytes
+             * \param onCompletion function called once the request is completed (can be empty)
+             * \return a future set to true on success, false on failure */
+            std::future<bool> loadFieldValues(const VTKFieldValue* fieldData, void* dest, size_t capacity, const CompletionFunction& onCompletion = CompletionFunction());
+
+            /* \brief Wait for every request submitted so far to be completed */
+            void wait();
+        private:
+            /** \brief  A submitted array */
+            struct Request
+            {
+                size_t             offset;       /*!< The offset of the array in the VTK file*/
+                size_t             nbValues;     /*!< The number of values*/
+                VTKValueFormat     format;       /*!< The values format*/
+                uint8_t*           dest;         /*!< The destination buffer*/
+                CompletionFunction onCompletion; /*!< The completion function*/
+                std::promise<bool> promise;      /*!< The promise of the future returned*/
+                bool               inMemory;     /*!< Is the array decoded from the parser memory (ASCII file, cache file), or not decoded at all (invalid, empty) ?*/
+                bool               success;      /*!< Has every block been decoded until now ?*/
+            };
+
+            /** \brief  A block of an array read in a buffer */
+            struct Block
+            {
+                std::shared_ptr<Request> request;    /*!< The array*/
+                size_t                   firstValue; /*!< The first value of the block in the array*/
+                size_t                   nbValues;   /*!< The number of values of the block*/
+                uint64_t                 fileOffset; /*!< The (aligned) offset read*/
+                size_t                   readSize;   /*!< The size (in bytes) read*/
+                size_t                   head;       /*!< The bytes read before the first value (alignment)*/
+                uint32_t                 buffer;     /*!< The buffer containing the block*/
+                bool                     valid;      /*!< Has the read succeeded ?*/
+                bool                     last;       /*!< Is it the last block of the array ?*/
+            };
+
+            VTKAsyncLoader(const VTKAsyncLoader& copy);
+            VTKAsyncLoader& operator=(const VTKAsyncLoader& copy);
+
+            /* \brief Complete a request */
+            static void complete(Request& request);
+
+            /* \brief The reader thread : split the requests in blocks and read them */
+            void readLoop();
+
+            /* \brief The decoder thread : decode the blocks read */
+            void decodeLoop();
+
+            /* \brief Read blocks in their buffers, setting their valid flag
+             * \param blocks the blocks to read */
+            void readBlocks(std::vector<Block>& blocks);
+
+            const VTKParser&                       m_parser;              /*!< The parser*/
+            size_t                                 m_blockSize;           /*!< The size of the reads*/
+#ifdef WIN32
+            void*                                  m_file     = NULL;     /*!< The VTK file handle*/
+#else
+            int                                    m_file     = -1;       /*!< The VTK file descriptor*/
+#endif
+            void*                                  m_ring     = NULL;     /*!< The io_uring instance. NULL if pread is used*/
+            std::vector<uint8_t*>                  m_buffers;             /*!< The read buffers (aligned)*/
+            std::vector<uint32_t>                  m_freeBuffers;         /*!< The buffers not used*/
+            std::deque<std::shared_ptr<Request>>   m_requests;            /*!< The requests not entirely read*/
+            size_t                                 m_nextValue = 0;       /*!< The first value not read of the first request*/
+            std::deque<Block>                      m_blocks;              /*!< The blocks read, not decoded*/
+            uint64_t                               m_nbPending = 0;       /*!< The number of requests not completed*/
+            bool                                   m_stop      = false;   /*!< Should the threads stop ?*/
+            std::mutex                             m_mutex;               /*!< Protect the queues*/
+            std::condition_variable                m_readCond;            /*!< Signaled when the reader thread can read*/
+            std::condition_variable                m_decodeCond;          /*!< Signaled when the decoder thread can decode*/
+            std::condition_variable                m_doneCond;            /*!< Signaled when a request is completed*/
+            std::thread                            m_reader;              /*!< The reader thread*/
+            std::thread                            m_decoder;             /*!< The decoder thread*/
+    };
+}
+
+#endif
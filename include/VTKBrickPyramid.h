@@ -0,0 +1,127 @@
+#ifndef  VTKBRICKPYRAMID_INC
+#define  VTKBRICKPYRAMID_INC
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "VTKParser_C_type.h"
+
+namespace sereno
+{
+    struct VTKParser;
+    struct VTKFieldValue;
+
+    /** \brief  Multi-resolution bricked layout of a point field value of a structured points dataset, stored in a local file for out-of-core streaming.
+     * Level 0 is the field itself, level l+1 is level l filtered (weights 1/4, 1/2, 1/4 along each axis) and taken every 2 points,
+     * up to the first level fitting in a single brick.
+     * Every level is split in bricks of brickSize^3 tuples (x varying fastest) stored contiguously, bricks being ordered x, then y, then z.
+     * Bricks on the border of a level are padded by repeating the last points, so every brick has the same size.
+     * Values are stored in the host endianness : pyramid files are only valid for the machine (endianness, ABI) having written them */
+    struct DllExport VTKBrickPyramid
+    {
+        public:
+            /* \brief Constructor. No pyramid file opened */
+            VTKBrickPyramid() {}
+
+            /* \brief Destructor. Unmap the pyramid file */
+            ~VTKBrickPyramid();
+
+            /**
+             * \brief  Build the pyramid file of a point field value. The volume is streamed slice per slice, so the memory used
+             * stays bounded by a few slices of each level. The file is written aside, then renamed, so concurrent readers never see a partial pyramid
+             * \param parser the parser (already parsed) containing a structured points dataset
+             * \param fieldData the point field value to convert
+             * \param path the pyramid file path
+             * \param brickSize the number of points of a brick along each axis
+             * \return true on success, false on failure (not a point field value of a structured points dataset, write error)
+             */
+            static bool build(const VTKParser& parser, const VTKFieldValue* fieldData, const std::string& path, uint32_t brickSize = 64);
+
+            /**
+             * \brief  Open and map a pyramid file
+             * \param path the pyramid file path
+             * \return true on success, false otherwise (missing, corrupted, written by another kind of machine)
+             */
+            bool open(const std::string& path);
+
+            /* \brief Is a pyramid file opened ?
+             * \return true if a pyramid file is opened, false otherwise */
+            bool isOpen() const {return m_data != NULL;}
+
+            /* \brief Get the number of levels
+             * \return the number of levels, 0 if no pyramid is opened */
+            uint32_t getNbLevels() const {return m_levels.size();}
+
+            /* \brief Get a level descriptor
+             * \param level the level (0 == full resolution)
+             * \return the level descriptor, NULL if level is out of range */
+            const VTKBrickLevel* getLevel(uint32_t level) const {return (level < m_levels.size() ? &m_levels[level] : NULL);}
+
+            /* \brief Get the number of points of a brick along each axis
+             * \return the brick size */
+            uint32_t getBrickSize() const {return m_brickSize;}
+
+            /* \brief Get the values format
+             * \return the format of the values */
+            VTKValueFormat getFormat() const {return m_format;}
+
+            /* \brief Get the number of values per tuple
+             * \return the number of values per tuple */
+            uint32_t getNbValuePerTuple() const {return m_nbValuePerTuple;}
+
+            /* \brief Get the size of a brick
+             * \return the size (in bytes) of a brick : brickSize^3*nbValuePerTuple*VTKValueFormatInt(format) */
+            size_t getBrickDataSize() const {return m_brickDataSize;}
+
+            /**
+             * \brief  Get the structured points descriptor of the points of a brick (padding excluded)
+             * \param level the level of the brick
+             * \param x the brick position along the x axis
+             * \param y the brick position along the y axis
+             * \param z the brick position along the z axis
+             * \param descriptor[out] the descriptor of the brick. Its size is smaller than brickSize on the border of the level
+             * \return true on success, false if the brick is out of range
+             */
+            bool getBrickDescriptor(uint32_t level, uint32_t x, uint32_t y, uint32_t z, VTKStructuredPoints* descriptor) const;
+
+            /**
+             * \brief  Get a brick, without any copy
+             * \param level the level of the brick
+             * \param x the brick position along the x axis
+             * \param y the brick position along the y axis
+             * \param z the brick position along the z axis
+             * \return the getBrickDataSize() bytes of the brick in the mapped file (valid until the pyramid is closed), NULL if the brick is out of range
+             */
+            const void* getBrick(uint32_t level, uint32_t x, uint32_t y, uint32_t z) const;
+
+            /**
+             * \brief  Copy a brick into a caller-provided buffer
+             * \param level the level of the brick
+             * \param x the brick position along the x axis
+             * \param y the brick position along the y axis
+             * \param z the brick position along the z axis
+             * \param dest the buffer to fill
+             * \param capacity the size (in bytes) of dest. Needs at least getBrickDataSize() bytes
+             * \return true on success, false on failure (out of range, buffer too small)
+             */
+            bool readBrick(uint32_t level, uint32_t x, uint32_t y, uint32_t z, void* dest, size_t capacity) const;
+
+            /* \brief Unmap the pyramid file */
+            void close();
+        private:
+            VTKBrickPyramid(const VTKBrickPyramid& copy);
+            VTKBrickPyramid& operator=(const VTKBrickPyramid& copy);
+
+            uint8_t*                   m_data            = NULL;                   /*!< The mapped pyramid file*/
+            size_t                     m_dataSize        = 0;                      /*!< The pyramid file size*/
+            VTKValueFormat             m_format          = VTK_NO_VALUE_FORMAT;    /*!< The values format*/
+            uint32_t                   m_nbValuePerTuple = 0;                      /*!< The number of values per tuple*/
+            uint32_t                   m_brickSize       = 0;                      /*!< The number of points of a brick along each axis*/
+            size_t                     m_brickDataSize   = 0;                      /*!< The size (in bytes) of a brick*/
+            std::vector<VTKBrickLevel> m_levels;                                   /*!< The levels*/
+    };
+}
+
+#endif
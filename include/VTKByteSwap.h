@@ -0,0 +1,47 @@
+#ifndef  VTKBYTESWAP_INC
+#define  VTKBYTESWAP_INC
+
+#include "VTKParser_C_type.h"
+
+#ifdef __cplusplus
+extern "C"{
+    namespace sereno
+    {
+#endif
+        /**
+         * \brief  Convert a contiguous span of big-endian 32 bits values (int, float) to the host endianness.
+         * The conversion uses the widest SIMD instruction set available on the running CPU (AVX-512, AVX2, SSE2 or NEON) and falls back to a scalar loop otherwise.
+         *
+         * \param src the big-endian values to convert. Does not need to be aligned
+         * \param dest the destination buffer (nbValues*4 bytes). Can be equal to src (in-place conversion) but must not partially overlap it
+         * \param nbValues the number of values to convert
+         */
+        DllExport void VTKByteSwap_bigEndianToHost32(const void* src, void* dest, size_t nbValues);
+
+        /**
+         * \brief  Convert a contiguous span of big-endian 64 bits values (double) to the host endianness.
+         * See VTKByteSwap_bigEndianToHost32 for the instruction set used.
+         *
+         * \param src the big-endian values to convert. Does not need to be aligned
+         * \param dest the destination buffer (nbValues*8 bytes). Can be equal to src (in-place conversion) but must not partially overlap it
+         * \param nbValues the number of values to convert
+         */
+        DllExport void VTKByteSwap_bigEndianToHost64(const void* src, void* dest, size_t nbValues);
+
+        /**
+         * \brief  Convert a contiguous span of big-endian values to the host endianness, whatever their format is
+         *
+         * \param src the big-endian values to convert
+         * \param dest the destination buffer (nbValues*VTKValueFormatInt(format) bytes)
+         * \param nbValues the number of values to convert
+         * \param format the values format
+         *
+         * \return 1 on success, 0 if the format is not handled
+         */
+        DllExport char VTKByteSwap_bigEndianToHost(const void* src, void* dest, size_t nbValues, VTKValueFormat format);
+#ifdef __cplusplus
+    }
+}
+#endif
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef  VTKCACHE_INC
+#define  VTKCACHE_INC
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "VTKParser_C_type.h"
+
+namespace sereno
+{
+    /**
+     * \brief  Map a whole file in memory (read only)
+     * \param path the file path to map
+     * \param data[out] the mapped file
+     * \param size[out] the file size
+     * \return false on error (or empty file), true on success
+     */
+    DllExport bool VTKMapFile(const std::string& path, uint8_t** data, size_t* size);
+
+    /**
+     * \brief  Unmap a file mapped with VTKMapFile
+     * \param data the mapped file
+     * \param size the file size
+     */
+    DllExport void VTKUnmapFile(uint8_t* data, size_t size);
+
+    /** \brief  An array stored in a cache file */
+    struct VTKCacheArray
+    {
+        uint64_t       fileOffset;  /*!< The offset of the array in the VTK file*/
+        uint64_t       nbValues;    /*!< The number of values*/
+        VTKValueFormat format;      /*!< The values format*/
+        uint64_t       cacheOffset; /*!< The offset of the host-endian values in the cache file (64 bytes aligned)*/
+    };
+
+    /** \brief  Sidecar file caching a parsed VTK file : its metadata (the parser structures) and its arrays already converted to the host endianness.
+     * The cache is keyed by the VTK file path, size and modification time, and is mapped back in memory when opened : reading a cached array is a copy.
+     * Cache files are only valid for the machine (endianness, ABI) having written them */
+    struct DllExport VTKCache
+    {
+        public:
+            /** \brief  Function writing the host-endian values [firstValue, firstValue+nbValues) of an array into dest
+             * \return false on error, true on success */
+            typedef std::function<bool(const VTKCacheArray& array, size_t firstValue, size_t nbValues, void* dest)> DecodeFunction;
+
+            /* \brief Constructor. No cache file opened */
+            VTKCache() {}
+
+            /* \brief Destructor. Unmap the cache file */
+            ~VTKCache();
+
+            /**
+             * \brief  Get the cache file path of a VTK file
+             * \param path the VTK file path
+             * \param directory the directory containing the cache files. Empty == next to the VTK file (path + ".vtkcache")
+             * \return the cache file path
+             */
+            static std::string getCachePath(const std::string& path, const std::string& directory);
+
+            /**
+             * \brief  Open and map a cache file, if it is up to date with the VTK file
+             * \param cachePath the cache file path
+             * \param path the VTK file path the cache must correspond to
+             * \return true if the cache is valid, false otherwise (missing, out of date, corrupted)
+             */
+            bool open(const std::string& cachePath, const std::string& path);
+
+            /**
+             * \brief  Write a cache file. The file is written aside, then renamed, so concurrent readers never see a partial cache
+             * \param cachePath the cache file path
+             * \param path the VTK file path
+             * \param metadata the serialized parser metadata
+             * \param arrays the arrays to store (their cacheOffset is not used)
+             * \param decode the function decoding the arrays
+             * \return true on success, false on failure
+             */
+            static bool write(const std::string& cachePath, const std::string& path, const std::string& metadata,
+                              const std::vector<VTKCacheArray>& arrays, const DecodeFunction& decode);
+
+            /* \brief Get the serialized parser metadata
+             * \param size[out] the metadata size
+             * \return the metadata, NULL if no cache is opened */
+            const uint8_t* getMetadata(size_t* size) const;
+
+            /**
+             * \brief  Get the host-endian values corresponding to a part of the VTK file
+             * \param fileOffset the offset of the values in the VTK file
+             * \param size the size (in bytes) of the values
+             * \return the values in the mapped cache file, NULL if this part is not cached
+             */
+            const uint8_t* getValues(size_t fileOffset, size_t size) const;
+        private:
+            VTKCache(const VTKCache& copy);
+            VTKCache& operator=(const VTKCache& copy);
+
+            uint8_t*                   m_data         = NULL; /*!< The mapped cache file*/
+            size_t                     m_dataSize     = 0;    /*!< The cache file size*/
+            const uint8_t*             m_metadata     = NULL; /*!< The serialized parser metadata*/
+            size_t                     m_metadataSize = 0;    /*!< The metadata size*/
+            std::vector<VTKCacheArray> m_arrays;              /*!< The cached arrays, sorted by fileOffset*/
+    };
+}
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef  VTKCELLSTREAM_INC
+#define  VTKCELLSTREAM_INC
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "VTKParser_C_type.h"
+
+namespace sereno
+{
+    struct VTKParser;
+
+    /** \brief  A batch of consecutive unstructured grid cells. The arrays use the CELLS / CELL_TYPES layout,
+     * so they can be given as is to VTKParser::getCellConstructionDescriptor and to the VTKParser fill functions */
+    struct VTKCellBatch
+    {
+        uint32_t             firstCell = 0; /*!< The index of the first cell of this batch in the dataset*/
+        uint32_t             nbCells   = 0; /*!< The number of cells in this batch*/
+        std::vector<int32_t> cellValues;    /*!< The cells values (number of points followed by the points indices, per cell)*/
+        std::vector<int32_t> cellTypes;     /*!< The cells types (one per cell)*/
+    };
+
+    /** \brief  Streaming reader of the unstructured grid cells. Reads fixed-size batches of cells straight from the mapped file, so the
+     * memory used stays bounded by the batch size : pages already consumed are released, and the pages of the next batch are prefetched
+     * while the current batch is processed.
+     * The parser has to outlive the stream */
+    struct DllExport VTKCellStream
+    {
+        public:
+            /* \brief Constructor
+             * \param parser the parser (already parsed) containing an unstructured grid
+             * \param batchSize the maximum number of cells per batch
+             * \param firstCell the first cell to read */
+            VTKCellStream(const VTKParser& parser, uint32_t batchSize, uint32_t firstCell = 0);
+
+            /* \brief Read the next batch of cells
+             * \return the batch read (valid until the next call), or NULL if every cell has been read or on error (see hasError) */
+            const VTKCellBatch* next();
+
+            /* \brief Has an error occured (corrupted cell counts, out of file) ?
+             * \return true if an error occured, false otherwise */
+            bool hasError() const {return m_error;}
+
+            /* \brief Get the index of the next cell to read
+             * \return the index of the next cell */
+            uint32_t getPosition() const {return m_nextCell;}
+
+            /* \brief Get the number of cells per batch
+             * \return the maximum number of cells per batch */
+            uint32_t getBatchSize() const {return m_batchSize;}
+        private:
+            /* \brief Get the offset of the end of the batch beginning at m_nextCell/m_nextValue
+             * \param nbCells[out] the number of cells in this batch
+             * \param nbValues[out] the number of CELLS values in this batch
+             * \return false on error (corrupted counts), true otherwise */
+            bool walkBatch(uint32_t& nbCells, uint32_t& nbValues) const;
+
+            const VTKParser& m_parser;        /*!< The parser*/
+            uint32_t         m_batchSize;     /*!< The maximum number of cells per batch*/
+            uint32_t         m_nextCell  = 0; /*!< The next cell to read*/
+            uint32_t         m_nextValue = 0; /*!< The next CELLS value to read*/
+            bool             m_error     = false; /*!< Has an error occured ?*/
+            VTKCellBatch     m_batch;         /*!< The last batch read*/
+    };
+}
+
+#endif
@@ -4,9 +4,11 @@
 #include <iostream>
 #include <cstdlib>
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <utility>
+#include <memory>
 #include <fcntl.h>
 #ifdef WIN32
 #include <io.h>
@@ -16,11 +18,17 @@
 #include <sys/mman.h>
 #endif
 #include <sys/stat.h>
-#include <regex>
 
 #include "VTKParser_C_type.h"
+#include "VTKByteSwap.h"
+#include "VTKThreadPool.h"
+#include "VTKTokenizer.h"
+#include "VTKCellStream.h"
+#include "VTKCache.h"
 #include "Cells/VTKCell.h"
 #include "Cells/VTKWedge.h"
+#include "Cells/VTKLinearCells.h"
+#include "Cells/VTKCellFaces.h"
 
 namespace sereno
 {
@@ -187,7 +195,9 @@ namespace sereno
             {
                 uint32_t t = (v[0] << 24) + (v[1] << 16) + 
                              (v[2] << 8 ) + v[3];
-                return *((float*)(&t));
+                float    f;
+                memcpy(&f, &t, sizeof(f));
+                return f;
             }
             case VTK_UNSIGNED_CHAR:
             case VTK_CHAR:
@@ -225,7 +235,46 @@ namespace sereno
         }
     }
 
-    /* \brief VTKParser class. Only support right now STRUCTURED_GRID and BINARY */
+    /** \brief  Non-owning view over a contiguous array of values (pointer + number of values) */
+    template <typename T>
+    struct VTKArrayView
+    {
+        T*     data = NULL; /*!< The first value. NULL if the view is invalid (e.g., a read error occured)*/
+        size_t size = 0;    /*!< The number of values*/
+
+        VTKArrayView() {}
+        VTKArrayView(T* d, size_t s) : data(d), size(s) {}
+
+        /** \brief  Is this view valid ?
+         * \return true if data != NULL */
+        bool isValid() const {return data != NULL;}
+
+        T*       begin()       {return data;}
+        T*       end()         {return data+size;}
+        const T* begin() const {return data;}
+        const T* end()   const {return data+size;}
+
+        T&       operator[](size_t i)       {return data[i];}
+        const T& operator[](size_t i) const {return data[i];}
+    };
+
+    /** \brief  Get the VTKValueFormat corresponding to a C++ type. VTK_NO_VALUE_FORMAT if none */
+    template <typename T> struct VTKValueFormatOf                {static const VTKValueFormat value = VTK_NO_VALUE_FORMAT;};
+    template <>           struct VTKValueFormatOf<int32_t>       {static const VTKValueFormat value = VTK_INT;};
+    template <>           struct VTKValueFormatOf<uint32_t>      {static const VTKValueFormat value = VTK_INT;};
+    template <>           struct VTKValueFormatOf<float>         {static const VTKValueFormat value = VTK_FLOAT;};
+    template <>           struct VTKValueFormatOf<double>        {static const VTKValueFormat value = VTK_DOUBLE;};
+    template <>           struct VTKValueFormatOf<uint8_t>       {static const VTKValueFormat value = VTK_UNSIGNED_CHAR;};
+    template <>           struct VTKValueFormatOf<uint16_t>      {static const VTKValueFormat value = VTK_UNSIGNED_SHORT;};
+    template <>           struct VTKValueFormatOf<char>          {static const VTKValueFormat value = VTK_CHAR;};
+    template <>           struct VTKValueFormatOf<int8_t>        {static const VTKValueFormat value = VTK_CHAR;};
+
+    /** \brief VTKParser class. Only support right now UNSTRUCTURED_GRID, STRUCTURED_GRID and STRUCTURED_POINTS, in BINARY or ASCII.
+     * Thread safety : once parse() has returned, every const method can be called concurrently from several threads on the same parser
+     * (e.g., one thread per field value). The values are read from the memory mapped file (or from the ASCII values / the cache file) at their offset :
+     * there is no shared read position, and the decoding threads are shared through a thread-safe pool.
+     * The non-const methods (parse, setNbThreads, setParallelThreshold, setCacheEnabled, buildUnstructuredGridCellIndex, closeParser, the move constructor)
+     * must not run while another thread uses the parser */
     struct DllExport VTKParser
     {
         public:
@@ -247,6 +296,39 @@ namespace sereno
             /* \brief Close the VTK Parser */
             void closeParser();
 
+            /* \brief Set the number of threads used to decode large arrays. Do not call it while arrays are being read
+             * \param nbThreads the number of threads (caller included). 0 == the number of hardware threads, 1 == serial decoding */
+            void setNbThreads(uint32_t nbThreads);
+
+            /* \brief Get the number of threads used to decode large arrays
+             * \return the number of threads (caller included) */
+            uint32_t getNbThreads() const {return m_threadPool->getNbThreads();}
+
+            /* \brief Set the size under which arrays are decoded serially (the threads synchronization would cost more than the decoding).
+             * Do not call it while arrays are being read
+             * \param size the size in bytes */
+            void setParallelThreshold(size_t size) {m_parallelThreshold = size;}
+
+            /* \brief Get the size under which arrays are decoded serially
+             * \return the size in bytes */
+            size_t getParallelThreshold() const {return m_parallelThreshold;}
+
+            /* \brief Enable the binary cache sidecar. Must be called before parse().
+             * When enabled, parse() loads the file structures from an up to date cache file (keyed by the path, size and modification time of the VTK file)
+             * instead of parsing the text, and the arrays are then copied from the cache (host endianness) instead of being byte swapped.
+             * If no valid cache exists, parse() parses the VTK file and writes the cache. The cache is only valid on the machine having written it
+             * \param enable true to use the cache, false otherwise
+             * \param directory the directory of the cache files. Empty == next to the VTK file ("<path>.vtkcache") */
+            void setCacheEnabled(bool enable, const std::string& directory = "");
+
+            /* \brief Is the binary cache sidecar enabled ?
+             * \return true if enabled, false otherwise */
+            bool isCacheEnabled() const {return m_cacheEnabled;}
+
+            /* \brief Has the last parse() been served by the cache file ?
+             * \return true if the file structures and the arrays are read from the cache file, false otherwise */
+            bool isLoadedFromCache() const {return m_cache != NULL;}
+
             /* \brief Parse the file. Here, no "real data" is stored : we only get the file structures (fields, etc.)
              * \return true on success, false on faillure */
             bool parse();
@@ -255,6 +337,41 @@ namespace sereno
              * \return a buffer containing the points value. Verify the point type before casting ! Need to be free (using free) */
             void* parseAllUnstructuredGridPoints() const; 
 
+            /* \brief Parse all the unstructured grid point into a caller-provided buffer.
+             * \param dest the buffer to fill. Verify the point type before casting !
+             * \param capacity the size (in bytes) of dest. Needs at least nbPoints*3*VTKValueFormatInt(format) bytes
+             * \return true on success, false on failure (buffer too small, read error) */
+            bool parseAllUnstructuredGridPoints(void* dest, size_t capacity) const;
+
+            /* \brief Parse all the unstructured grid point, converted into another format. Used with the indexed element buffers, the points are sent only once
+             * \param destFormat the format of the returned values
+             * \return a buffer containing the nbPoints*3 values in destFormat. Need to be free (using free). NULL on error */
+            void* parseAllUnstructuredGridPoints(VTKValueFormat destFormat) const;
+
+            /* \brief Parse all the unstructured grid point, converted into another format, into a caller-provided buffer.
+             * \param dest the buffer to fill
+             * \param capacity the size (in bytes) of dest. Needs at least nbPoints*3*VTKValueFormatInt(destFormat) bytes
+             * \param destFormat the format of the values written
+             * \return true on success, false on failure (buffer too small, read error, unknown format) */
+            bool parseAllUnstructuredGridPoints(void* dest, size_t capacity, VTKValueFormat destFormat) const;
+
+            /* \brief Parse all the unstructured grid point, computing their bounding box while decoding them
+             * \param bounds[out] the statistics of the x, y and z components (3 values) : min and max are the bounding box, mean is the centroid
+             * \return a buffer containing the points value. Verify the point type before casting ! Need to be free (using free). NULL on error */
+            void* parseAllUnstructuredGridPoints(VTKComponentStats* bounds) const;
+
+            /* \brief Parse all the unstructured grid point into a caller-provided typed buffer.
+             * \param dest the buffer to fill. T has to correspond to the point format
+             * \param capacity the number of T values dest can contain
+             * \return a view on the nbPoints*3 values written in dest. Invalid view on failure (type mismatch, buffer too small, read error) */
+            template <typename T>
+            VTKArrayView<T> parseAllUnstructuredGridPoints(T* dest, size_t capacity) const
+            {
+                if(VTKValueFormatOf<T>::value != m_unstrGrid.ptsPos.format || !parseAllUnstructuredGridPoints((void*)dest, capacity*sizeof(T)))
+                    return VTKArrayView<T>();
+                return VTKArrayView<T>(dest, 3*(size_t)m_unstrGrid.ptsPos.nbPoints);
+            }
+
             /**
              * \brief Get the cells values
              * \return data of the cell section (CELLS).
@@ -263,12 +380,160 @@ namespace sereno
              */
             int32_t* parseAllUnstructuredGridCellsComposition() const;
 
+            /**
+             * \brief Get the cells values into a caller-provided buffer. See parseAllUnstructuredGridCellsComposition()
+             * \param dest the buffer to fill
+             * \param capacity the number of values dest can contain. Needs at least wholeSize values
+             * \return a view on the values written in dest. Invalid view on failure (buffer too small, read error)
+             */
+            VTKArrayView<int32_t> parseAllUnstructuredGridCellsComposition(int32_t* dest, size_t capacity) const;
+
             /**
              * \brief Get the cells types.
              * \return data of the cell_type section (CELL_TYPES).
              * These information tells you how to combine the points given by parseAllUnstructuredGridCellsComposition function*/
             int32_t* parseAllUnstructuredGridCellTypes() const;
 
+            /**
+             * \brief Get the cells types into a caller-provided buffer. See parseAllUnstructuredGridCellTypes()
+             * \param dest the buffer to fill
+             * \param capacity the number of values dest can contain. Needs at least nbCells values
+             * \return a view on the values written in dest. Invalid view on failure (buffer too small, read error)
+             */
+            VTKArrayView<int32_t> parseAllUnstructuredGridCellTypes(int32_t* dest, size_t capacity) const;
+
+            /* \brief Parse a range of the unstructured grid points.
+             * \param firstPoint the first point to read
+             * \param nbPoints the number of points to read
+             * \return a buffer containing the nbPoints*3 values. Verify the point type before casting ! Need to be free (using free). NULL on error (out of range) */
+            void* parseUnstructuredGridPoints(uint32_t firstPoint, uint32_t nbPoints) const;
+
+            /* \brief Parse a range of the unstructured grid points into a caller-provided buffer.
+             * \param firstPoint the first point to read
+             * \param nbPoints the number of points to read
+             * \param dest the buffer to fill
+             * \param capacity the size (in bytes) of dest. Needs at least nbPoints*3*VTKValueFormatInt(format) bytes
+             * \return true on success, false on failure (out of range, buffer too small) */
+            bool parseUnstructuredGridPoints(uint32_t firstPoint, uint32_t nbPoints, void* dest, size_t capacity) const;
+
+            /* \brief Parse all the structured grid point. The points are ordered with x varying fastest, then y, then z
+             * \return a buffer containing the points value. Verify the point type before casting ! Need to be free (using free) */
+            void* parseAllStructuredGridPoints() const;
+
+            /* \brief Parse all the structured grid point into a caller-provided buffer.
+             * \param dest the buffer to fill. Verify the point type before casting !
+             * \param capacity the size (in bytes) of dest. Needs at least nbPoints*3*VTKValueFormatInt(format) bytes
+             * \return true on success, false on failure (buffer too small, read error) */
+            bool parseAllStructuredGridPoints(void* dest, size_t capacity) const;
+
+            /* \brief Parse all the structured grid point, converted into another format
+             * \param destFormat the format of the returned values
+             * \return a buffer containing the nbPoints*3 values in destFormat. Need to be free (using free). NULL on error */
+            void* parseAllStructuredGridPoints(VTKValueFormat destFormat) const;
+
+            /* \brief Parse all the structured grid point, converted into another format, into a caller-provided buffer.
+             * \param dest the buffer to fill
+             * \param capacity the size (in bytes) of dest. Needs at least nbPoints*3*VTKValueFormatInt(destFormat) bytes
+             * \param destFormat the format of the values written
+             * \return true on success, false on failure (buffer too small, read error, unknown format) */
+            bool parseAllStructuredGridPoints(void* dest, size_t capacity, VTKValueFormat destFormat) const;
+
+            /* \brief Parse all the structured grid point, computing their bounding box while decoding them
+             * \param bounds[out] the statistics of the x, y and z components (3 values) : min and max are the bounding box, mean is the centroid
+             * \return a buffer containing the points value. Verify the point type before casting ! Need to be free (using free). NULL on error */
+            void* parseAllStructuredGridPoints(VTKComponentStats* bounds) const;
+
+            /* \brief Parse all the structured grid point into a caller-provided typed buffer.
+             * \param dest the buffer to fill. T has to correspond to the point format
+             * \param capacity the number of T values dest can contain
+             * \return a view on the nbPoints*3 values written in dest. Invalid view on failure (type mismatch, buffer too small, read error) */
+            template <typename T>
+            VTKArrayView<T> parseAllStructuredGridPoints(T* dest, size_t capacity) const
+            {
+                if(VTKValueFormatOf<T>::value != m_grid.ptsPos.format || !parseAllStructuredGridPoints((void*)dest, capacity*sizeof(T)))
+                    return VTKArrayView<T>();
+                return VTKArrayView<T>(dest, 3*(size_t)m_grid.ptsPos.nbPoints);
+            }
+
+            /* \brief Parse a range of the structured grid points (e.g., some slices of the grid).
+             * \param firstPoint the first point to read
+             * \param nbPoints the number of points to read
+             * \return a buffer containing the nbPoints*3 values. Verify the point type before casting ! Need to be free (using free). NULL on error (out of range) */
+            void* parseStructuredGridPoints(uint32_t firstPoint, uint32_t nbPoints) const;
+
+            /* \brief Parse a range of the structured grid points into a caller-provided buffer.
+             * \param firstPoint the first point to read
+             * \param nbPoints the number of points to read
+             * \param dest the buffer to fill
+             * \param capacity the size (in bytes) of dest. Needs at least nbPoints*3*VTKValueFormatInt(format) bytes
+             * \return true on success, false on failure (out of range, buffer too small) */
+            bool parseStructuredGridPoints(uint32_t firstPoint, uint32_t nbPoints, void* dest, size_t capacity) const;
+
+            /**
+             * \brief Build the index of the unstructured grid cells : the position of every cell in the CELLS array.
+             * When every cell has a fixed number of points (deduced from CELL_TYPES) the index is a prefix sum computed in parallel, and every count is checked.
+             * Otherwise (polygons, strips, etc.) the counts are walked.
+             * Once built, any cell is located in constant time (getUnstructuredGridCellsRange, ranged reads, VTKCellStream).
+             * Call it once after parse(), before any concurrent read
+             * \return true on success, false on failure (not an unstructured grid, corrupted counts)
+             */
+            bool buildUnstructuredGridCellIndex();
+
+            /**
+             * \brief Get the index of the unstructured grid cells. See buildUnstructuredGridCellIndex()
+             * \return nbCells+1 positions (in number of values) in the CELLS array, the last one being the end of the cells. NULL if the index is not built
+             */
+            const uint32_t* getUnstructuredGridCellIndex() const {return m_cellIndex.empty() ? NULL : m_cellIndex.data();}
+
+            /**
+             * \brief Get the range of values of the CELLS array describing a range of cells.
+             * The CELLS array has a variable length per cell : without the cell index (see buildUnstructuredGridCellIndex),
+             * the counts of the preceding cells are walked (without decoding the rest of the array)
+             * \param firstCell the first cell
+             * \param nbCells the number of cells
+             * \param firstValue[out] the index of the first value of firstCell in the CELLS array
+             * \param nbValues[out] the number of values describing the nbCells cells (counts included)
+             * \return true on success, false on failure (out of range, corrupted counts)
+             */
+            bool getUnstructuredGridCellsRange(uint32_t firstCell, uint32_t nbCells, uint32_t* firstValue, uint32_t* nbValues) const;
+
+            /**
+             * \brief Get the cells values of a range of cells. See parseAllUnstructuredGridCellsComposition()
+             * \param firstCell the first cell to read
+             * \param nbCells the number of cells to read
+             * \param nbValues[out] the number of values returned (counts included). Can be NULL
+             * \return data of the cell section (CELLS) for these cells. Need to be free (using free). NULL on error
+             */
+            int32_t* parseUnstructuredGridCellsComposition(uint32_t firstCell, uint32_t nbCells, uint32_t* nbValues) const;
+
+            /**
+             * \brief Get the cells values of a range of cells into a caller-provided buffer. Use getUnstructuredGridCellsRange to know the needed capacity
+             * \param firstCell the first cell to read
+             * \param nbCells the number of cells to read
+             * \param dest the buffer to fill
+             * \param capacity the number of values dest can contain
+             * \return a view on the values written in dest. Invalid view on failure (out of range, buffer too small)
+             */
+            VTKArrayView<int32_t> parseUnstructuredGridCellsComposition(uint32_t firstCell, uint32_t nbCells, int32_t* dest, size_t capacity) const;
+
+            /**
+             * \brief Get the cells types of a range of cells. See parseAllUnstructuredGridCellTypes()
+             * \param firstCell the first cell to read
+             * \param nbCells the number of cells to read
+             * \return the nbCells types. Need to be free (using free). NULL on error
+             */
+            int32_t* parseUnstructuredGridCellTypes(uint32_t firstCell, uint32_t nbCells) const;
+
+            /**
+             * \brief Get the cells types of a range of cells into a caller-provided buffer.
+             * \param firstCell the first cell to read
+             * \param nbCells the number of cells to read
+             * \param dest the buffer to fill
+             * \param capacity the number of values dest can contain
+             * \return a view on the values written in dest. Invalid view on failure (out of range, buffer too small)
+             */
+            VTKArrayView<int32_t> parseUnstructuredGridCellTypes(uint32_t firstCell, uint32_t nbCells, int32_t* dest, size_t capacity) const;
+
             /**
              * \brief  Get the field names present in the point data
              * \return  a list of field names 
@@ -300,6 +565,157 @@ namespace sereno
              */
             void* parseAllFieldValues(const VTKFieldValue* fieldData) const;
 
+            /**
+             * \brief  Get the field data internal values into a caller-provided buffer
+             * \param fieldData the field value descriptor
+             * \param dest the buffer to fill. Use fieldData.type to know how to cast this object
+             * \param capacity the size (in bytes) of dest. Needs at least nbTuples*nbValuePerTuple*VTKValueFormatInt(format) bytes
+             * \return true on success, false on failure (buffer too small, read error)
+             */
+            bool parseAllFieldValues(const VTKFieldValue* fieldData, void* dest, size_t capacity) const;
+
+            /**
+             * \brief  Get the field data internal values into a caller-provided typed buffer
+             * \param fieldData the field value descriptor
+             * \param dest the buffer to fill. T has to correspond to fieldData.format
+             * \param capacity the number of T values dest can contain
+             * \return a view on the nbTuples*nbValuePerTuple values written in dest. Invalid view on failure (type mismatch, buffer too small, read error)
+             */
+            template <typename T>
+            VTKArrayView<T> parseAllFieldValues(const VTKFieldValue* fieldData, T* dest, size_t capacity) const
+            {
+                if(VTKValueFormatOf<T>::value != fieldData->format || !parseAllFieldValues(fieldData, (void*)dest, capacity*sizeof(T)))
+                    return VTKArrayView<T>();
+                return VTKArrayView<T>(dest, (size_t)fieldData->nbTuples*fieldData->nbValuePerTuple);
+            }
+
+            /**
+             * \brief  Get the field data values converted into another format, the conversion being done while decoding (no copy in the file format).
+             * Lowers the memory used by the values, e.g., double to float, float to VTK_HALF_FLOAT, or values normalized on 8 or 16 bits
+             * \param fieldData the field value descriptor
+             * \param destFormat the format of the returned values
+             * \param quantization if not NULL, the values are normalized : mapped linearly from their [min, max] range onto [0, 255] (VTK_UNSIGNED_CHAR)
+             * or [0, 65535] (VTK_UNSIGNED_SHORT), NaN being mapped to 0. Receives the mapping to get the values back. NULL == values converted as is
+             * (integer formats are saturated to their range, NaN being converted to 0)
+             * \return a pointer to the nbTuples*nbValuePerTuple values in destFormat. Needs to be free (using free). NULL on error (unknown format, destFormat not normalizable)
+             */
+            void* parseAllFieldValues(const VTKFieldValue* fieldData, VTKValueFormat destFormat, VTKQuantization* quantization = NULL) const;
+
+            /**
+             * \brief  Get the field data values converted into another format into a caller-provided buffer. See parseAllFieldValues(fieldData, destFormat, quantization)
+             * \param fieldData the field value descriptor
+             * \param dest the buffer to fill
+             * \param capacity the size (in bytes) of dest. Needs at least nbTuples*nbValuePerTuple*VTKValueFormatInt(destFormat) bytes
+             * \param destFormat the format of the values written
+             * \param quantization if not NULL, the values are normalized, and quantization receives the mapping to get the values back
+             * \return true on success, false on failure (buffer too small, read error, unknown format, destFormat not normalizable)
+             */
+            bool parseAllFieldValues(const VTKFieldValue* fieldData, void* dest, size_t capacity, VTKValueFormat destFormat, VTKQuantization* quantization = NULL) const;
+
+            /**
+             * \brief  Get the field data internal values, computing the statistics of each component (e.g., the range of a colormap) while decoding them.
+             * Avoids a second pass over the values
+             * \param fieldData the field value descriptor
+             * \param stats[out] the statistics of each component (nbValuePerTuple values)
+             * \return a pointer to the field data. Needs to be free (using free). NULL on error
+             */
+            void* parseAllFieldValues(const VTKFieldValue* fieldData, VTKComponentStats* stats) const;
+
+            /**
+             * \brief  Get the field data internal values into a caller-provided buffer, computing the statistics of each component while decoding them
+             * \param fieldData the field value descriptor
+             * \param dest the buffer to fill. Use fieldData.type to know how to cast this object
+             * \param capacity the size (in bytes) of dest. Needs at least nbTuples*nbValuePerTuple*VTKValueFormatInt(format) bytes
+             * \param stats[out] the statistics of each component (nbValuePerTuple values)
+             * \return true on success, false on failure (buffer too small, read error)
+             */
+            bool parseAllFieldValues(const VTKFieldValue* fieldData, void* dest, size_t capacity, VTKComponentStats* stats) const;
+
+            /* \brief Get the read of all the values of a field value, for parseArrays
+             * \param fieldData the field value descriptor
+             * \param dest the buffer to fill. NULL == allocated by parseArrays
+             * \param capacity the size (in bytes) of dest
+             * \return the read to give to parseArrays */
+            static VTKArrayRead getFieldValuesRead(const VTKFieldValue* fieldData, void* dest = NULL, size_t capacity = 0);
+
+            /* \brief Get the read of all the unstructured grid points, for parseArrays. See getFieldValuesRead */
+            VTKArrayRead getUnstructuredGridPointsRead(void* dest = NULL, size_t capacity = 0) const;
+
+            /* \brief Get the read of the unstructured grid cells values, for parseArrays. See getFieldValuesRead */
+            VTKArrayRead getUnstructuredGridCellsRead(void* dest = NULL, size_t capacity = 0) const;
+
+            /* \brief Get the read of the unstructured grid cells types, for parseArrays. See getFieldValuesRead */
+            VTKArrayRead getUnstructuredGridCellTypesRead(void* dest = NULL, size_t capacity = 0) const;
+
+            /* \brief Get the read of all the structured grid points, for parseArrays. See getFieldValuesRead */
+            VTKArrayRead getStructuredGridPointsRead(void* dest = NULL, size_t capacity = 0) const;
+
+            /**
+             * \brief  Read several arrays at once (e.g., every field value, the points and the cells).
+             * The reads are sorted by offset and the file is swept once forward : the pages of the next arrays are prefetched while the previous ones are decoded,
+             * and the chunks of every array are decoded together by the thread pool. Cheaper than one call per array, especially on slow (spinning, network) storage
+             * Each array can be converted into another format (destFormat), and normalized (normalize), as with parseAllFieldValues(fieldData, destFormat, quantization).
+             * The statistics of each component of an array (stats) are computed while its chunks are decoded
+             * \param reads the arrays to read (see getFieldValuesRead, getUnstructuredGridPointsRead, etc.). Their dest (if NULL), success, quantization and stats fields are set
+             * \param nbReads the number of reads
+             * \return true if every array has been read, false otherwise (see the success field of each read, a failed read with dest == NULL is not allocated)
+             */
+            bool parseArrays(VTKArrayRead* reads, size_t nbReads) const;
+
+            /**
+             * \brief  Get a range of tuples (and optionally of components) of a field value.
+             * \param fieldData the field value descriptor
+             * \param firstTuple the first tuple to read
+             * \param nbTuples the number of tuples to read
+             * \param firstComponent the first component to read in each tuple
+             * \param nbComponents the number of components to read in each tuple. 0 == up to the last component
+             * \return a pointer to the nbTuples*nbComponents values (tuples are contiguous). Needs to be free (using free). NULL on error (out of range)
+             */
+            void* parseFieldValues(const VTKFieldValue* fieldData, uint32_t firstTuple, uint32_t nbTuples, uint32_t firstComponent = 0, uint32_t nbComponents = 0) const;
+
+            /**
+             * \brief  Get a range of tuples (and optionally of components) of a field value into a caller-provided buffer.
+             * \param fieldData the field value descriptor
+             * \param firstTuple the first tuple to read
+             * \param nbTuples the number of tuples to read
+             * \param dest the buffer to fill
+             * \param capacity the size (in bytes) of dest. Needs at least nbTuples*nbComponents*VTKValueFormatInt(format) bytes
+             * \param firstComponent the first component to read in each tuple
+             * \param nbComponents the number of components to read in each tuple. 0 == up to the last component
+             * \return true on success, false on failure (out of range, buffer too small)
+             */
+            bool parseFieldValues(const VTKFieldValue* fieldData, uint32_t firstTuple, uint32_t nbTuples, void* dest, size_t capacity,
+                                  uint32_t firstComponent = 0, uint32_t nbComponents = 0) const;
+
+            /**
+             * \brief  Get the structured points descriptor of a sub-volume : its size, and its spacing and origin adjusted to the box and the steps
+             * \param box the sub-volume
+             * \param descriptor[out] the descriptor of the sub-volume. Can be NULL
+             * \return true if box is valid (structured points dataset, box inside the dataset, steps > 0), false otherwise
+             */
+            bool getStructuredPointsSubVolumeDescriptor(const VTKSubVolume& box, VTKStructuredPoints* descriptor) const;
+
+            /**
+             * \brief  Get a sub-volume (optionally downsampled) of a point field value of a structured points dataset.
+             * Only the rows of the box are read, so a low resolution preview does not touch the whole volume
+             * \param fieldData the point field value descriptor
+             * \param box the sub-volume to read
+             * \param descriptor[out] the structured points descriptor of the values returned (see getStructuredPointsSubVolumeDescriptor). Can be NULL
+             * \return a pointer to the size[0]*size[1]*size[2] tuples of the sub-volume (x varying fastest). Needs to be free (using free). NULL on error (invalid box, not a point field value)
+             */
+            void* parseStructuredPointsFieldValues(const VTKFieldValue* fieldData, const VTKSubVolume& box, VTKStructuredPoints* descriptor = NULL) const;
+
+            /**
+             * \brief  Get a sub-volume (optionally downsampled) of a point field value of a structured points dataset into a caller-provided buffer
+             * \param fieldData the point field value descriptor
+             * \param box the sub-volume to read
+             * \param dest the buffer to fill
+             * \param capacity the size (in bytes) of dest. Needs at least size[0]*size[1]*size[2]*nbValuePerTuple*VTKValueFormatInt(format) bytes (see getStructuredPointsSubVolumeDescriptor)
+             * \param descriptor[out] the structured points descriptor of the values written. Can be NULL
+             * \return true on success, false on failure (invalid box, not a point field value, buffer too small)
+             */
+            bool parseStructuredPointsFieldValues(const VTKFieldValue* fieldData, const VTKSubVolume& box, void* dest, size_t capacity, VTKStructuredPoints* descriptor = NULL) const;
+
             /**
              * \brief  Get the dataset type of this VTK object
              * \return   the dataset type
@@ -312,6 +728,12 @@ namespace sereno
              */
             const VTKStructuredPoints& getStructuredPointsDescriptor() const {return m_strPoints;}
 
+            /**
+             * \brief  Get the structured grid descriptor (dimensions and point descriptor)
+             * \return   the structured grid descriptor
+             */
+            const VTKGrid& getStructuredGridDescriptor() const {return m_grid;}
+
             /**
              * \brief  Get the dataset unstructured grid point descriptor
              * \return the point descriptor
@@ -348,6 +770,103 @@ namespace sereno
              * \param buffer the buffer to fill*/
             void fillUnstructuredGridCellElementBuffer(uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes, int32_t* buffer);
 
+            /**
+             * \brief Fill the vertex buffers of every rendering mode in one sweep (see getMultiCellConstructionDescriptor)
+             * \param nbCells the number of cells to use
+             * \param ptValues the points values
+             * \param cellValues the cell values
+             * \param cellTypes the cell types
+             * \param buffers the buffer to fill per VTKGLMode (VTK_GL_NO_MODE buffers). A NULL buffer skips the cells of its mode
+             * \param destFormat the destination format. put VTK_NO_VALUE_TYPE if you want the points values format
+             */
+            void fillUnstructuredGridCellBuffers(uint32_t nbCells, void* ptValues, int32_t* cellValues, int32_t* cellTypes, void** buffers, VTKValueFormat destFormat = VTK_NO_VALUE_FORMAT) const;
+
+            /**
+             * \brief Fill the element buffers of every rendering mode in one sweep (see getMultiCellConstructionDescriptor)
+             * \param nbCells the number of cells to use
+             * \param cellValues the cell values
+             * \param cellTypes the cell types
+             * \param buffers the buffer to fill per VTKGLMode (VTK_GL_NO_MODE buffers). A NULL buffer skips the cells of its mode
+             */
+            void fillUnstructuredGridCellElementBuffers(uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes, int32_t** buffers) const;
+
+            /**
+             * \brief Get the number of indices of the cells rendered with a given mode. See fillUnstructuredGridCellElementBuffer(uint32_t, int32_t*, int32_t*, VTKGLMode, void*, VTKIndexFormat)
+             * Cells are read up to the first cell type not supported
+             * \param nbCells the number of cells to use
+             * \param cellValues the cell values
+             * \param cellTypes the cell types
+             * \param mode the rendering mode of the cells to take into account
+             * \return the number of indices
+             */
+            size_t getUnstructuredGridCellElementBufferSize(uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes, VTKGLMode mode) const;
+
+            /**
+             * \brief Fill an indexed element buffer with the cells rendered with a given mode, skipping the other cells.
+             * The indices refer to the points of the dataset (see parseAllUnstructuredGridPoints(VTKValueFormat)), so shared points are sent once.
+             * Call it once per mode for datasets mixing several modes (e.g., triangles and lines)
+             * \param nbCells the number of cells to use
+             * \param cellValues the cell values
+             * \param cellTypes the cell types
+             * \param mode the rendering mode of the cells to write
+             * \param buffer the buffer to fill (getUnstructuredGridCellElementBufferSize indices)
+             * \param format the format of the indices. VTK_INDEX_UINT16 needs every point index to be lower than 65536
+             * \return true on success, false if a point index cannot be represented in format
+             */
+            bool fillUnstructuredGridCellElementBuffer(uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes, VTKGLMode mode, void* buffer, VTKIndexFormat format) const;
+
+            /**
+             * \brief Extract the boundary surface of the cells : the faces of 3D cells not shared with another cell, and the 2D cells (triangles, quads, etc.).
+             * Faces are identified by their sorted point indices, hashed in parallel. Only the nbCells cells are taken into account.
+             * The result is an indexed element buffer rendered with VTK_GL_TRIANGLES (see fillUnstructuredGridCellElementBuffer), faces being oriented outward
+             * \param nbCells the number of cells to use
+             * \param cellValues the cell values
+             * \param cellTypes the cell types
+             * \param format the format of the indices. VTK_INDEX_UINT16 needs every point index to be lower than 65536
+             * \param nbIndices[out] the number of indices returned
+             * \return the element buffer (3 indices per triangle). Need to be free (using free). NULL on error (index not representable in format)
+             */
+            void* extractUnstructuredGridBoundaryElementBuffer(uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes, VTKIndexFormat format, size_t* nbIndices) const;
+
+            /**
+             * \brief Get the number of cells of the structured grid. The connectivity is implicit : the cells are ordered like the points,
+             * and each cell joins the neighbour points along the axes having more than one point (see getStructuredGridCellType)
+             * \return the number of cells. 0 if the dataset is not a structured grid
+             */
+            uint32_t getStructuredGridNbCells() const;
+
+            /**
+             * \brief Get the type of the cells of the structured grid
+             * \return VTK_CELL_HEXAHEDRON, VTK_CELL_QUAD, VTK_CELL_LINE or VTK_CELL_VERTEX depending on the number of axes having more than one point
+             */
+            VTKCellType getStructuredGridCellType() const;
+
+            /**
+             * \brief Fill an element buffer with the points of a range of cells of the structured grid, in the VTK order of getStructuredGridCellType().
+             * The connectivity is generated from the grid dimensions, no CELLS array exists
+             * \param firstCell the first cell
+             * \param nbCells the number of cells
+             * \param buffer the buffer to fill (nbCells*VTKCellTypeInt(getStructuredGridCellType()) indices)
+             * \param format the format of the indices. VTK_INDEX_UINT16 needs at most 65536 points
+             * \return true on success, false on failure (not a structured grid, out of range, index not representable in format)
+             */
+            bool fillStructuredGridCellElementBuffer(uint32_t firstCell, uint32_t nbCells, void* buffer, VTKIndexFormat format) const;
+
+            /**
+             * \brief Get the number of indices of the boundary surface of the structured grid. See fillStructuredGridBoundaryElementBuffer
+             * \return the number of indices. 0 if the dataset is not a structured grid
+             */
+            size_t getStructuredGridBoundaryElementBufferSize() const;
+
+            /**
+             * \brief Fill an indexed element buffer (VTK_GL_TRIANGLES) with the boundary surface of the structured grid : the six sides of the grid, oriented outward
+             * (for a right-handed grid), or the grid itself when it is flat. The indices refer to the points of the grid (see parseAllStructuredGridPoints)
+             * \param buffer the buffer to fill (getStructuredGridBoundaryElementBufferSize indices)
+             * \param format the format of the indices. VTK_INDEX_UINT16 needs at most 65536 points
+             * \return true on success, false on failure (not a structured grid, index not representable in format)
+             */
+            bool fillStructuredGridBoundaryElementBuffer(void* buffer, VTKIndexFormat format) const;
+
             /**
              * \brief Get the cell construction descriptor. It the type needed to render the dataset changed, this function returns before having parsed everything
              * \param nbCells    the number of cells to read
@@ -357,48 +876,322 @@ namespace sereno
              * \return a VTKCellConstruction telling the buffer size and the advancement for the next datasets
              */
             static VTKCellConstruction getCellConstructionDescriptor(uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes);
+
+            /**
+             * \brief Get the construction descriptor of every rendering mode in one pass : cells are bucketed per mode instead of stopping at the first mode change.
+             * Stops at the first cell not supported or not valid (error set)
+             * \param nbCells    the number of cells to read
+             * \param cellValues the cell values (see parseAllUnstructuredGridCells)
+             * \param cellTypes  the cell types (see parseAllUnstructuredGridCellTypes)
+             * \return a VTKMultiCellConstruction telling the buffer size of each mode and the advancement for the next datasets
+             */
+            static VTKMultiCellConstruction getMultiCellConstructionDescriptor(uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes);
+
+            /**
+             * \brief Compute a Z-order (Morton) reordering of the unstructured grid : the points are sorted by the Morton code of their position,
+             * the cells by the Morton code of their centroid. Points (and cells) close in space end up close in memory,
+             * which improves the cache hit rates of anything gathering points per cell (fill functions, GPU vertex fetching).
+             * Apply the orders with permuteTuples (points, point field values, cell types, cell field values) and remapUnstructuredGridCells (cells values).
+             * Runs on the thread pool, except the walk finding where each cell begins in cellValues (sequential by nature)
+             * \param points the points of the grid (see parseAllUnstructuredGridPoints)
+             * \param nbCells the number of cells described by cellValues. 0 == reorder only the points
+             * \param cellValues the cells values (see parseAllUnstructuredGridCellsComposition). Can be NULL if nbCells == 0
+             * \param nbValues the number of values of cellValues (e.g., VTKCells::wholeSize). The cells cannot go beyond it
+             * \param pointOrder[out] nbPoints values : pointOrder[i] is the index, before reordering, of the point i
+             * \param cellOrder[out] nbCells values : cellOrder[i] is the index, before reordering, of the cell i. Can be NULL if nbCells == 0
+             * \return true on success, false on failure (not an unstructured grid, corrupted cells)
+             */
+            bool computeUnstructuredGridMortonOrder(const void* points, uint32_t nbCells, const int32_t* cellValues, size_t nbValues, uint32_t* pointOrder, uint32_t* cellOrder) const;
+
+            /**
+             * \brief Reorder an array of tuples : dest[i] = src[order[i]]
+             * \param src the tuples to reorder
+             * \param nbTuples the number of tuples
+             * \param tupleSize the size (in bytes) of a tuple (e.g., nbValuePerTuple*VTKValueFormatInt(format))
+             * \param order the order (see computeUnstructuredGridMortonOrder)
+             * \param dest the buffer to fill (nbTuples*tupleSize bytes). Has to be different from src
+             * \return true on success, false on failure (order out of range)
+             */
+            bool permuteTuples(const void* src, uint32_t nbTuples, size_t tupleSize, const uint32_t* order, void* dest) const;
+
+            /**
+             * \brief Reorder the cells values and remap their point indices after a reordering of the points.
+             * Runs on the thread pool, except the walk finding where each cell begins in cellValues (sequential by nature)
+             * \param nbCells the number of cells described by cellValues
+             * \param cellValues the cells values (see parseAllUnstructuredGridCellsComposition)
+             * \param nbValues the number of values of cellValues (e.g., VTKCells::wholeSize). The cells cannot go beyond it
+             * \param nbPoints the number of points
+             * \param pointOrder the order of the points (see computeUnstructuredGridMortonOrder)
+             * \param cellOrder the order of the cells. NULL == keep the cells order
+             * \param dest the buffer to fill, as large as cellValues. Has to be different from cellValues
+             * \return true on success, false on failure (corrupted cells, point index out of range, pointOrder not a permutation)
+             */
+            bool remapUnstructuredGridCells(uint32_t nbCells, const int32_t* cellValues, size_t nbValues, uint32_t nbPoints, const uint32_t* pointOrder,
+                                            const uint32_t* cellOrder, int32_t* dest) const;
         private:
+            friend struct VTKCellStream;
+            friend struct VTKAsyncLoader;
+
             VTKParser(const VTKParser& copy);
             VTKParser& operator=(const VTKParser& copy);
 
+            /* \brief Map the whole file in memory
+             * \param path the file path to map
+             * \return false on error, true on success */
+            bool mapFile(const std::string& path);
+
             /* \brief Parse the unstructured part of the file
-             * \param file the file to read
+             * \param tokenizer the tokenizer reading the mapped file
              * \return false on error, true on success */
-            bool parseUnstructuredGrid(FILE* file);
+            bool parseUnstructuredGrid(VTKTokenizer& tokenizer);
 
             /* \brief Parse the structured grid part of the file
-             * \param file the file to read
+             * \param tokenizer the tokenizer reading the mapped file
              * \return false on error, true on success */
-            bool parseStructuredGrid(FILE* file);
+            bool parseStructuredGrid(VTKTokenizer& tokenizer);
 
             /* \brief Parse the structured points part of the file
-             * \param file the file to read
+             * \param tokenizer the tokenizer reading the mapped file
              * \return false on error, true on success */
-            bool parseStructuredPoints(FILE* file);
+            bool parseStructuredPoints(VTKTokenizer& tokenizer);
 
             /**
              * \brief  Parse values (points / cells values)
-             * \param file the file to read
+             * \param tokenizer the tokenizer reading the mapped file
              * \param data the data to update
              * \return true on success, false on failure
              */
-            bool parseValues(FILE* file, VTKData& data);
+            bool parseValues(VTKTokenizer& tokenizer, VTKData& data);
             
+            /**
+             * \brief  Parse the values of an array (points, cells, field values). BINARY values are only skipped.
+             * ASCII values are parsed in parallel and stored as in a BINARY file (big endian) in m_asciiData
+             * \param tokenizer the tokenizer reading the mapped file. Set after the last value
+             * \param nbValues the number of values
+             * \param format the values format
+             * \param offset[out] the offset of the (binary) values in m_data once parsed
+             * \return false on error, true on success
+             */
+            bool parseArrayValues(VTKTokenizer& tokenizer, size_t nbValues, VTKValueFormat format, size_t& offset);
+
+            /**
+             * \brief  Read the arrays of an ASCII file from m_asciiData instead of the mapped text
+             */
+            void useAsciiData();
+
+            /* \brief Is m_data the mapped VTK file ?
+             * \return true if m_data is mapped, false if it is the values of an ASCII file (see m_asciiData) */
+            bool isDataMapped() const {return m_data != m_asciiData.data();}
+
             /**
              * \brief  Parse a metadata block
-             * \param file the file to read
+             * \param tokenizer the tokenizer reading the mapped file
              * \return false on error, true on success
              */
-            bool parseMetadata(FILE* file);
+            bool parseMetadata(VTKTokenizer& tokenizer);
+
+            /**
+             * \brief  Load the file structures from the cache file, if it is up to date
+             * \return true on success, false if no valid cache exists
+             */
+            bool loadCache();
+
+            /**
+             * \brief  Write the cache file of the parsed VTK file. A failure is reported but is not fatal
+             */
+            void saveCache() const;
+
+            /**
+             * \brief  Serialize the file structures (dataset, fields) stored in the cache file
+             * \param metadata[out] the serialized structures
+             */
+            void serializeMetadata(std::string& metadata) const;
+
+            /**
+             * \brief  Restore the file structures serialized by serializeMetadata
+             * \param metadata the serialized structures
+             * \param size the size of metadata
+             * \return true on success, false if metadata is corrupted
+             */
+            bool deserializeMetadata(const uint8_t* metadata, size_t size);
+
+            /**
+             * \brief  Get every binary array of the parsed file, to be stored in the cache file
+             * \param arrays[out] the arrays
+             */
+            void getCacheArrays(std::vector<VTKCacheArray>& arrays) const;
+
+            /**
+             * \brief  Get the host-endian values of a part of the mapped file from the cache file
+             * \param offset the offset (in bytes) of the values in the VTK file
+             * \param size the size (in bytes) of the values
+             * \return the cached values, NULL if no cache is loaded or if this part is not cached
+             */
+            const uint8_t* getCachedValues(size_t offset, size_t size) const {return m_cache ? m_cache->getValues(offset, size) : NULL;}
+
+            /* \brief Advise the system about a part of the mapped file. Nothing is done if the file is not mapped (ASCII file)
+             * \param offset the offset of the part in the file
+             * \param size the size of the part
+             * \param willNeed true to prefetch it, false to release it */
+            void adviseData(size_t offset, size_t size, bool willNeed) const;
+
+            /**
+             * \brief  Read and convert binary values from the mapped file
+             * \param offset the offset (in bytes) of the first value in the file
+             * \param nbValues the number of values to read
+             * \param format the values format
+             * \return a buffer containing the values (host endianness). Needs to be free (using free). NULL on error
+             */
+            void* getAllBinaryValues(size_t offset, size_t nbValues, VTKValueFormat format) const;
+
+            /**
+             * \brief  Convert binary values from the mapped file into a buffer. Large arrays are split in chunks decoded by the thread pool
+             * \param offset the offset (in bytes) of the first value in the file
+             * \param nbValues the number of values to read
+             * \param format the values format
+             * \param dest the destination buffer (nbValues*VTKValueFormatInt(format) bytes)
+             * \return true on success, false on error (out of file, bad format)
+             */
+            bool decodeBinaryValues(size_t offset, size_t nbValues, VTKValueFormat format, void* dest) const;
+
+            /**
+             * \brief  Same as decodeBinaryValues, checking first the destination buffer size
+             * \param offset the offset (in bytes) of the first value in the file
+             * \param nbValues the number of values to read
+             * \param format the values format
+             * \param dest the destination buffer
+             * \param capacity the size (in bytes) of dest
+             * \return true on success, false on error (buffer too small, out of file, bad format)
+             */
+            bool decodeBinaryValues(size_t offset, size_t nbValues, VTKValueFormat format, void* dest, size_t capacity) const;
+
+            /**
+             * \brief  Convert values from the mapped file into a buffer of another format
+             * \param offset the offset (in bytes) of the first value in the file
+             * \param nbValues the number of values to convert
+             * \param format the values format in the file
+             * \param dest the destination buffer (nbValues*VTKValueFormatInt(destFormat) bytes)
+             * \param destFormat the values format in dest
+             * \return true on success, false on error (out of file, bad format)
+             */
+            bool convertBinaryValues(size_t offset, size_t nbValues, VTKValueFormat format, void* dest, VTKValueFormat destFormat) const;
+
+            /**
+             * \brief  Get the range of values from the mapped file. NaN and infinite values are ignored
+             * \param offset the offset (in bytes) of the first value in the file
+             * \param nbValues the number of values
+             * \param format the values format in the file
+             * \param minVal[out] the minimum value (0 if there is no finite value)
+             * \param maxVal[out] the maximum value (0 if there is no finite value)
+             * \return true on success, false on error (out of file, bad format)
+             */
+            bool getBinaryValuesRange(size_t offset, size_t nbValues, VTKValueFormat format, double* minVal, double* maxVal) const;
+
+            /**
+             * \brief  Normalize values from the mapped file into a buffer : the values are mapped linearly from their range onto the whole range of destFormat
+             * \param offset the offset (in bytes) of the first value in the file
+             * \param nbValues the number of values to convert
+             * \param format the values format in the file
+             * \param dest the destination buffer (nbValues*VTKValueFormatInt(destFormat) bytes)
+             * \param destFormat the values format in dest (VTK_UNSIGNED_CHAR or VTK_UNSIGNED_SHORT)
+             * \param quantization[out] the mapping to get the values back
+             * \return true on success, false on error (out of file, bad format)
+             */
+            bool quantizeBinaryValues(size_t offset, size_t nbValues, VTKValueFormat format, void* dest, VTKValueFormat destFormat, VTKQuantization* quantization) const;
+
+            /**
+             * \brief  Convert a sub-range of components of consecutive tuples from the mapped file into a buffer. The components read are packed in dest
+             * \param offset the offset (in bytes) of the first tuple in the file
+             * \param nbTuples the number of tuples to read
+             * \param nbValuePerTuple the number of values per tuple in the file
+             * \param firstComponent the first component to read in each tuple
+             * \param nbComponents the number of components to read in each tuple
+             * \param format the values format
+             * \param dest the destination buffer (nbTuples*nbComponents*VTKValueFormatInt(format) bytes)
+             * \return true on success, false on error (out of file, bad format)
+             */
+            bool decodeBinaryTuples(size_t offset, size_t nbTuples, uint32_t nbValuePerTuple, uint32_t firstComponent, uint32_t nbComponents,
+                                    VTKValueFormat format, void* dest) const;
+
+            /** \brief  A chunk of consecutive cells filled by one thread */
+            struct CellChunk
+            {
+                const int32_t* cellValues;   /*!< The cell values of the first cell of this chunk*/
+                uint32_t       firstCell;    /*!< The first cell of this chunk*/
+                uint32_t       nbCells;      /*!< The number of cells in this chunk*/
+                size_t         bufferOffset; /*!< The position of this chunk in the buffer to fill (in sizeBuffer unit)*/
+                size_t         modeOffsets[VTK_GL_NO_MODE]; /*!< The position of this chunk in the buffer of each rendering mode (in sizeBuffer unit)*/
+            };
+
+            /**
+             * \brief  Split cells in chunks and compute, in parallel, where each chunk is written in the buffers to fill (prefix sum of the cells sizeBuffer).
+             * Cells beyond the first cell not supported are discarded
+             * \param nbCells the number of cells
+             * \param cellValues the cell values
+             * \param cellTypes the cell types
+             * \param chunks[out] the chunks of cells
+             * \param mode only the cells rendered with this mode are taken into account. VTK_GL_NO_MODE == every cell
+             * \param modeSizes[out] if not NULL, the size of the buffer of each rendering mode (in sizeBuffer unit)
+             * \return the size of the buffer to fill (in sizeBuffer unit)
+             */
+            size_t planCellFill(uint32_t nbCells, const int32_t* cellValues, const int32_t* cellTypes, std::vector<CellChunk>& chunks, VTKGLMode mode = VTK_GL_NO_MODE,
+                                size_t* modeSizes = NULL) const;
 
-            void* getAllBinaryValues(size_t offset, uint32_t nbValues, VTKValueFormat format) const;
+            /**
+             * \brief  Run a function on every chunk of cells, in parallel if the buffer to fill is large enough
+             * \param chunks the chunks (see planCellFill)
+             * \param bufferSize the size (in bytes) of the buffer to fill
+             * \param func the function to call per chunk
+             */
+            void runCellChunks(const std::vector<CellChunk>& chunks, size_t bufferSize, const std::function<void(const CellChunk&)>& func) const;
+
+            /**
+             * \brief  Check that the points format and a destination format have specialized fill kernels (see VTKCellVT::fillBuffers)
+             * \param destFormat the destination format
+             * \return true if supported, false otherwise (an error is printed)
+             */
+            bool checkCellFillFormats(VTKValueFormat destFormat) const;
+
+            /**
+             * \brief  Get the number of consecutive cells sharing the type of the first one
+             * \param cellTypes the cell types, beginning at the first cell
+             * \param nbCells the number of cells available
+             * \return the number of cells of the run (at least 1 if nbCells > 0)
+             */
+            static uint32_t getCellTypeRun(const int32_t* cellTypes, uint32_t nbCells);
+
+            /**
+             * \brief  Build the cell index from the cell types, in parallel. Only works if every cell has a fixed number of points
+             * \param index[out] the index to fill (nbCells+1 values)
+             * \return true on success, false if a cell type has no fixed number of points or if a count does not correspond to its cell type
+             */
+            bool buildCellIndexFromTypes(std::vector<uint32_t>& index) const;
+
+            /**
+             * \brief  Build the cell index by walking the cell counts
+             * \param index[out] the index to fill (nbCells+1 values)
+             * \return true on success, false on failure (corrupted counts)
+             */
+            bool buildCellIndexFromCounts(std::vector<uint32_t>& index) const;
+
+            /* \brief Get the position of every cell in a cells values array
+             * \param nbCells the number of cells described by cellValues
+             * \param cellValues the cells values
+             * \param nbValues the number of values of cellValues
+             * \param offsets[out] nbCells+1 positions in cellValues, the last one being the end of the cells
+             * \return false if a count is negative or goes beyond nbValues, true otherwise */
+            static bool getCellOffsets(uint32_t nbCells, const int32_t* cellValues, size_t nbValues, std::vector<size_t>& offsets);
+
+            /* \brief Compute the Morton order of the unstructured grid. See computeUnstructuredGridMortonOrder */
+            template <typename T>
+            bool computeMortonOrder(const T* points, uint32_t nbCells, const int32_t* cellValues, size_t nbValues, uint32_t* pointOrder, uint32_t* cellOrder) const;
 
             /**
              * \brief  Convert a VTK String to a VTKValueFormat (int, double, etc.)
              * \param str the string to convert
              * \return the value format
              */
-            static VTKValueFormat vtkStringToFormat(const std::string& str);
+            static VTKValueFormat vtkStringToFormat(const VTKToken& str);
 
             VTKDatasetType m_type;                 /*!< The dataset type*/
             union
@@ -418,24 +1211,18 @@ namespace sereno
             uint32_t    m_minorVer = 0;            /*!< The minor version used*/
             uint32_t    m_majorVer = 0;            /*!< The major version used*/
             std::string m_header;
-            FILE*       m_file = NULL;                 /*!< The VTK file descriptor*/
-
-            //The regexes
-            static const std::regex versionRegex;      /*!< Regex checking the VERSIONing*/
-            static const std::regex datasetRegex;      /*!< Regex checking the DATASET name*/
-            static const std::regex pointsRegex;       /*!< Regex checking the POINTS     (unstructured grid)*/
-            static const std::regex cellsRegex;        /*!< Regex checking the CELLS      (unstructured grid)*/
-            static const std::regex cellTypesRegex;    /*!< Regex checking the CELL_TYPES (unstructured grid)*/
-            static const std::regex dimensionsRegex;   /*!< Regex checking the DIMENSIONS (structured points)*/
-            static const std::regex spacingRegex;      /*!< Regex checking the SPACING    (structured points)*/
-            static const std::regex originRegex;       /*!< Regex checking the ORIGIN     (structured points)*/
-            static const std::regex pointDataRegex;    /*!< Regex checking the POINT_DATA */
-            static const std::regex cellDataRegex;     /*!< Regex checking the CELL_DATA */
-            static const std::regex informationRegex;  /*!< Regex checking the INFORMATION (METADATA)*/
-            static const std::regex dataRegex;         /*!< Regex checking the DATA information (METADATA)*/
-            static const std::regex nameLocationRegex; /*!< Regex checking the NAME <word> LOCATION <word> (METADATA)*/
-            static const std::regex fieldRegex;        /*!< Regex checking the FIELD*/
-            static const std::regex fieldValueRegex;   /*!< Regex checking the FIELD VALUE (field)*/
+            uint8_t*    m_data     = NULL;         /*!< The memory mapped VTK file*/
+            size_t      m_dataSize = 0;            /*!< The size of the memory mapped VTK file*/
+            std::vector<uint8_t> m_asciiData;      /*!< The values of an ASCII file, parsed and stored as in a BINARY file. m_data points to it once parsed*/
+
+            std::unique_ptr<VTKThreadPool> m_threadPool;        /*!< The threads decoding large arrays*/
+            size_t                         m_parallelThreshold; /*!< Size (in bytes) under which arrays are decoded serially*/
+
+            std::vector<uint32_t> m_cellIndex;     /*!< The position of every cell in the CELLS array (see buildUnstructuredGridCellIndex). Empty if not built*/
+
+            bool                      m_cacheEnabled = false; /*!< Should parse() use the cache file ?*/
+            std::string               m_cacheDirectory;       /*!< The directory of the cache files. Empty == next to the VTK file*/
+            std::unique_ptr<VTKCache> m_cache;                /*!< The cache file read. NULL if the arrays are read from the VTK file*/
     };
 }
 
@@ -9,11 +9,15 @@ namespace sereno
 {
     struct VTKParser;
     struct VTKFieldValue;
+    struct VTKCellStream;
+    struct VTKBrickPyramid;
 
     extern "C"
     {
         typedef VTKParser*           HVTKParser;
         typedef const VTKFieldValue* HVTKFieldValue;
+        typedef VTKCellStream*       HVTKCellStream;
+        typedef VTKBrickPyramid*     HVTKBrickPyramid;
 
         /**
          * \brief  Create a VTKParser C object
@@ -28,12 +32,42 @@ namespace sereno
         DllExport void WINAPI            VTKParser_delete(HVTKParser parser);
 
         /**
-         * \brief  Parse the VTK object information
+         * \brief  Parse the VTK object information. Once parsed, the VTKParser_get* and VTKParser_parse* functions can be called concurrently
+         * on the same parser from several threads (see VTKParser)
          * \param parser the parser containing the information
          * \return   1 on success, 0 otherwise
          */
         DllExport char WINAPI            VTKParser_parse(HVTKParser parser);
 
+        /**
+         * \brief  Set the number of threads used to decode large arrays. Do not call it while arrays are being read
+         * \param parser the parser to configure
+         * \param nbThreads the number of threads (caller included). 0 == the number of hardware threads, 1 == serial decoding
+         */
+        DllExport void WINAPI            VTKParser_setNbThreads(HVTKParser parser, uint32_t nbThreads);
+
+        /**
+         * \brief  Set the size under which arrays are decoded serially
+         * \param parser the parser to configure
+         * \param size the size in bytes
+         */
+        DllExport void WINAPI            VTKParser_setParallelThreshold(HVTKParser parser, size_t size);
+
+        /**
+         * \brief  Enable the binary cache sidecar (see VTKParser::setCacheEnabled). Must be called before VTKParser_parse
+         * \param parser the parser to configure
+         * \param enable 1 to use the cache, 0 otherwise
+         * \param directory the directory of the cache files. NULL or empty == next to the VTK file
+         */
+        DllExport void WINAPI            VTKParser_setCacheEnabled(HVTKParser parser, char enable, const char* directory);
+
+        /**
+         * \brief  Has the last VTKParser_parse been served by the cache file ?
+         * \param parser the parser to look at
+         * \return   1 if the data are read from the cache file, 0 otherwise
+         */
+        DllExport char WINAPI            VTKParser_isLoadedFromCache(HVTKParser parser);
+
         /**
          * \brief  Get all the point field value descriptor
          * \param parser the parser containing the information
@@ -64,6 +98,13 @@ namespace sereno
          */
         DllExport const VTKStructuredPoints* WINAPI VTKParser_getStructuredPointsDescriptor(HVTKParser parser);
 
+        /**
+         * \brief  Get the StructuredGrid descriptor (dimensions and point descriptor)
+         * \param parser the parser containing the information
+         * \return   the descriptor, owned by the parser
+         */
+        DllExport const VTKGrid* WINAPI VTKParser_getStructuredGridDescriptor(HVTKParser parser);
+
         /**
          * \brief  Get the dataset unstructured grid point descriptor
          * \param parser the parser containing the information
@@ -89,6 +130,31 @@ namespace sereno
          */
         DllExport void* WINAPI VTKParser_parseAllUnstructuredGridPoints(HVTKParser parser);
 
+        /**
+         * \brief  Parse all unstructured grid point, converted into another format (e.g., to upload them once with an indexed element buffer)
+         * \param parser the parser containing the information
+         * \param destFormat the format of the returned values
+         * \return   allocated memory containing the nbPoints*3 values in destFormat. Needs to be freed (free(val)). NULL on error
+         */
+        DllExport void* WINAPI VTKParser_parseAllUnstructuredGridPointsAs(HVTKParser parser, VTKValueFormat destFormat);
+
+        /**
+         * \brief  Parse all unstructured grid point into a caller-provided buffer (no allocation)
+         * \param parser the parser containing the information
+         * \param dest the buffer to fill
+         * \param capacity the size (in bytes) of dest. Needs at least nbPoints*3*VTKValueFormatInt(format) bytes
+         * \return   1 on success, 0 otherwise (buffer too small, read error)
+         */
+        DllExport char WINAPI VTKParser_parseAllUnstructuredGridPointsInto(HVTKParser parser, void* dest, size_t capacity);
+
+        /**
+         * \brief  Parse all unstructured grid point, computing their bounding box while decoding them
+         * \param parser the parser containing the information
+         * \param bounds the statistics of the x, y and z components (3 values) to fill : min and max are the bounding box, mean is the centroid
+         * \return   allocated memory containing the point values. Needs to be freed (free(val)). NULL on error
+         */
+        DllExport void* WINAPI VTKParser_parseAllUnstructuredGridPointsWithStats(HVTKParser parser, VTKComponentStats* bounds);
+
         /**
          * \brief Get the cells values
          * \param parser the parser containing the information
@@ -98,6 +164,15 @@ namespace sereno
          */
         DllExport int32_t* WINAPI VTKParser_parseAllUnstructuredGridCellsComposition(HVTKParser parser);
 
+        /**
+         * \brief Get the cells values into a caller-provided buffer (no allocation)
+         * \param parser the parser containing the information
+         * \param dest the buffer to fill
+         * \param capacity the size (in bytes) of dest. Needs at least wholeSize*4 bytes
+         * \return   1 on success, 0 otherwise (buffer too small, read error)
+         */
+        DllExport char WINAPI VTKParser_parseAllUnstructuredGridCellsCompositionInto(HVTKParser parser, int32_t* dest, size_t capacity);
+
         /**
          * \brief Get the cells types.
          * \param parser the parser containing the information
@@ -105,6 +180,57 @@ namespace sereno
          * These information tells you how to combine the points given by parseAllUnstructuredGridCellsComposition function*/
         DllExport int32_t* WINAPI VTKParser_parseAllUnstructuredGridCellTypes(HVTKParser parser);
 
+        /**
+         * \brief Get the cells types into a caller-provided buffer (no allocation)
+         * \param parser the parser containing the information
+         * \param dest the buffer to fill
+         * \param capacity the size (in bytes) of dest. Needs at least nbCells*4 bytes
+         * \return   1 on success, 0 otherwise (buffer too small, read error)
+         */
+        DllExport char WINAPI VTKParser_parseAllUnstructuredGridCellTypesInto(HVTKParser parser, int32_t* dest, size_t capacity);
+
+        /**
+         * \brief  Parse a range of the unstructured grid points
+         * \param parser the parser containing the information
+         * \param firstPoint the first point to read
+         * \param nbPoints the number of points to read
+         * \return   allocated memory containing the nbPoints*3 values. Needs to be freed (free(val)). NULL on error (out of range)
+         */
+        DllExport void* WINAPI VTKParser_parseUnstructuredGridPoints(HVTKParser parser, uint32_t firstPoint, uint32_t nbPoints);
+
+        /**
+         * \brief  Build the index of the unstructured grid cells, locating any cell in constant time. Call it once after VTKParser_parse
+         * \param parser the parser containing the information
+         * \return 1 on success, 0 on failure (not an unstructured grid, corrupted cells)
+         */
+        DllExport char WINAPI VTKParser_buildUnstructuredGridCellIndex(HVTKParser parser);
+
+        /**
+         * \brief  Get the index of the unstructured grid cells
+         * \param parser the parser containing the information
+         * \return nbCells+1 positions in the CELLS array (the last one being the end of the cells), owned by the parser. NULL if not built
+         */
+        DllExport const uint32_t* WINAPI VTKParser_getUnstructuredGridCellIndex(HVTKParser parser);
+
+        /**
+         * \brief Get the cells values (CELLS) of a range of cells
+         * \param parser the parser containing the information
+         * \param firstCell the first cell to read
+         * \param nbCells the number of cells to read
+         * \param nbValues[out] the number of values returned (counts included)
+         * \return allocated memory containing the values. Needs to be freed (free(val)). NULL on error (out of range)
+         */
+        DllExport int32_t* WINAPI VTKParser_parseUnstructuredGridCellsComposition(HVTKParser parser, uint32_t firstCell, uint32_t nbCells, uint32_t* nbValues);
+
+        /**
+         * \brief Get the cells types (CELL_TYPES) of a range of cells
+         * \param parser the parser containing the information
+         * \param firstCell the first cell to read
+         * \param nbCells the number of cells to read
+         * \return allocated memory containing the nbCells types. Needs to be freed (free(val)). NULL on error (out of range)
+         */
+        DllExport int32_t* WINAPI VTKParser_parseUnstructuredGridCellTypes(HVTKParser parser, uint32_t firstCell, uint32_t nbCells);
+
         /**
          * \brief  Get the number of tuples from a VTKFieldValue descriptor object
          * \param value the descriptor
@@ -141,6 +267,172 @@ namespace sereno
          */
         DllExport void* WINAPI VTKParser_parseAllFieldValues(HVTKParser parser, HVTKFieldValue value);
 
+        /**
+         * \brief  Parse the field value into a caller-provided buffer (no allocation)
+         * \param parser the parser containing the information
+         * \param value the field value descriptor to get data from
+         * \param dest the buffer to fill
+         * \param capacity the size (in bytes) of dest. Needs at least format*tuple*nbValuePerTuple bytes
+         * \return   1 on success, 0 otherwise (buffer too small, read error)
+         */
+        DllExport char WINAPI VTKParser_parseAllFieldValuesInto(HVTKParser parser, HVTKFieldValue value, void* dest, size_t capacity);
+
+        /**
+         * \brief  Parse the field value, converted into another format while decoding (e.g., VTK_DOUBLE to VTK_FLOAT, VTK_FLOAT to VTK_HALF_FLOAT)
+         * \param parser the parser containing the information
+         * \param value the field value descriptor to get data from
+         * \param destFormat the format of the returned values
+         * \param quantization if not NULL, the values are normalized onto the whole range of destFormat (VTK_UNSIGNED_CHAR or VTK_UNSIGNED_SHORT),
+         * and quantization receives the mapping to get the values back (value = scale*normalized + offset)
+         * \return   a pointer to the allocated memory containing the tuple*nbValuePerTuple values in destFormat (needs to be freed using free). NULL on error
+         */
+        DllExport void* WINAPI VTKParser_parseAllFieldValuesAs(HVTKParser parser, HVTKFieldValue value, VTKValueFormat destFormat, VTKQuantization* quantization);
+
+        /**
+         * \brief  Parse the field value, converted into another format, into a caller-provided buffer. See VTKParser_parseAllFieldValuesAs
+         * \param parser the parser containing the information
+         * \param value the field value descriptor to get data from
+         * \param dest the buffer to fill
+         * \param capacity the size (in bytes) of dest. Needs at least destFormat*tuple*nbValuePerTuple bytes
+         * \param destFormat the format of the values written
+         * \param quantization if not NULL, the values are normalized, and quantization receives the mapping to get the values back
+         * \return   1 on success, 0 otherwise (buffer too small, read error, destFormat not normalizable)
+         */
+        DllExport char WINAPI VTKParser_parseAllFieldValuesAsInto(HVTKParser parser, HVTKFieldValue value, void* dest, size_t capacity, VTKValueFormat destFormat, VTKQuantization* quantization);
+
+        /**
+         * \brief  Parse the field value, computing the statistics of each component (min, max, mean, number of NaN) while decoding it
+         * \param parser the parser containing the information
+         * \param value the field value descriptor to get data from
+         * \param stats the statistics to fill (nbValuePerTuple values)
+         * \return   a pointer to the allocated memory containing the information (needs to be freed using free). NULL on error
+         */
+        DllExport void* WINAPI VTKParser_parseAllFieldValuesWithStats(HVTKParser parser, HVTKFieldValue value, VTKComponentStats* stats);
+
+        /**
+         * \brief  Parse the field value into a caller-provided buffer, computing the statistics of each component while decoding it
+         * \param parser the parser containing the information
+         * \param value the field value descriptor to get data from
+         * \param dest the buffer to fill
+         * \param capacity the size (in bytes) of dest. Needs at least format*tuple*nbValuePerTuple bytes
+         * \param stats the statistics to fill (nbValuePerTuple values)
+         * \return   1 on success, 0 otherwise (buffer too small, read error)
+         */
+        DllExport char WINAPI VTKParser_parseAllFieldValuesWithStatsInto(HVTKParser parser, HVTKFieldValue value, void* dest, size_t capacity, VTKComponentStats* stats);
+
+        /**
+         * \brief  Get the read of all the values of a field value, for VTKParser_parseArrays
+         * \param value the field value descriptor to get data from
+         * \param dest the buffer to fill. NULL == allocated by VTKParser_parseArrays (needs to be freed using free)
+         * \param capacity the size (in bytes) of dest
+         * \return   the read
+         */
+        DllExport VTKArrayRead WINAPI VTKParser_getFieldValuesRead(HVTKFieldValue value, void* dest, size_t capacity);
+
+        /**
+         * \brief  Get the read of all the unstructured grid points, for VTKParser_parseArrays. See VTKParser_getFieldValuesRead
+         * \param parser the parser containing the information
+         * \param dest the buffer to fill. NULL == allocated by VTKParser_parseArrays
+         * \param capacity the size (in bytes) of dest
+         * \return   the read
+         */
+        DllExport VTKArrayRead WINAPI VTKParser_getUnstructuredGridPointsRead(HVTKParser parser, void* dest, size_t capacity);
+
+        /**
+         * \brief  Get the read of the unstructured grid cells values, for VTKParser_parseArrays. See VTKParser_getFieldValuesRead
+         * \param parser the parser containing the information
+         * \param dest the buffer to fill. NULL == allocated by VTKParser_parseArrays
+         * \param capacity the size (in bytes) of dest
+         * \return   the read
+         */
+        DllExport VTKArrayRead WINAPI VTKParser_getUnstructuredGridCellsRead(HVTKParser parser, void* dest, size_t capacity);
+
+        /**
+         * \brief  Get the read of the unstructured grid cells types, for VTKParser_parseArrays. See VTKParser_getFieldValuesRead
+         * \param parser the parser containing the information
+         * \param dest the buffer to fill. NULL == allocated by VTKParser_parseArrays
+         * \param capacity the size (in bytes) of dest
+         * \return   the read
+         */
+        DllExport VTKArrayRead WINAPI VTKParser_getUnstructuredGridCellTypesRead(HVTKParser parser, void* dest, size_t capacity);
+
+        /**
+         * \brief  Get the read of all the structured grid points, for VTKParser_parseArrays. See VTKParser_getFieldValuesRead
+         * \param parser the parser containing the information
+         * \param dest the buffer to fill. NULL == allocated by VTKParser_parseArrays
+         * \param capacity the size (in bytes) of dest
+         * \return   the read
+         */
+        DllExport VTKArrayRead WINAPI VTKParser_getStructuredGridPointsRead(HVTKParser parser, void* dest, size_t capacity);
+
+        /**
+         * \brief  Read several arrays at once, in one forward sweep of the file (see VTKParser::parseArrays)
+         * \param parser the parser containing the information
+         * \param reads the arrays to read. Their dest (if NULL) and success fields are set
+         * \param nbReads the number of reads
+         * \return   1 if every array has been read, 0 otherwise (see the success field of each read)
+         */
+        DllExport char WINAPI VTKParser_parseArrays(HVTKParser parser, VTKArrayRead* reads, size_t nbReads);
+
+        /**
+         * \brief  Parse a range of tuples (and of components) of a field value
+         * \param parser the parser containing the information
+         * \param value the field value descriptor to get data from
+         * \param firstTuple the first tuple to read
+         * \param nbTuples the number of tuples to read
+         * \param firstComponent the first component to read in each tuple
+         * \param nbComponents the number of components to read in each tuple. 0 == up to the last component
+         * \return   allocated memory containing the nbTuples*nbComponents values. Needs to be freed (free(val)). NULL on error (out of range)
+         */
+        DllExport void* WINAPI VTKParser_parseFieldValues(HVTKParser parser, HVTKFieldValue value, uint32_t firstTuple, uint32_t nbTuples, uint32_t firstComponent, uint32_t nbComponents);
+
+        /**
+         * \brief  Parse a range of tuples (and of components) of a field value into a caller-provided buffer
+         * \param parser the parser containing the information
+         * \param value the field value descriptor to get data from
+         * \param firstTuple the first tuple to read
+         * \param nbTuples the number of tuples to read
+         * \param firstComponent the first component to read in each tuple
+         * \param nbComponents the number of components to read in each tuple. 0 == up to the last component
+         * \param dest the buffer to fill
+         * \param capacity the size (in bytes) of dest
+         * \return   1 on success, 0 otherwise (out of range, buffer too small)
+         */
+        DllExport char WINAPI VTKParser_parseFieldValuesInto(HVTKParser parser, HVTKFieldValue value, uint32_t firstTuple, uint32_t nbTuples, uint32_t firstComponent, uint32_t nbComponents,
+                                                             void* dest, size_t capacity);
+
+        /**
+         * \brief  Get the structured points descriptor of a sub-volume (size, and spacing and origin adjusted to the box and the steps)
+         * \param parser the parser containing the information
+         * \param box the sub-volume
+         * \param descriptor[out] the descriptor of the sub-volume. Can be NULL
+         * \return   1 if the box is valid, 0 otherwise (not a structured points dataset, box outside the dataset, step == 0)
+         */
+        DllExport char WINAPI VTKParser_getStructuredPointsSubVolumeDescriptor(HVTKParser parser, const VTKSubVolume* box, VTKStructuredPoints* descriptor);
+
+        /**
+         * \brief  Parse a sub-volume (optionally downsampled) of a point field value of a structured points dataset. Only the rows of the box are read
+         * \param parser the parser containing the information
+         * \param value the point field value descriptor to get data from
+         * \param box the sub-volume to read
+         * \param descriptor[out] the structured points descriptor of the values returned. Can be NULL
+         * \return   allocated memory containing the size[0]*size[1]*size[2] tuples of the sub-volume. Needs to be freed (free(val)). NULL on error
+         */
+        DllExport void* WINAPI VTKParser_parseStructuredPointsFieldValues(HVTKParser parser, HVTKFieldValue value, const VTKSubVolume* box, VTKStructuredPoints* descriptor);
+
+        /**
+         * \brief  Parse a sub-volume (optionally downsampled) of a point field value of a structured points dataset into a caller-provided buffer
+         * \param parser the parser containing the information
+         * \param value the point field value descriptor to get data from
+         * \param box the sub-volume to read
+         * \param dest the buffer to fill
+         * \param capacity the size (in bytes) of dest
+         * \param descriptor[out] the structured points descriptor of the values written. Can be NULL
+         * \return   1 on success, 0 otherwise (invalid box, not a point field value, buffer too small)
+         */
+        DllExport char WINAPI VTKParser_parseStructuredPointsFieldValuesInto(HVTKParser parser, HVTKFieldValue value, const VTKSubVolume* box, void* dest, size_t capacity,
+                                                                             VTKStructuredPoints* descriptor);
+
         /**
          * \brief  Get the cell construction descriptor (hints for allocating the correct buffer)
          * This is useful for fillUnstructuredGridCellBuffer function
@@ -173,6 +465,333 @@ namespace sereno
          */
         DllExport void WINAPI VTKParser_fillUnstructuredGridCellElementBuffer(HVTKParser parser, uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes, int32_t* buffer);
 
+        /**
+         * \brief  Get the construction descriptor of every rendering mode in one pass (cells are bucketed per mode)
+         * \param nbCells The number of cells to investigate
+         * \param cellValues The cell values array
+         * \param cellTypes the cell types array
+         * \return   the VTKMultiCellConstruction corresponding the these cells
+         */
+        DllExport VTKMultiCellConstruction WINAPI VTKParser_getMultiCellConstructionDescriptor(uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes);
+
+        /**
+         * \brief  Fill the vertex buffers of every rendering mode in one sweep
+         * \param parser The parser containing the information
+         * \param nbCells The number of cells to use
+         * \param ptValues The points values
+         * \param cellValues the cell Values
+         * \param cellTypes the cell Types
+         * \param buffers the buffer to fill per VTKGLMode (VTK_GL_NO_MODE buffers). A NULL buffer skips the cells of its mode
+         * \param destFormat the destination format for the buffers
+         */
+        DllExport void WINAPI VTKParser_fillUnstructuredGridCellBuffers(HVTKParser parser, uint32_t nbCells, void* ptValues, int32_t* cellValues, int32_t* cellTypes,
+                                                                        void** buffers, VTKValueFormat destFormat);
+
+        /**
+         * \brief  Fill the element buffers of every rendering mode in one sweep
+         * \param parser The parser containing the information
+         * \param nbCells The number of cells to use
+         * \param cellValues the cell Values
+         * \param cellTypes the cell Types
+         * \param buffers the buffer to fill per VTKGLMode (VTK_GL_NO_MODE buffers). A NULL buffer skips the cells of its mode
+         */
+        DllExport void WINAPI VTKParser_fillUnstructuredGridCellElementBuffers(HVTKParser parser, uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes, int32_t** buffers);
+
+        /**
+         * \brief  Compute a Z-order (Morton) reordering of the unstructured grid points and cells (see VTKParser::computeUnstructuredGridMortonOrder)
+         * \param parser the parser containing the information
+         * \param points the points of the grid
+         * \param nbCells the number of cells described by cellValues. 0 == reorder only the points
+         * \param cellValues the cell values. Can be NULL if nbCells == 0
+         * \param nbValues the number of values of cellValues (e.g., VTKCells::wholeSize)
+         * \param pointOrder[out] nbPoints values : the index, before reordering, of each point
+         * \param cellOrder[out] nbCells values : the index, before reordering, of each cell. Can be NULL if nbCells == 0
+         * \return 1 on success, 0 on failure (not an unstructured grid, corrupted cells)
+         */
+        DllExport char WINAPI VTKParser_computeUnstructuredGridMortonOrder(HVTKParser parser, const void* points, uint32_t nbCells, const int32_t* cellValues,
+                                                                           size_t nbValues, uint32_t* pointOrder, uint32_t* cellOrder);
+
+        /**
+         * \brief  Reorder an array of tuples (points, cell types, field values) : dest[i] = src[order[i]]
+         * \param parser the parser whose threads are used
+         * \param src the tuples to reorder
+         * \param nbTuples the number of tuples
+         * \param tupleSize the size (in bytes) of a tuple
+         * \param order the order (see VTKParser_computeUnstructuredGridMortonOrder)
+         * \param dest the buffer to fill (nbTuples*tupleSize bytes)
+         * \return 1 on success, 0 on failure (order out of range)
+         */
+        DllExport char WINAPI VTKParser_permuteTuples(HVTKParser parser, const void* src, uint32_t nbTuples, size_t tupleSize, const uint32_t* order, void* dest);
+
+        /**
+         * \brief  Reorder the cell values and remap their point indices after a reordering of the points
+         * \param parser the parser whose threads are used
+         * \param nbCells the number of cells described by cellValues
+         * \param cellValues the cell values
+         * \param nbValues the number of values of cellValues (e.g., VTKCells::wholeSize)
+         * \param nbPoints the number of points
+         * \param pointOrder the order of the points
+         * \param cellOrder the order of the cells. NULL == keep the cells order
+         * \param dest the buffer to fill, as large as cellValues
+         * \return 1 on success, 0 on failure (corrupted cells, point index out of range, pointOrder not a permutation)
+         */
+        DllExport char WINAPI VTKParser_remapUnstructuredGridCells(HVTKParser parser, uint32_t nbCells, const int32_t* cellValues, size_t nbValues, uint32_t nbPoints,
+                                                                   const uint32_t* pointOrder, const uint32_t* cellOrder, int32_t* dest);
+
+        /**
+         * \brief Get the number of indices of the cells rendered with a given mode
+         * \param parser the parser containing the information
+         * \param nbCells the number of cells to use
+         * \param cellValues the cell Values
+         * \param cellTypes the cell Types
+         * \param mode the rendering mode of the cells to take into account
+         * \return the number of indices
+         */
+        DllExport size_t WINAPI VTKParser_getUnstructuredGridCellElementBufferSize(HVTKParser parser, uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes, VTKGLMode mode);
+
+        /**
+         * \brief Fill an indexed element buffer with the cells rendered with a given mode. The indices refer to the dataset points
+         * \param parser the parser containing the information
+         * \param nbCells the number of cells to use
+         * \param cellValues the cell Values
+         * \param cellTypes the cell Types
+         * \param mode the rendering mode of the cells to write
+         * \param buffer the buffer to fill (see VTKParser_getUnstructuredGridCellElementBufferSize)
+         * \param format the format of the indices
+         * \return 1 on success, 0 if a point index cannot be represented in format
+         */
+        DllExport char WINAPI VTKParser_fillUnstructuredGridCellIndexedElementBuffer(HVTKParser parser, uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes, VTKGLMode mode,
+                                                                                     void* buffer, VTKIndexFormat format);
+
+        /**
+         * \brief Extract the boundary surface of the cells (faces of 3D cells not shared with another cell, and 2D cells) as an indexed triangle element buffer
+         * \param parser the parser containing the information
+         * \param nbCells the number of cells to use
+         * \param cellValues the cell Values
+         * \param cellTypes the cell Types
+         * \param format the format of the indices
+         * \param nbIndices[out] the number of indices returned
+         * \return allocated memory containing the indices (VTK_GL_TRIANGLES). Needs to be freed (free(val)). NULL on error
+         */
+        DllExport void* WINAPI VTKParser_extractUnstructuredGridBoundaryElementBuffer(HVTKParser parser, uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes,
+                                                                                     VTKIndexFormat format, size_t* nbIndices);
+
+        /**
+         * \brief  Parse all structured grid point (x varying fastest, then y, then z)
+         * \param parser the parser containing the information
+         * \return   allocated memory containing the nbPoints*3 values. Needs to be freed (free(val)). Use VTKParser_getStructuredGridDescriptor for the format
+         */
+        DllExport void* WINAPI VTKParser_parseAllStructuredGridPoints(HVTKParser parser);
+
+        /**
+         * \brief  Parse all structured grid point, converted into another format
+         * \param parser the parser containing the information
+         * \param destFormat the format of the returned values
+         * \return   allocated memory containing the nbPoints*3 values in destFormat. Needs to be freed (free(val)). NULL on error
+         */
+        DllExport void* WINAPI VTKParser_parseAllStructuredGridPointsAs(HVTKParser parser, VTKValueFormat destFormat);
+
+        /**
+         * \brief  Parse all structured grid point into a caller-provided buffer (no allocation)
+         * \param parser the parser containing the information
+         * \param dest the buffer to fill
+         * \param capacity the size (in bytes) of dest. Needs at least nbPoints*3*VTKValueFormatInt(format) bytes
+         * \return   1 on success, 0 otherwise (buffer too small, read error)
+         */
+        DllExport char WINAPI VTKParser_parseAllStructuredGridPointsInto(HVTKParser parser, void* dest, size_t capacity);
+
+        /**
+         * \brief  Parse all structured grid point, computing their bounding box while decoding them
+         * \param parser the parser containing the information
+         * \param bounds the statistics of the x, y and z components (3 values) to fill : min and max are the bounding box, mean is the centroid
+         * \return   allocated memory containing the point values. Needs to be freed (free(val)). NULL on error
+         */
+        DllExport void* WINAPI VTKParser_parseAllStructuredGridPointsWithStats(HVTKParser parser, VTKComponentStats* bounds);
+
+        /**
+         * \brief  Parse a range of the structured grid points
+         * \param parser the parser containing the information
+         * \param firstPoint the first point to read
+         * \param nbPoints the number of points to read
+         * \return   allocated memory containing the nbPoints*3 values. Needs to be freed (free(val)). NULL on error (out of range)
+         */
+        DllExport void* WINAPI VTKParser_parseStructuredGridPoints(HVTKParser parser, uint32_t firstPoint, uint32_t nbPoints);
+
+        /**
+         * \brief  Get the number of cells of the structured grid (implicit connectivity)
+         * \param parser the parser containing the information
+         * \return the number of cells. 0 if the dataset is not a structured grid
+         */
+        DllExport uint32_t WINAPI VTKParser_getStructuredGridNbCells(HVTKParser parser);
+
+        /**
+         * \brief  Get the type of the cells of the structured grid
+         * \param parser the parser containing the information
+         * \return VTK_CELL_HEXAHEDRON, VTK_CELL_QUAD, VTK_CELL_LINE or VTK_CELL_VERTEX depending on the number of axes having more than one point
+         */
+        DllExport VTKCellType WINAPI VTKParser_getStructuredGridCellType(HVTKParser parser);
+
+        /**
+         * \brief  Fill an element buffer with the points of a range of cells of the structured grid, generated from the grid dimensions
+         * \param parser the parser containing the information
+         * \param firstCell the first cell
+         * \param nbCells the number of cells
+         * \param buffer the buffer to fill (nbCells*VTKCellTypeInt(cellType) indices)
+         * \param format the format of the indices
+         * \return 1 on success, 0 on failure (out of range, index not representable in format)
+         */
+        DllExport char WINAPI VTKParser_fillStructuredGridCellElementBuffer(HVTKParser parser, uint32_t firstCell, uint32_t nbCells, void* buffer, VTKIndexFormat format);
+
+        /**
+         * \brief  Get the number of indices of the boundary surface of the structured grid
+         * \param parser the parser containing the information
+         * \return the number of indices
+         */
+        DllExport size_t WINAPI VTKParser_getStructuredGridBoundaryElementBufferSize(HVTKParser parser);
+
+        /**
+         * \brief  Fill an indexed triangle element buffer (VTK_GL_TRIANGLES) with the boundary surface of the structured grid
+         * \param parser the parser containing the information
+         * \param buffer the buffer to fill (see VTKParser_getStructuredGridBoundaryElementBufferSize)
+         * \param format the format of the indices
+         * \return 1 on success, 0 on failure (index not representable in format)
+         */
+        DllExport char WINAPI VTKParser_fillStructuredGridBoundaryElementBuffer(HVTKParser parser, void* buffer, VTKIndexFormat format);
+
+        /**
+         * \brief  Create a stream reading the unstructured grid cells per batch
+         * \param parser the parser containing the unstructured grid. Has to outlive the stream
+         * \param batchSize the maximum number of cells per batch
+         * \return the VTKCellStream C object newly created. Call VTKCellStream_delete at the end of this object lifetime
+         */
+        DllExport HVTKCellStream WINAPI VTKParser_newCellStream(HVTKParser parser, uint32_t batchSize);
+
+        /**
+         * \brief  Read the next batch of cells
+         * \param stream the stream to read
+         * \param nbCells[out] the number of cells read
+         * \param cellValues[out] the cells values of this batch (see VTKParser_parseAllUnstructuredGridCellsComposition). Valid until the next call
+         * \param nbValues[out] the number of cells values
+         * \param cellTypes[out] the cells types of this batch. Valid until the next call
+         * \return 1 if a batch was read, 0 if every cell was read or on error
+         */
+        DllExport char WINAPI VTKCellStream_next(HVTKCellStream stream, uint32_t* nbCells, int32_t** cellValues, uint32_t* nbValues, int32_t** cellTypes);
+
+        /**
+         * \brief  Has an error occured while reading the stream ?
+         * \param stream the stream to look at
+         * \return 1 if an error occured, 0 otherwise
+         */
+        DllExport char WINAPI VTKCellStream_hasError(HVTKCellStream stream);
+
+        /**
+         * \brief  Delete a VTKCellStream C object
+         * \param stream the stream to delete
+         */
+        DllExport void WINAPI VTKCellStream_delete(HVTKCellStream stream);
+
+        /**
+         * \brief  Build the brick pyramid file of a point field value of a structured points dataset (see VTKBrickPyramid::build)
+         * \param parser the parser containing the structured points dataset
+         * \param value the point field value to convert
+         * \param path the pyramid file path
+         * \param brickSize the number of points of a brick along each axis
+         * \return 1 on success, 0 on failure
+         */
+        DllExport char WINAPI VTKBrickPyramid_build(HVTKParser parser, HVTKFieldValue value, const char* path, uint32_t brickSize);
+
+        /**
+         * \brief  Open a brick pyramid file
+         * \param path the pyramid file path
+         * \return the VTKBrickPyramid C object newly created, NULL if the file cannot be opened. Call VTKBrickPyramid_delete at the end of this object lifetime
+         */
+        DllExport HVTKBrickPyramid WINAPI VTKBrickPyramid_open(const char* path);
+
+        /**
+         * \brief  Delete a VTKBrickPyramid C object
+         * \param pyramid the pyramid to delete
+         */
+        DllExport void WINAPI VTKBrickPyramid_delete(HVTKBrickPyramid pyramid);
+
+        /**
+         * \brief  Get the number of levels of a pyramid
+         * \param pyramid the pyramid to look at
+         * \return the number of levels
+         */
+        DllExport uint32_t WINAPI VTKBrickPyramid_getNbLevels(HVTKBrickPyramid pyramid);
+
+        /**
+         * \brief  Get a level descriptor of a pyramid
+         * \param pyramid the pyramid to look at
+         * \param level the level (0 == full resolution)
+         * \return the level descriptor, NULL if level is out of range
+         */
+        DllExport const VTKBrickLevel* WINAPI VTKBrickPyramid_getLevel(HVTKBrickPyramid pyramid, uint32_t level);
+
+        /**
+         * \brief  Get the number of points of a brick along each axis
+         * \param pyramid the pyramid to look at
+         * \return the brick size
+         */
+        DllExport uint32_t WINAPI VTKBrickPyramid_getBrickSize(HVTKBrickPyramid pyramid);
+
+        /**
+         * \brief  Get the values format of a pyramid
+         * \param pyramid the pyramid to look at
+         * \return the format of the values
+         */
+        DllExport VTKValueFormat WINAPI VTKBrickPyramid_getFormat(HVTKBrickPyramid pyramid);
+
+        /**
+         * \brief  Get the number of values per tuple of a pyramid
+         * \param pyramid the pyramid to look at
+         * \return the number of values per tuple
+         */
+        DllExport uint32_t WINAPI VTKBrickPyramid_getNbValuePerTuple(HVTKBrickPyramid pyramid);
+
+        /**
+         * \brief  Get the size of a brick
+         * \param pyramid the pyramid to look at
+         * \return the size (in bytes) of a brick
+         */
+        DllExport size_t WINAPI VTKBrickPyramid_getBrickDataSize(HVTKBrickPyramid pyramid);
+
+        /**
+         * \brief  Get the structured points descriptor of the points of a brick (padding excluded)
+         * \param pyramid the pyramid to look at
+         * \param level the level of the brick
+         * \param x the brick position along the x axis
+         * \param y the brick position along the y axis
+         * \param z the brick position along the z axis
+         * \param descriptor[out] the descriptor of the brick
+         * \return 1 on success, 0 if the brick is out of range
+         */
+        DllExport char WINAPI VTKBrickPyramid_getBrickDescriptor(HVTKBrickPyramid pyramid, uint32_t level, uint32_t x, uint32_t y, uint32_t z, VTKStructuredPoints* descriptor);
+
+        /**
+         * \brief  Get a brick without any copy
+         * \param pyramid the pyramid to look at
+         * \param level the level of the brick
+         * \param x the brick position along the x axis
+         * \param y the brick position along the y axis
+         * \param z the brick position along the z axis
+         * \return the brick values, valid until the pyramid is deleted. NULL if the brick is out of range
+         */
+        DllExport const void* WINAPI VTKBrickPyramid_getBrick(HVTKBrickPyramid pyramid, uint32_t level, uint32_t x, uint32_t y, uint32_t z);
+
+        /**
+         * \brief  Copy a brick into a caller-provided buffer
+         * \param pyramid the pyramid to look at
+         * \param level the level of the brick
+         * \param x the brick position along the x axis
+         * \param y the brick position along the y axis
+         * \param z the brick position along the z axis
+         * \param dest the buffer to fill
+         * \param capacity the size (in bytes) of dest
+         * \return 1 on success, 0 on failure (out of range, buffer too small)
+         */
+        DllExport char WINAPI VTKBrickPyramid_readBrick(HVTKBrickPyramid pyramid, uint32_t level, uint32_t x, uint32_t y, uint32_t z, void* dest, size_t capacity);
+
         /**
          * \brief  Free function calling "free"
          * \param data the data to free
@@ -47,17 +47,28 @@ extern "C" {
     {
 #endif
 
+/* \brief The format of the values. VTK_UNSIGNED_SHORT and VTK_HALF_FLOAT (IEEE 754 binary16) are only conversion formats (see VTKParser::parseAllFieldValues)*/
 #define ENUM_VTK_VALUE_FORMAT(_)   \
     _(VTK_INT            , = 0, 4) \
     _(VTK_DOUBLE         ,    , 8) \
     _(VTK_FLOAT          ,    , 4) \
     _(VTK_UNSIGNED_CHAR  ,    , 1) \
     _(VTK_CHAR           ,    , 1) \
+    _(VTK_UNSIGNED_SHORT ,    , 2) \
+    _(VTK_HALF_FLOAT     ,    , 2) \
     _(VTK_NO_VALUE_FORMAT,    , 0)
 
         VTK_DEFINE_ENUM(VTKValueFormat, ENUM_VTK_VALUE_FORMAT)
         VTK_AS_DEC_INT(VTKValueFormat, ENUM_VTK_VALUE_FORMAT)
 
+/* \brief The format of the indices of element buffers*/
+#define ENUM_VTK_INDEX_FORMAT(_)   \
+    _(VTK_INDEX_UINT16   , = 0, 2) \
+    _(VTK_INDEX_UINT32   ,    , 4)
+
+        VTK_DEFINE_ENUM(VTKIndexFormat, ENUM_VTK_INDEX_FORMAT)
+        VTK_AS_DEC_INT(VTKIndexFormat, ENUM_VTK_INDEX_FORMAT)
+
 #define ENUM_VTK_CELL_TYPE(_)                  \
     _(VTK_CELL_VERTEX              , = 1 , 1)  \
     _(VTK_CELL_POLYVERTEX          , = 2 , -1) \
@@ -66,7 +77,7 @@ extern "C" {
     _(VTK_CELL_TRIANGLE            ,     , 3)  \
     _(VTK_CELL_TRIANGLE_STRIP      ,     , -1) \
     _(VTK_CELL_POLYGON             ,     , -1) \
-    _(VTK_CELL_PIXEL               ,     , -1) \
+    _(VTK_CELL_PIXEL               ,     , 4)  \
     _(VTK_CELL_QUAD                ,     , 4)  \
     _(VTK_CELL_TETRA               ,     , 4)  \
     _(VTK_CELL_VOXEL               ,     , 8)  \
@@ -113,6 +124,7 @@ extern "C" {
             VTK_GL_TRIANGLE_STIP,
             VTK_GL_LINE_STRIP,
             VTK_GL_POINTS,
+            VTK_GL_LINES,
             VTK_GL_NO_MODE
         };
 
@@ -149,6 +161,17 @@ extern "C" {
             char      error;   /*!< Tells if an error occured (0 == false, 1 == true)*/
         };
 
+        /** \brief The VTKCellConstruction information of every rendering mode, computed in one pass*/
+        struct VTKMultiCellConstruction
+        {
+            uint32_t size[VTK_GL_NO_MODE];    /*!< The size of the buffer per VTKGLMode*/
+            uint32_t offset[VTK_GL_NO_MODE];  /*!< The position of each mode if every mode is stored in the same buffer (sum of the previous sizes)*/
+            uint32_t nbCells[VTK_GL_NO_MODE]; /*!< The number of cells per VTKGLMode*/
+            uint32_t nbParsedCells;           /*!< The number of cell parsed*/
+            uint32_t next;                    /*!< Tells the offset to apply for advancing in the cells array*/
+            char     error;                   /*!< Tells if an error occured (0 == false, 1 == true)*/
+        };
+
         /* \brief VTK Grid structure */
         struct VTKGrid
         {
@@ -172,6 +195,54 @@ extern "C" {
             double   origin[3];  /*!< The origin (offset) of the points*/
         };
 
+        /** \brief  A box of points of a structured points dataset, read with a step (e.g., for downsampled previews) */
+        struct VTKSubVolume
+        {
+            uint32_t first[3]; /*!< The first point of the box along each axis*/
+            uint32_t last[3];  /*!< The last point (included) of the box along each axis*/
+            uint32_t step[3];  /*!< The step between two points read along each axis (1 == every point)*/
+        };
+
+        /** \brief  A level of a brick pyramid (see VTKBrickPyramid) */
+        struct VTKBrickLevel
+        {
+            VTKStructuredPoints descriptor;  /*!< The points of this level : the level 0 points taken every 2^level points (size, spacing and origin adjusted)*/
+            uint32_t            nbBricks[3]; /*!< The number of bricks along each axis*/
+            uint64_t            offset;      /*!< The offset of the first brick of this level in the pyramid file*/
+        };
+
+        /** \brief  Linear mapping of normalized values (see VTKParser::parseAllFieldValues) : value = scale*normalized + offset */
+        struct VTKQuantization
+        {
+            double scale;  /*!< The value of one normalized step*/
+            double offset; /*!< The value of the normalized value 0 (the minimum value)*/
+        };
+
+        /** \brief  Statistics of one component of an array, computed while decoding it. NaN and infinite values are not part of min, max and mean */
+        struct VTKComponentStats
+        {
+            double   min;   /*!< The minimum value (0 if there is no finite value)*/
+            double   max;   /*!< The maximum value (0 if there is no finite value)*/
+            double   mean;  /*!< The mean value (0 if there is no finite value)*/
+            uint64_t nbNaN; /*!< The number of NaN values*/
+        };
+
+        /** \brief  An array read by a batch read (see VTKParser::parseArrays) */
+        struct VTKArrayRead
+        {
+            size_t             offset;       /*!< The offset of the array in the file*/
+            size_t             nbValues;     /*!< The number of values to read*/
+            VTKValueFormat     format;       /*!< The values format*/
+            VTKValueFormat     destFormat;   /*!< The format of the values written in dest. VTK_NO_VALUE_FORMAT == format*/
+            void*              dest;         /*!< The buffer to fill. NULL == allocated by the read (needs to be freed using free)*/
+            size_t             capacity;     /*!< The size (in bytes) of dest. Needs at least nbValues*VTKValueFormatInt(destFormat) bytes. Not used if dest == NULL*/
+            char               normalize;    /*!< 1 == normalize the values onto the whole range of destFormat (VTK_UNSIGNED_CHAR or VTK_UNSIGNED_SHORT), 0 otherwise*/
+            char               success;      /*!< Set by the read : 1 if the array has been read, 0 otherwise*/
+            VTKQuantization    quantization; /*!< Set by the read of normalized values : the mapping to get the values back*/
+            uint32_t           nbComponents; /*!< The number of components per tuple (e.g., 3 for points). Used by stats*/
+            VTKComponentStats* stats;        /*!< If not NULL, receives the statistics of each of the nbComponents components (of the values read, before any conversion)*/
+        };
+
         inline bool operator==(const VTKStructuredPoints& p1, const VTKStructuredPoints& p2)
         {
             for(uint8_t i = 0; i < 3; i++)
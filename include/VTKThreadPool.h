@@ -0,0 +1,91 @@
+#ifndef  VTKTHREADPOOL_INC
+#define  VTKTHREADPOOL_INC
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+#include "VTKParser_C_type.h"
+
+namespace sereno
+{
+    /** \brief  Pool of worker threads running data-parallel loops.
+     * The calling thread always takes part to its own loop, so a pool of N threads spawns N-1 workers.
+     * Workers are spawned at the first parallel loop. parallelFor can be called concurrently (and recursively) from several threads */
+    struct DllExport VTKThreadPool
+    {
+        public:
+            /** \brief  The function running a sub range [begin, end) of a loop */
+            typedef std::function<void(size_t begin, size_t end)> RangeFunction;
+
+            /* \brief Constructor
+             * \param nbThreads the number of threads taking part to a loop (caller included). 0 == the number of hardware threads */
+            VTKThreadPool(uint32_t nbThreads = 0);
+
+            /* \brief Destructor. Wait for the workers to finish */
+            ~VTKThreadPool();
+
+            /* \brief Get the number of threads taking part to a loop (caller included)
+             * \return the number of threads */
+            uint32_t getNbThreads() const {return m_nbThreads;}
+
+            /**
+             * \brief  Run func over [0, n) split in chunks of grain elements, and wait for all the chunks to be processed
+             * \param n the number of elements
+             * \param grain the number of elements per chunk (the last chunk may be smaller)
+             * \param func the function to call per chunk. If it throws, the remaining chunks are still processed and the first exception is rethrown once they are done
+             */
+            void parallelFor(size_t n, size_t grain, const RangeFunction& func);
+
+            /**
+             * \brief  Get the number of hardware threads of this computer
+             * \return the number of hardware threads (at least 1)
+             */
+            static uint32_t getHardwareNbThreads();
+        private:
+            VTKThreadPool(const VTKThreadPool& copy);
+            VTKThreadPool& operator=(const VTKThreadPool& copy);
+
+            /** \brief  A loop being processed */
+            struct Job
+            {
+                const RangeFunction* func;       /*!< The function to call per chunk*/
+                size_t               n;          /*!< The number of elements*/
+                size_t               grain;      /*!< The number of elements per chunk*/
+                size_t               nbChunks;   /*!< The number of chunks*/
+                size_t               nextChunk;  /*!< The next chunk to process*/
+                size_t               doneChunks; /*!< The number of processed chunks*/
+                std::exception_ptr   exception;  /*!< The first exception thrown by func, if any*/
+            };
+
+            /* \brief Take the next chunk of a job. Needs m_mutex to be locked
+             * \param job the job to look at
+             * \param chunk[out] the chunk taken
+             * \return true if a chunk was taken, false if every chunk is already taken */
+            static bool takeChunk(Job* job, size_t& chunk);
+
+            /* \brief Process one chunk of a job and signal its completion. Exceptions thrown by the job function are stored in the job
+             * \param job the job to process
+             * \param chunk the chunk to process */
+            void runChunk(Job* job, size_t chunk);
+
+            /* \brief The worker threads main loop */
+            void workerLoop();
+
+            uint32_t                 m_nbThreads;   /*!< The number of threads per loop (caller included)*/
+            std::vector<std::thread> m_workers;     /*!< The worker threads*/
+            std::deque<Job*>         m_jobs;        /*!< The loops having chunks to distribute*/
+            std::mutex               m_mutex;       /*!< Protect the jobs and their counters*/
+            std::condition_variable  m_jobCond;     /*!< Signaled when a job is added or when stopping*/
+            std::condition_variable  m_doneCond;    /*!< Signaled when a job is completed*/
+            bool                     m_stop = false;/*!< Should the workers stop ?*/
+    };
+}
+
+#endif
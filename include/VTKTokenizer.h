@@ -0,0 +1,155 @@
+#ifndef  VTKTOKENIZER_INC
+#define  VTKTOKENIZER_INC
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "VTKParser_C_type.h"
+
+namespace sereno
+{
+    /** \brief  A token : a non-owning view on a sequence of characters of the parsed buffer */
+    struct VTKToken
+    {
+        const char* str  = NULL; /*!< The first character*/
+        size_t      size = 0;    /*!< The number of characters*/
+
+        /** \brief  Compare this token with a keyword
+         * \param keyword the NULL-terminated keyword
+         * \return true if both contain the same characters */
+        bool operator==(const char* keyword) const
+        {
+            return strncmp(str, keyword, size) == 0 && keyword[size] == '\0';
+        }
+
+        /** \brief  Compare this token with a keyword
+         * \param keyword the NULL-terminated keyword
+         * \return false if both contain the same characters */
+        bool operator!=(const char* keyword) const {return !(*this == keyword);}
+
+        /** \brief  Get a copy of this token
+         * \return the token as a string */
+        std::string toString() const {return std::string(str, size);}
+    };
+
+    /**
+     * \brief  Parse an unsigned integer from [first, last). Locale independent, no allocation
+     * \param first the first character
+     * \param last the character after the last one
+     * \param value[out] the value parsed. Unchanged on failure
+     * \return the pointer to the first character not parsed, NULL on failure (no digit, overflow)
+     */
+    DllExport const char* VTKFromChars(const char* first, const char* last, uint32_t& value);
+
+    /**
+     * \brief  Parse a signed integer from [first, last). Locale independent, no allocation
+     * \param first the first character
+     * \param last the character after the last one
+     * \param value[out] the value parsed. Unchanged on failure
+     * \return the pointer to the first character not parsed, NULL on failure (no digit, overflow)
+     */
+    DllExport const char* VTKFromChars(const char* first, const char* last, int32_t& value);
+
+    /**
+     * \brief  Parse a floating point value ([+-]digits[.digits][(e|E)[+-]digits], nan or inf) from [first, last). Locale independent.
+     * Values with at most 15 significant digits and a small exponent (the usual case) are converted exactly without allocation
+     * \param first the first character
+     * \param last the character after the last one
+     * \param value[out] the value parsed. Unchanged on failure
+     * \return the pointer to the first character not parsed, NULL on failure
+     */
+    DllExport const char* VTKFromChars(const char* first, const char* last, double& value);
+
+    /**
+     * \brief  Parse a floating point value. See VTKFromChars(const char*, const char*, double&)
+     * \param first the first character
+     * \param last the character after the last one
+     * \param value[out] the value parsed. Unchanged on failure
+     * \return the pointer to the first character not parsed, NULL on failure
+     */
+    DllExport const char* VTKFromChars(const char* first, const char* last, float& value);
+
+    /**
+     * \brief  Parse a whole token as a number
+     * \param token the token to parse
+     * \param value[out] the value parsed
+     * \return true if the whole token is a valid number, false otherwise
+     */
+    template <typename T>
+    inline bool VTKParseToken(const VTKToken& token, T& value)
+    {
+        return VTKFromChars(token.str, token.str+token.size, value) == token.str+token.size && token.size > 0;
+    }
+
+    /** \brief  Line based tokenizer of the legacy VTK grammar. Works directly on a memory buffer (e.g., a mapped file) without any allocation.
+     * Lines are separated by '\n', tokens by spaces, tabulations or '\r' */
+    struct DllExport VTKTokenizer
+    {
+        public:
+            /* \brief Constructor
+             * \param data the buffer to tokenize
+             * \param size the buffer size
+             * \param cursor the position of the first line to read */
+            VTKTokenizer(const uint8_t* data, size_t size, size_t cursor = 0) : m_data((const char*)data), m_size(size), m_cursor(cursor)
+            {}
+
+            /* \brief Go to the next line.
+             * \return false on EOF, true otherwise */
+            bool nextLine();
+
+            /* \brief Get the next token of the current line
+             * \param token[out] the token read
+             * \return false if no more token is available in the current line, true otherwise */
+            bool nextToken(VTKToken& token);
+
+            /* \brief Read the next token of the current line and compare it with a keyword
+             * \param keyword the expected keyword
+             * \return true if the next token is keyword, false otherwise */
+            bool nextKeyword(const char* keyword);
+
+            /* \brief Read the next token of the current line as a number
+             * \param value[out] the value read
+             * \return true on success, false if no more token or if it is not a valid number */
+            template <typename T>
+            bool nextNumber(T& value)
+            {
+                VTKToken token;
+                return nextToken(token) && VTKParseToken(token, value);
+            }
+
+            /* \brief Is the rest of the current line empty (only separators) ?
+             * \return true if no more token is available in the current line */
+            bool isLineEnd();
+
+            /* \brief Get the current line
+             * \return the whole current line, without its '\n' */
+            VTKToken getLine() const {VTKToken t; t.str = m_lineStart; t.size = m_lineEnd-m_lineStart; return t;}
+
+            /* \brief Skip bytes in the buffer from the cursor (i.e., the beginning of the next line)
+             * \param size the number of bytes to skip
+             * \return false if the buffer ends before, true otherwise */
+            bool skipBytes(size_t size);
+
+            /* \brief Skip the character pointed by the cursor if it is a '\n' */
+            void skipNewLine() {if(m_cursor < m_size && m_data[m_cursor] == '\n') m_cursor++;}
+
+            /* \brief Get the cursor, i.e., the position of the next line in the buffer
+             * \return the position in the buffer */
+            size_t getCursor() const {return m_cursor;}
+
+            /* \brief Set the cursor, i.e., the position of the next line in the buffer
+             * \param cursor the new position */
+            void setCursor(size_t cursor) {m_cursor = cursor;}
+        private:
+            const char* m_data;              /*!< The buffer*/
+            size_t      m_size;              /*!< The buffer size*/
+            size_t      m_cursor;            /*!< The next line position*/
+            const char* m_lineStart  = NULL; /*!< The beginning of the current line*/
+            const char* m_lineCursor = NULL; /*!< The not yet tokenized part of the current line*/
+            const char* m_lineEnd    = NULL; /*!< The end of the current line*/
+    };
+}
+
+#endif
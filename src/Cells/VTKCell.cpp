@@ -0,0 +1,33 @@
+#include "Cells/VTKCell.h"
+#include "Cells/VTKWedge.h"
+#include "Cells/VTKLinearCells.h"
+
+namespace sereno
+{
+    /** \brief  The cells virtual tables, indexed by VTKCellType */
+    static const VTKCellVT* const VTK_CELL_VT[] =
+    {
+        NULL,
+        &vtkVertex,
+        &vtkPolyVertex,
+        &vtkLine,
+        &vtkPolyLine,
+        &vtkTriangle,
+        &vtkTriangleStrip,
+        &vtkPolygon,
+        &vtkPixel,
+        &vtkQuad,
+        &vtkTetra,
+        &vtkVoxel,
+        &vtkHexahedron,
+        &vtkWedge,
+        &vtkPyramid
+    };
+
+    const VTKCellVT* VTKCell_getVT(int32_t type)
+    {
+        if(type < 0 || type >= (int32_t)(sizeof(VTK_CELL_VT)/sizeof(VTK_CELL_VT[0])))
+            return NULL;
+        return VTK_CELL_VT[type];
+    }
+}
@@ -0,0 +1,40 @@
+#include "Cells/VTKCellFaces.h"
+
+namespace sereno
+{
+    /* Same point ordering and orientation as the tables of VTKLinearCells.cpp and VTKWedge.cpp*/
+
+    static const VTKCellFaces VTK_TETRA_FACES      = {4, {3, 3, 3, 3},
+                                                      {{0, 1, 3}, {1, 2, 3}, {2, 0, 3}, {0, 2, 1}}};
+
+    static const VTKCellFaces VTK_VOXEL_FACES      = {6, {4, 4, 4, 4, 4, 4},
+                                                      {{0, 4, 6, 2}, {1, 3, 7, 5}, {0, 1, 5, 4}, {2, 6, 7, 3}, {0, 2, 3, 1}, {4, 5, 7, 6}}};
+
+    static const VTKCellFaces VTK_HEXAHEDRON_FACES = {6, {4, 4, 4, 4, 4, 4},
+                                                      {{0, 4, 7, 3}, {1, 2, 6, 5}, {0, 1, 5, 4}, {3, 7, 6, 2}, {0, 3, 2, 1}, {4, 5, 6, 7}}};
+
+    static const VTKCellFaces VTK_WEDGE_FACES      = {5, {3, 3, 4, 4, 4},
+                                                      {{0, 1, 2}, {3, 5, 4}, {0, 3, 4, 1}, {1, 4, 5, 2}, {2, 5, 3, 0}}};
+
+    static const VTKCellFaces VTK_PYRAMID_FACES    = {5, {4, 3, 3, 3, 3},
+                                                      {{0, 3, 2, 1}, {0, 1, 4}, {1, 2, 4}, {2, 3, 4}, {3, 0, 4}}};
+
+    const VTKCellFaces* VTKCell_getFaces(int32_t type)
+    {
+        switch(type)
+        {
+            case VTK_CELL_TETRA:
+                return &VTK_TETRA_FACES;
+            case VTK_CELL_VOXEL:
+                return &VTK_VOXEL_FACES;
+            case VTK_CELL_HEXAHEDRON:
+                return &VTK_HEXAHEDRON_FACES;
+            case VTK_CELL_WEDGE:
+                return &VTK_WEDGE_FACES;
+            case VTK_CELL_PYRAMID:
+                return &VTK_PYRAMID_FACES;
+            default:
+                return NULL;
+        }
+    }
+}
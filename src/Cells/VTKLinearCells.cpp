@@ -0,0 +1,108 @@
+#include "Cells/VTKLinearCells.h"
+#include "Cells/VTKTableCell.h"
+
+namespace sereno
+{
+    /*----------------------------------------------------------------------------*/
+    /*---------------------Cells having a fixed number of points------------------*/
+    /*----------------------------------------------------------------------------*/
+
+    /* The faces of the 3D cells follow the VTK point ordering and are oriented outward. Quads (a, b, c, d) are split in (a, b, c) and (a, c, d)*/
+
+    static constexpr uint8_t VTK_VERTEX_TABLE[]   = {0};
+    static constexpr uint8_t VTK_LINE_TABLE[]     = {0, 1};
+    static constexpr uint8_t VTK_TRIANGLE_TABLE[] = {0, 1, 2};
+    static constexpr uint8_t VTK_PIXEL_TABLE[]    = {0, 1, 3,  0, 3, 2};
+    static constexpr uint8_t VTK_QUAD_TABLE[]     = {0, 1, 2,  0, 2, 3};
+
+    static constexpr uint8_t VTK_TETRA_TABLE[]    = {0, 1, 3,  1, 2, 3,  2, 0, 3,  0, 2, 1};
+
+    static constexpr uint8_t VTK_VOXEL_TABLE[]    = {0, 4, 6,  0, 6, 2,  //-X
+                                                     1, 3, 7,  1, 7, 5,  //+X
+                                                     0, 1, 5,  0, 5, 4,  //-Y
+                                                     2, 6, 7,  2, 7, 3,  //+Y
+                                                     0, 2, 3,  0, 3, 1,  //-Z
+                                                     4, 5, 7,  4, 7, 6}; //+Z
+
+    static constexpr uint8_t VTK_HEXAHEDRON_TABLE[] = {0, 4, 7,  0, 7, 3,
+                                                       1, 2, 6,  1, 6, 5,
+                                                       0, 1, 5,  0, 5, 4,
+                                                       3, 7, 6,  3, 6, 2,
+                                                       0, 3, 2,  0, 2, 1,
+                                                       4, 5, 6,  4, 6, 7};
+
+    static constexpr uint8_t VTK_PYRAMID_TABLE[]  = {0, 3, 2,  0, 2, 1,  //Base
+                                                     0, 1, 4,  1, 2, 4,  2, 3, 4,  3, 0, 4};
+
+    const VTKCellVT vtkVertex     = VTK_TABLE_CELL_VT(VTK_VERTEX_TABLE,     VTK_GL_POINTS,    1);
+    const VTKCellVT vtkLine       = VTK_TABLE_CELL_VT(VTK_LINE_TABLE,       VTK_GL_LINES,     2);
+    const VTKCellVT vtkTriangle   = VTK_TABLE_CELL_VT(VTK_TRIANGLE_TABLE,   VTK_GL_TRIANGLES, 3);
+    const VTKCellVT vtkPixel      = VTK_TABLE_CELL_VT(VTK_PIXEL_TABLE,      VTK_GL_TRIANGLES, 4);
+    const VTKCellVT vtkQuad       = VTK_TABLE_CELL_VT(VTK_QUAD_TABLE,       VTK_GL_TRIANGLES, 4);
+    const VTKCellVT vtkTetra      = VTK_TABLE_CELL_VT(VTK_TETRA_TABLE,      VTK_GL_TRIANGLES, 4);
+    const VTKCellVT vtkVoxel      = VTK_TABLE_CELL_VT(VTK_VOXEL_TABLE,      VTK_GL_TRIANGLES, 8);
+    const VTKCellVT vtkHexahedron = VTK_TABLE_CELL_VT(VTK_HEXAHEDRON_TABLE, VTK_GL_TRIANGLES, 8);
+    const VTKCellVT vtkPyramid    = VTK_TABLE_CELL_VT(VTK_PYRAMID_TABLE,    VTK_GL_TRIANGLES, 5);
+
+    /*----------------------------------------------------------------------------*/
+    /*--------------------Cells having a variable number of points----------------*/
+    /*----------------------------------------------------------------------------*/
+
+    /* Each cell defines the number of vertices written for n points, and the point written at the vertex j*/
+
+    static uint32_t VTKPolyVertex_size(int32_t n) {return (n > 0 ? n : 0);}
+    static uint32_t VTKPolyVertex_index(uint32_t j) {return j;}
+
+    static uint32_t VTKPolyLine_size(int32_t n) {return (n >= 2 ? 2*(n-1) : 0);}
+    static uint32_t VTKPolyLine_index(uint32_t j) {return j/2 + j%2;}
+
+    /* Every odd triangle of a strip is flipped to keep the orientation*/
+    static uint32_t VTKTriangleStrip_size(int32_t n) {return (n >= 3 ? 3*(n-2) : 0);}
+    static uint32_t VTKTriangleStrip_index(uint32_t j)
+    {
+        uint32_t t = j/3, k = j%3;
+        if(t%2 == 1 && k < 2)
+            return t + 1 - k;
+        return t + k;
+    }
+
+    /* Polygons are rendered as fans (convex polygons)*/
+    static uint32_t VTKPolygon_size(int32_t n) {return (n >= 3 ? 3*(n-2) : 0);}
+    static uint32_t VTKPolygon_index(uint32_t j) {return (j%3 == 0 ? 0 : j/3 + j%3);}
+
+    template <uint32_t (*sizeFunc)(int32_t), uint32_t (*indexFunc)(uint32_t)>
+    struct VTKVariableCellLayout
+    {
+        static uint32_t nbVertices(int32_t nbPoints) {return sizeFunc(nbPoints);}
+        static uint32_t index(uint32_t j) {return indexFunc(j);}
+    };
+
+    template <uint32_t (*size)(int32_t), uint32_t (*index)(uint32_t)>
+    static void VTKVariableCell_fillElementBuffer(int32_t* cellPts, int32_t* buffer)
+    {
+        uint32_t n = size(cellPts[0]);
+        for(uint32_t j = 0; j < n; j++)
+            buffer[j] = cellPts[1+index(j)];
+    }
+
+    template <uint32_t (*size)(int32_t)>
+    static uint32_t VTKVariableCell_sizeBuffer(int32_t* cellPts)
+    {
+        return size(cellPts[0]);
+    }
+
+#define VTK_VARIABLE_CELL_VT(name, mode)                                           \
+    {VTKCell_fillBuffer<VTKVariableCellLayout<name##_size, name##_index>>,          \
+     VTKVariableCell_fillElementBuffer<name##_size, name##_index>,                 \
+     VTKVariableCell_sizeBuffer<name##_size>,                                      \
+     VTKTableCell_getMode<mode>,                                                   \
+     VTKTableCell_nbPoints<-1>,                                                    \
+     VTK_CELL_FILLBUFFERS(VTKVariableCellLayout<name##_size, name##_index>)}
+
+    const VTKCellVT vtkPolyVertex    = VTK_VARIABLE_CELL_VT(VTKPolyVertex,    VTK_GL_POINTS);
+    const VTKCellVT vtkPolyLine      = VTK_VARIABLE_CELL_VT(VTKPolyLine,      VTK_GL_LINES);
+    const VTKCellVT vtkTriangleStrip = VTK_VARIABLE_CELL_VT(VTKTriangleStrip, VTK_GL_TRIANGLES);
+    const VTKCellVT vtkPolygon       = VTK_VARIABLE_CELL_VT(VTKPolygon,       VTK_GL_TRIANGLES);
+
+#undef VTK_VARIABLE_CELL_VT
+}
@@ -0,0 +1,439 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#ifdef WIN32
+#include <malloc.h>
+#include <Windows.h>
+#else
+#include <unistd.h>
+#endif
+#ifdef VTK_HAVE_LIBURING
+#include <liburing.h>
+#endif
+
+#include "VTKAsyncLoader.h"
+#include "VTKParser.h"
+#include "VTKByteSwap.h"
+
+namespace sereno
+{
+    /** \brief  Alignment (in bytes) of the reads and of the read buffers */
+    static const size_t VTK_ASYNC_ALIGNMENT = 4096;
+
+    /** \brief  Minimum size (in bytes) of the reads */
+    static const size_t VTK_ASYNC_MIN_BLOCK_SIZE = 64*1024;
+
+    /** \brief  Number of read buffers : one being read while the other is decoded */
+    static const uint32_t VTK_ASYNC_NB_BUFFERS = 2;
+
+    /** \brief  Size (in bytes) of the chunks of a block decoded by one thread of the parser thread pool */
+    static const size_t VTK_ASYNC_DECODE_CHUNK_SIZE = 128*1024;
+
+    /** \brief  Buffer index of the blocks not read from the file */
+    static const uint32_t VTK_ASYNC_NO_BUFFER = (uint32_t)-1;
+
+#ifdef WIN32
+    static bool readFileAt(void* file, void* dest, size_t size, uint64_t offset)
+    {
+        uint8_t* data = (uint8_t*)dest;
+        while(size > 0)
+        {
+            OVERLAPPED overlapped;
+            memset(&overlapped, 0, sizeof(overlapped));
+            overlapped.Offset     = (DWORD)offset;
+            overlapped.OffsetHigh = (DWORD)(offset >> 32);
+
+            DWORD toRead = (DWORD)std::min<size_t>(size, 1u << 30);
+            DWORD nbRead = 0;
+            if(!ReadFile((HANDLE)file, data, toRead, &nbRead, &overlapped) || nbRead == 0)
+                return false;
+            data   += nbRead;
+            size   -= nbRead;
+            offset += nbRead;
+        }
+        return true;
+    }
+#else
+    static bool readFileAt(int file, void* dest, size_t size, uint64_t offset)
+    {
+        uint8_t* data = (uint8_t*)dest;
+        while(size > 0)
+        {
+            ssize_t nbRead = pread(file, data, size, offset);
+            if(nbRead < 0 && errno == EINTR)
+                continue;
+            if(nbRead <= 0)
+                return false;
+            data   += nbRead;
+            size   -= nbRead;
+            offset += nbRead;
+        }
+        return true;
+    }
+#endif
+
+    static uint8_t* allocAligned(size_t size)
+    {
+#ifdef WIN32
+        return (uint8_t*)_aligned_malloc(size, VTK_ASYNC_ALIGNMENT);
+#else
+        void* data = NULL;
+        if(posix_memalign(&data, VTK_ASYNC_ALIGNMENT, size) != 0)
+            return NULL;
+        return (uint8_t*)data;
+#endif
+    }
+
+    static void freeAligned(uint8_t* data)
+    {
+#ifdef WIN32
+        _aligned_free(data);
+#else
+        free(data);
+#endif
+    }
+
+    VTKAsyncLoader::VTKAsyncLoader(const VTKParser& parser, size_t blockSize) : m_parser(parser)
+    {
+        m_blockSize = (std::max(blockSize, VTK_ASYNC_MIN_BLOCK_SIZE) + VTK_ASYNC_ALIGNMENT - 1) / VTK_ASYNC_ALIGNMENT * VTK_ASYNC_ALIGNMENT;
+
+        //Arrays are read from the file only when it is mapped as is (no ASCII file)
+        if(parser.isDataMapped())
+        {
+#ifdef WIN32
+            HANDLE file = CreateFileA(parser.getPath().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+            m_file = (file == INVALID_HANDLE_VALUE ? NULL : (void*)file);
+#else
+            m_file = open(parser.getPath().c_str(), O_RDONLY);
+#ifdef POSIX_FADV_SEQUENTIAL
+            if(m_file >= 0)
+                posix_fadvise(m_file, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+#endif
+        }
+
+        for(uint32_t i = 0; i < VTK_ASYNC_NB_BUFFERS; i++)
+        {
+            uint8_t* buffer = allocAligned(m_blockSize);
+            if(buffer == NULL)
+                break;
+            m_buffers.push_back(buffer);
+            m_freeBuffers.push_back(i);
+        }
+
+#ifdef VTK_HAVE_LIBURING
+        //Fall back on pread if io_uring is not supported by the kernel
+        struct io_uring* ring = new struct io_uring;
+        if(io_uring_queue_init(VTK_ASYNC_NB_BUFFERS, ring, 0) == 0)
+            m_ring = ring;
+        else
+            delete ring;
+#endif
+
+        m_reader  = std::thread(&VTKAsyncLoader::readLoop, this);
+        m_decoder = std::thread(&VTKAsyncLoader::decodeLoop, this);
+    }
+
+    VTKAsyncLoader::~VTKAsyncLoader()
+    {
+        wait();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_readCond.notify_all();
+        m_decodeCond.notify_all();
+        m_reader.join();
+        m_decoder.join();
+
+#ifdef VTK_HAVE_LIBURING
+        if(m_ring)
+        {
+            io_uring_queue_exit((struct io_uring*)m_ring);
+            delete (struct io_uring*)m_ring;
+        }
+#endif
+        for(uint8_t* buffer : m_buffers)
+            freeAligned(buffer);
+
+        if(isOpen())
+        {
+#ifdef WIN32
+            CloseHandle((HANDLE)m_file);
+#else
+            close(m_file);
+#endif
+        }
+    }
+
+    bool VTKAsyncLoader::isOpen() const
+    {
+#ifdef WIN32
+        return m_file != NULL;
+#else
+        return m_file >= 0;
+#endif
+    }
+
+    std::future<bool> VTKAsyncLoader::load(size_t offset, size_t nbValues, VTKValueFormat format, void* dest, size_t capacity,
+                                           const CompletionFunction& onCompletion)
+    {
+        std::shared_ptr<Request> request = std::make_shared<Request>();
+        request->offset       = offset;
+        request->nbValues     = nbValues;
+        request->format       = format;
+        request->dest         = (uint8_t*)dest;
+        request->onCompletion = onCompletion;
+
+        size_t sizeFormat = VTKValueFormatInt(format);
+        request->success  = dest != NULL && sizeFormat != 0 && capacity/sizeFormat >= nbValues &&
+                            offset <= m_parser.m_dataSize && (m_parser.m_dataSize - offset)/sizeFormat >= nbValues;
+
+        //Invalid, empty and in-memory arrays are not read from the file. Without file (or buffers), the memory mapping is used
+        request->inMemory = !request->success || nbValues == 0 || !isOpen() || m_buffers.empty() ||
+                            m_parser.getCachedValues(offset, nbValues*sizeFormat) != NULL;
+
+        std::future<bool> future = request->promise.get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_requests.push_back(request);
+            m_nbPending++;
+        }
+        m_readCond.notify_one();
+        return future;
+    }
+
+    std::future<bool> VTKAsyncLoader::loadUnstructuredGridPoints(void* dest, size_t capacity, const CompletionFunction& onCompletion)
+    {
+        const VTKPointPositions& pos = m_parser.m_unstrGrid.ptsPos;
+        return load(pos.offset, 3*(size_t)pos.nbPoints, pos.format, dest, capacity, onCompletion);
+    }
+
+    std::future<bool> VTKAsyncLoader::loadUnstructuredGridCells(int32_t* dest, size_t capacity, const CompletionFunction& onCompletion)
+    {
+        const VTKCells& cells = m_parser.m_unstrGrid.cells;
+        return load(cells.offset, cells.wholeSize, VTK_INT, dest, capacity*sizeof(int32_t), onCompletion);
+    }
+
+    std::future<bool> VTKAsyncLoader::loadUnstructuredGridCellTypes(int32_t* dest, size_t capacity, const CompletionFunction& onCompletion)
+    {
+        const VTKCellTypes& types = m_parser.m_unstrGrid.cellTypes;
+        return load(types.offset, types.nbCells, VTK_INT, dest, capacity*sizeof(int32_t), onCompletion);
+    }
+
+    std::future<bool> VTKAsyncLoader::loadStructuredGridPoints(void* dest, size_t capacity, const CompletionFunction& onCompletion)
+    {
+        const VTKPointPositions& pos = m_parser.m_grid.ptsPos;
+        return load(pos.offset, 3*(size_t)pos.nbPoints, pos.format, dest, capacity, onCompletion);
+    }
+
+    std::future<bool> VTKAsyncLoader::loadFieldValues(const VTKFieldValue* fieldData, void* dest, size_t capacity, const CompletionFunction& onCompletion)
+    {
+        return load(fieldData->offset, (size_t)fieldData->nbTuples*fieldData->nbValuePerTuple, fieldData->format, dest, capacity, onCompletion);
+    }
+
+    void VTKAsyncLoader::wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_doneCond.wait(lock, [this]{return m_nbPending == 0;});
+    }
+
+    void VTKAsyncLoader::complete(Request& request)
+    {
+        request.promise.set_value(request.success);
+        if(request.onCompletion)
+            request.onCompletion(request.success);
+    }
+
+    void VTKAsyncLoader::readLoop()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while(true)
+        {
+            m_readCond.wait(lock, [this]{return m_stop || (!m_requests.empty() && (m_requests.front()->inMemory || !m_freeBuffers.empty()));});
+            if(m_requests.empty())
+                return;
+
+            //Split the first requests in blocks, as long as there are free buffers
+            std::vector<Block> blocks;
+            while(!m_requests.empty())
+            {
+                std::shared_ptr<Request> request = m_requests.front();
+                if(request->inMemory)
+                {
+                    //Keep the order of the requests
+                    if(!blocks.empty())
+                        break;
+
+                    Block block;
+                    block.request    = request;
+                    block.firstValue = 0;
+                    block.nbValues   = request->nbValues;
+                    block.fileOffset = 0;
+                    block.readSize   = 0;
+                    block.head       = 0;
+                    block.buffer     = VTK_ASYNC_NO_BUFFER;
+                    block.valid      = true;
+                    block.last       = true;
+                    m_blocks.push_back(block);
+                    m_requests.pop_front();
+                    m_decodeCond.notify_one();
+                    continue;
+                }
+
+                if(m_freeBuffers.empty())
+                    break;
+
+                //Start the read at an aligned offset, and end it on a value boundary
+                size_t   sizeFormat = VTKValueFormatInt(request->format);
+                uint64_t start      = request->offset + m_nextValue*sizeFormat;
+                uint64_t aligned    = start / VTK_ASYNC_ALIGNMENT * VTK_ASYNC_ALIGNMENT;
+                size_t   nbValues   = std::min<size_t>(request->nbValues - m_nextValue, (aligned + m_blockSize - start)/sizeFormat);
+
+                Block block;
+                block.request    = request;
+                block.firstValue = m_nextValue;
+                block.nbValues   = nbValues;
+                block.fileOffset = aligned;
+                block.head       = start - aligned;
+                block.readSize   = block.head + nbValues*sizeFormat;
+                block.buffer     = m_freeBuffers.back();
+                block.valid      = false;
+                block.last       = (m_nextValue + nbValues == request->nbValues);
+                m_freeBuffers.pop_back();
+                blocks.push_back(block);
+
+                m_nextValue += nbValues;
+                if(block.last)
+                {
+                    m_requests.pop_front();
+                    m_nextValue = 0;
+                }
+            }
+
+            if(blocks.empty())
+                continue;
+
+            lock.unlock();
+            readBlocks(blocks);
+            lock.lock();
+
+            for(const Block& block : blocks)
+                m_blocks.push_back(block);
+            m_decodeCond.notify_one();
+        }
+    }
+
+    void VTKAsyncLoader::readBlocks(std::vector<Block>& blocks)
+    {
+#ifdef VTK_HAVE_LIBURING
+        if(m_ring)
+        {
+            //Submit every read at once (there are at most VTK_ASYNC_NB_BUFFERS blocks), then wait for all of them
+            struct io_uring* ring = (struct io_uring*)m_ring;
+            uint32_t nbPrepared = 0;
+            for(Block& block : blocks)
+            {
+                struct io_uring_sqe* sqe = io_uring_get_sqe(ring);
+                if(sqe == NULL)
+                    break;
+                io_uring_prep_read(sqe, m_file, m_buffers[block.buffer], block.readSize, block.fileOffset);
+                io_uring_sqe_set_data(sqe, &block);
+                nbPrepared++;
+            }
+
+            for(uint32_t nbDone = 0; nbDone < nbPrepared;)
+            {
+                int res = io_uring_submit_and_wait(ring, 1);
+                if(res < 0 && res != -EINTR)
+                {
+                    //Broken ring : the next reads use pread. The reads not completed fail
+                    io_uring_queue_exit(ring);
+                    delete ring;
+                    m_ring = NULL;
+                    break;
+                }
+
+                struct io_uring_cqe* cqe = NULL;
+                while(nbDone < nbPrepared && io_uring_peek_cqe(ring, &cqe) == 0)
+                {
+                    //Short reads are completed with pread
+                    Block* block  = (Block*)io_uring_cqe_get_data(cqe);
+                    int    nbRead = cqe->res;
+                    io_uring_cqe_seen(ring, cqe);
+                    block->valid  = nbRead >= 0 &&
+                                    readFileAt(m_file, m_buffers[block->buffer] + nbRead, block->readSize - nbRead, block->fileOffset + nbRead);
+                    nbDone++;
+                }
+            }
+
+            for(uint32_t i = nbPrepared; i < blocks.size(); i++)
+                blocks[i].valid = readFileAt(m_file, m_buffers[blocks[i].buffer], blocks[i].readSize, blocks[i].fileOffset);
+            return;
+        }
+#endif
+        for(Block& block : blocks)
+            block.valid = readFileAt(m_file, m_buffers[block.buffer], block.readSize, block.fileOffset);
+    }
+
+    void VTKAsyncLoader::decodeLoop()
+    {
+        while(true)
+        {
+            Block block;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_decodeCond.wait(lock, [this]{return m_stop || !m_blocks.empty();});
+                if(m_blocks.empty())
+                    return;
+                block = m_blocks.front();
+                m_blocks.pop_front();
+            }
+
+            Request& request = *block.request;
+            if(request.inMemory)
+            {
+                if(request.success && request.nbValues > 0)
+                    request.success = m_parser.decodeBinaryValues(request.offset, request.nbValues, request.format, request.dest);
+            }
+            else if(!block.valid)
+                request.success = false;
+            else if(request.success)
+            {
+                size_t         sizeFormat = VTKValueFormatInt(request.format);
+                const uint8_t* src        = m_buffers[block.buffer] + block.head;
+                uint8_t*       dest       = request.dest + block.firstValue*sizeFormat;
+                auto decodeRange = [&](size_t begin, size_t end)
+                {
+                    VTKByteSwap_bigEndianToHost(src + begin*sizeFormat, dest + begin*sizeFormat, end-begin, request.format);
+                };
+
+                if(block.nbValues*sizeFormat < m_parser.m_parallelThreshold)
+                    decodeRange(0, block.nbValues);
+                else
+                    m_parser.m_threadPool->parallelFor(block.nbValues, VTK_ASYNC_DECODE_CHUNK_SIZE/sizeFormat, decodeRange);
+            }
+
+            if(block.buffer != VTK_ASYNC_NO_BUFFER)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_freeBuffers.push_back(block.buffer);
+                }
+                m_readCond.notify_one();
+            }
+
+            if(block.last)
+            {
+                //Out of the lock : the completion function can submit other requests
+                complete(request);
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_nbPending--;
+                }
+                m_doneCond.notify_all();
+            }
+        }
+    }
+}
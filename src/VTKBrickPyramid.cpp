@@ -0,0 +1,464 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#ifdef WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "VTKBrickPyramid.h"
+#include "VTKCache.h"
+#include "VTKParser.h"
+
+namespace sereno
+{
+    /** \brief  Alignment (in bytes) of the levels in the pyramid files, so that bricks of a page-multiple size start on a page */
+    static const uint64_t VTK_PYRAMID_ALIGNMENT = 4096;
+
+    /** \brief  Version of the pyramid file layout. Increase it every time the layout changes */
+    static const uint32_t VTK_PYRAMID_VERSION = 1;
+
+    /** \brief  Tells the endianness of the machine having written the pyramid file*/
+    static const uint32_t VTK_PYRAMID_ENDIANNESS = 0x01020304;
+
+    /** \brief  Size (in bytes) of the level rows filtered per chunk when filtering a slice in parallel */
+    static const size_t VTK_PYRAMID_CHUNK_SIZE = 128*1024;
+
+    static const char VTK_PYRAMID_MAGIC[8] = {'V', 'T', 'K', 'B', 'R', 'I', 'C', 'K'};
+
+    /** \brief  The header of a pyramid file. Followed by the level table and the (aligned) levels */
+    struct VTKBrickPyramidHeader
+    {
+        char     magic[8];        /*!< "VTKBRICK"*/
+        uint32_t version;         /*!< VTK_PYRAMID_VERSION*/
+        uint32_t endianness;      /*!< VTK_PYRAMID_ENDIANNESS written in the host endianness*/
+        uint32_t format;          /*!< The values format*/
+        uint32_t nbValuePerTuple; /*!< The number of values per tuple*/
+        uint32_t brickSize;       /*!< The number of points of a brick along each axis*/
+        uint32_t nbLevels;        /*!< The number of levels*/
+    };
+
+    /** \brief  Filter weights of the points 2i-1, 2i and 2i+1 of a level giving the point i of the next level */
+    static const double VTK_PYRAMID_WEIGHTS[3] = {0.25, 0.5, 0.25};
+
+    static bool writeFileAt(FILE* file, uint64_t offset, const void* data, size_t size)
+    {
+#ifdef WIN32
+        if(_fseeki64(file, offset, SEEK_SET) != 0)
+            return false;
+#else
+        if(fseeko(file, offset, SEEK_SET) != 0)
+            return false;
+#endif
+        return fwrite(data, 1, size, file) == size;
+    }
+
+    /**
+     * \brief  Filter the rows [firstRow, lastRow) of the next level slice from a slice of a level
+     * \param src the slice of the level (nx*ny tuples)
+     * \param nx the level size along the x axis
+     * \param ny the level size along the y axis
+     * \param nbComp the number of values per tuple
+     * \param dest the slice of the next level ((nx-1)/2+1 tuples per row)
+     */
+    template <typename T>
+    static void filterSliceRows(const T* src, uint32_t nx, uint32_t ny, uint32_t nbComp, double* dest, size_t firstRow, size_t lastRow)
+    {
+        uint32_t destNx = (nx-1)/2+1;
+        for(size_t j = firstRow; j < lastRow; j++)
+        {
+            const T* rows[3];
+            for(int32_t d = 0; d < 3; d++)
+                rows[d] = src + std::min<int64_t>(std::max<int64_t>(2*(int64_t)j+d-1, 0), ny-1)*nx*nbComp;
+
+            double* out = dest + j*destNx*nbComp;
+            for(uint32_t i = 0; i < destNx; i++)
+            {
+                size_t cols[3];
+                for(int32_t d = 0; d < 3; d++)
+                    cols[d] = std::min<int64_t>(std::max<int64_t>(2*(int64_t)i+d-1, 0), nx-1)*nbComp;
+
+                for(uint32_t c = 0; c < nbComp; c++)
+                {
+                    double v = 0;
+                    for(uint32_t dy = 0; dy < 3; dy++)
+                        for(uint32_t dx = 0; dx < 3; dx++)
+                            v += VTK_PYRAMID_WEIGHTS[dy]*VTK_PYRAMID_WEIGHTS[dx]*rows[dy][cols[dx]+c];
+                    out[i*nbComp+c] = v;
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    static void storeFilteredValues(const double* src, T* dest, size_t n)
+    {
+        for(size_t i = 0; i < n; i++)
+            dest[i] = (T)(std::is_integral<T>::value ? std::floor(src[i]+0.5) : src[i]);
+    }
+
+    /** \brief  Streaming writer of a pyramid file : the slices of each level are written in the bricks, and filtered into the next level */
+    struct VTKBrickPyramidWriter
+    {
+        /** \brief  The state of a level */
+        struct Level
+        {
+            VTKBrickLevel        desc;        /*!< The level descriptor*/
+            std::vector<double>  filtered;    /*!< The last slice filtered at the next level resolution*/
+            std::vector<double>  acc[2];      /*!< The next level slices being accumulated (even and odd ones)*/
+            std::vector<uint8_t> out;         /*!< The last next level slice, in the values format*/
+        };
+
+        FILE*                file;              /*!< The pyramid file being written*/
+        VTKValueFormat       format;            /*!< The values format*/
+        uint32_t             nbComp;            /*!< The number of values per tuple*/
+        uint32_t             brickSize;         /*!< The number of points of a brick along each axis*/
+        size_t               tupleSize;         /*!< The size (in bytes) of a tuple*/
+        size_t               parallelThreshold; /*!< Size (in bytes) under which slices are filtered serially*/
+        VTKThreadPool*       threadPool;        /*!< The threads filtering large slices*/
+        std::vector<Level>   levels;            /*!< The levels*/
+        std::vector<uint8_t> chunk;             /*!< One slice of a brick*/
+
+        /* \brief Write a slice of a level in its bricks (repeated up to the end of the bricks for the last slice) */
+        bool writeSlice(uint32_t level, uint32_t z, const uint8_t* slice)
+        {
+            const VTKBrickLevel& desc = levels[level].desc;
+            const uint32_t*      size = desc.descriptor.size;
+            size_t brickRowSize   = brickSize*tupleSize;
+            size_t brickSliceSize = brickSize*brickRowSize;
+            size_t brickDataSize  = brickSize*brickSliceSize;
+            uint32_t bz = z / brickSize;
+            uint32_t lz = z % brickSize;
+            uint32_t nbSlices = (z == size[2]-1 ? brickSize - lz : 1);
+
+            chunk.resize(brickSliceSize);
+            for(uint32_t by = 0; by < desc.nbBricks[1]; by++)
+                for(uint32_t bx = 0; bx < desc.nbBricks[0]; bx++)
+                {
+                    uint32_t x0 = bx*brickSize;
+                    uint32_t nx = std::min(brickSize, size[0]-x0);
+                    for(uint32_t ly = 0; ly < brickSize; ly++)
+                    {
+                        uint32_t       y   = std::min(by*brickSize+ly, size[1]-1);
+                        const uint8_t* row = slice + ((size_t)y*size[0] + x0)*tupleSize;
+                        uint8_t*       out = chunk.data() + ly*brickRowSize;
+                        memcpy(out, row, nx*tupleSize);
+                        for(uint32_t lx = nx; lx < brickSize; lx++)
+                            memcpy(out + lx*tupleSize, row + (nx-1)*tupleSize, tupleSize);
+                    }
+
+                    uint64_t offset = desc.offset + (((uint64_t)bz*desc.nbBricks[1] + by)*desc.nbBricks[0] + bx)*brickDataSize + lz*brickSliceSize;
+                    for(uint32_t s = 0; s < nbSlices; s++)
+                        if(!writeFileAt(file, offset + s*brickSliceSize, chunk.data(), brickSliceSize))
+                            return false;
+                }
+            return true;
+        }
+
+        /* \brief Filter a slice of a level at the next level resolution in levels[level].filtered */
+        template <typename T>
+        void filterSlice(uint32_t level, const T* slice)
+        {
+            const uint32_t* size   = levels[level].desc.descriptor.size;
+            const uint32_t* size1  = levels[level+1].desc.descriptor.size;
+            double*         dest   = levels[level].filtered.data();
+            auto filterRows = [&](size_t begin, size_t end)
+            {
+                filterSliceRows(slice, size[0], size[1], nbComp, dest, begin, end);
+            };
+
+            size_t rowSize = (size_t)size[0]*2*tupleSize;
+            if(rowSize*size1[1] < parallelThreshold)
+                filterRows(0, size1[1]);
+            else
+                threadPool->parallelFor(size1[1], std::max<size_t>(1, VTK_PYRAMID_CHUNK_SIZE/rowSize), filterRows);
+        }
+
+        /* \brief Convert the next level slice k (accumulated) in the values format, and push it to the next level */
+        bool emitSlice(uint32_t level, uint32_t k)
+        {
+            Level&  l   = levels[level];
+            double* acc = l.acc[k&1].data();
+            size_t  n   = l.acc[k&1].size();
+            switch(format)
+            {
+                case VTK_INT:
+                    storeFilteredValues(acc, (int32_t*)l.out.data(), n);
+                    break;
+                case VTK_DOUBLE:
+                    storeFilteredValues(acc, (double*)l.out.data(), n);
+                    break;
+                case VTK_FLOAT:
+                    storeFilteredValues(acc, (float*)l.out.data(), n);
+                    break;
+                case VTK_UNSIGNED_CHAR:
+                    storeFilteredValues(acc, (uint8_t*)l.out.data(), n);
+                    break;
+                case VTK_CHAR:
+                    storeFilteredValues(acc, (int8_t*)l.out.data(), n);
+                    break;
+                default:
+                    return false;
+            }
+            std::fill(l.acc[k&1].begin(), l.acc[k&1].end(), 0.0);
+            return pushSlice(level+1, k, l.out.data());
+        }
+
+        /* \brief Push the slice z of a level : write it, and accumulate it in the slices 2z-1, 2z and 2z+1 of the next level */
+        bool pushSlice(uint32_t level, uint32_t z, const uint8_t* slice)
+        {
+            if(!writeSlice(level, z, slice))
+                return false;
+            if(level+1 == levels.size())
+                return true;
+
+            switch(format)
+            {
+                case VTK_INT:
+                    filterSlice(level, (const int32_t*)slice);
+                    break;
+                case VTK_DOUBLE:
+                    filterSlice(level, (const double*)slice);
+                    break;
+                case VTK_FLOAT:
+                    filterSlice(level, (const float*)slice);
+                    break;
+                case VTK_UNSIGNED_CHAR:
+                    filterSlice(level, (const uint8_t*)slice);
+                    break;
+                case VTK_CHAR:
+                    filterSlice(level, (const int8_t*)slice);
+                    break;
+                default:
+                    return false;
+            }
+
+            //Out of the level, the first and the last slices are repeated
+            Level&        l        = levels[level];
+            const double* filtered = l.filtered.data();
+            uint32_t      k        = z/2;
+            bool          last     = (z == l.desc.descriptor.size[2]-1);
+            auto accumulate = [&](uint32_t slice, double weight)
+            {
+                double* acc = l.acc[slice&1].data();
+                for(size_t i = 0; i < l.filtered.size(); i++)
+                    acc[i] += weight*filtered[i];
+            };
+
+            if(z%2 == 0)
+            {
+                accumulate(k, VTK_PYRAMID_WEIGHTS[1] + (z == 0 ? VTK_PYRAMID_WEIGHTS[0] : 0.0) + (last ? VTK_PYRAMID_WEIGHTS[2] : 0.0));
+                return !last || emitSlice(level, k);
+            }
+
+            accumulate(k, VTK_PYRAMID_WEIGHTS[2]);
+            if(!last)
+                accumulate(k+1, VTK_PYRAMID_WEIGHTS[0]);
+            return emitSlice(level, k);
+        }
+    };
+
+    VTKBrickPyramid::~VTKBrickPyramid()
+    {
+        close();
+    }
+
+    void VTKBrickPyramid::close()
+    {
+        VTKUnmapFile(m_data, m_dataSize);
+        m_data            = NULL;
+        m_dataSize        = 0;
+        m_format          = VTK_NO_VALUE_FORMAT;
+        m_nbValuePerTuple = 0;
+        m_brickSize       = 0;
+        m_brickDataSize   = 0;
+        m_levels.clear();
+    }
+
+    bool VTKBrickPyramid::build(const VTKParser& parser, const VTKFieldValue* fieldData, const std::string& path, uint32_t brickSize)
+    {
+        const VTKStructuredPoints& desc = parser.getStructuredPointsDescriptor();
+        size_t tupleSize = fieldData->nbValuePerTuple*VTKValueFormatInt(fieldData->format);
+        if(parser.getDatasetType() != VTK_STRUCTURED_POINTS || brickSize == 0 || tupleSize == 0 ||
+           (uint64_t)desc.size[0]*desc.size[1]*desc.size[2] != fieldData->nbTuples)
+            return false;
+
+        VTKBrickPyramidHeader header;
+        memcpy(header.magic, VTK_PYRAMID_MAGIC, sizeof(VTK_PYRAMID_MAGIC));
+        header.version         = VTK_PYRAMID_VERSION;
+        header.endianness      = VTK_PYRAMID_ENDIANNESS;
+        header.format          = fieldData->format;
+        header.nbValuePerTuple = fieldData->nbValuePerTuple;
+        header.brickSize       = brickSize;
+
+        //Layout the levels, up to the first one fitting in a single brick
+        VTKThreadPool         threadPool(parser.getNbThreads());
+        VTKBrickPyramidWriter writer;
+        writer.format            = fieldData->format;
+        writer.nbComp            = fieldData->nbValuePerTuple;
+        writer.brickSize         = brickSize;
+        writer.tupleSize         = tupleSize;
+        writer.parallelThreshold = parser.getParallelThreshold();
+        writer.threadPool        = &threadPool;
+
+        VTKSubVolume box;
+        for(uint32_t i = 0; i < 3; i++)
+        {
+            box.first[i] = 0;
+            box.last[i]  = desc.size[i]-1;
+            box.step[i]  = 1;
+        }
+
+        while(true)
+        {
+            VTKBrickPyramidWriter::Level level;
+            parser.getStructuredPointsSubVolumeDescriptor(box, &level.desc.descriptor);
+            for(uint32_t i = 0; i < 3; i++)
+                level.desc.nbBricks[i] = (level.desc.descriptor.size[i] + brickSize - 1) / brickSize;
+            writer.levels.push_back(level);
+
+            const uint32_t* size = level.desc.descriptor.size;
+            if(size[0] <= brickSize && size[1] <= brickSize && size[2] <= brickSize)
+                break;
+            for(uint32_t i = 0; i < 3; i++)
+                box.step[i] *= 2;
+        }
+        header.nbLevels = writer.levels.size();
+
+        uint64_t brickDataSize = (uint64_t)brickSize*brickSize*brickSize*tupleSize;
+        uint64_t offset        = sizeof(header) + writer.levels.size()*sizeof(VTKBrickLevel);
+        std::vector<VTKBrickLevel> table;
+        for(uint32_t i = 0; i < writer.levels.size(); i++)
+        {
+            VTKBrickPyramidWriter::Level& level = writer.levels[i];
+            offset = (offset + VTK_PYRAMID_ALIGNMENT - 1) / VTK_PYRAMID_ALIGNMENT * VTK_PYRAMID_ALIGNMENT;
+            level.desc.offset = offset;
+            offset += (uint64_t)level.desc.nbBricks[0]*level.desc.nbBricks[1]*level.desc.nbBricks[2]*brickDataSize;
+            table.push_back(level.desc);
+
+            if(i+1 < writer.levels.size())
+            {
+                const uint32_t* size1 = writer.levels[i+1].desc.descriptor.size;
+                size_t          n     = (size_t)size1[0]*size1[1]*writer.nbComp;
+                level.filtered.resize(n);
+                level.acc[0].resize(n, 0.0);
+                level.acc[1].resize(n, 0.0);
+                level.out.resize(n*VTKValueFormatInt(writer.format));
+            }
+        }
+
+        //Write aside : concurrent readers never see a partial pyramid
+#ifdef WIN32
+        std::string tmpPath = path + "." + std::to_string(_getpid()) + ".tmp";
+#else
+        std::string tmpPath = path + "." + std::to_string(getpid()) + ".tmp";
+#endif
+        writer.file = fopen(tmpPath.c_str(), "wb");
+        if(writer.file == NULL)
+            return false;
+
+        bool valid = writeFileAt(writer.file, 0, &header, sizeof(header)) &&
+                     writeFileAt(writer.file, sizeof(header), table.data(), table.size()*sizeof(VTKBrickLevel));
+
+        //Stream the level 0 slice per slice
+        std::vector<uint8_t> slice((size_t)desc.size[0]*desc.size[1]*tupleSize);
+        box.step[0] = box.step[1] = box.step[2] = 1;
+        for(uint32_t z = 0; z < desc.size[2] && valid; z++)
+        {
+            box.first[2] = box.last[2] = z;
+            valid = parser.parseStructuredPointsFieldValues(fieldData, box, slice.data(), slice.size()) &&
+                    writer.pushSlice(0, z, slice.data());
+        }
+
+        valid = (fclose(writer.file) == 0) && valid;
+        if(valid)
+        {
+#ifdef WIN32
+            remove(path.c_str());
+#endif
+            valid = (rename(tmpPath.c_str(), path.c_str()) == 0);
+        }
+        if(!valid)
+            remove(tmpPath.c_str());
+        return valid;
+    }
+
+    bool VTKBrickPyramid::open(const std::string& path)
+    {
+        close();
+        if(!VTKMapFile(path, &m_data, &m_dataSize))
+            return false;
+
+        VTKBrickPyramidHeader header;
+        if(m_dataSize < sizeof(header))
+        {
+            close();
+            return false;
+        }
+        memcpy(&header, m_data, sizeof(header));
+
+        size_t sizeFormat = (header.format < VTK_NO_VALUE_FORMAT ? VTKValueFormatInt((VTKValueFormat)header.format) : 0);
+        if(memcmp(header.magic, VTK_PYRAMID_MAGIC, sizeof(VTK_PYRAMID_MAGIC)) != 0 || header.version != VTK_PYRAMID_VERSION ||
+           header.endianness != VTK_PYRAMID_ENDIANNESS || sizeFormat == 0 || header.nbValuePerTuple == 0 || header.brickSize == 0 ||
+           (m_dataSize - sizeof(header))/sizeof(VTKBrickLevel) < header.nbLevels)
+        {
+            close();
+            return false;
+        }
+
+        m_format          = (VTKValueFormat)header.format;
+        m_nbValuePerTuple = header.nbValuePerTuple;
+        m_brickSize       = header.brickSize;
+        m_brickDataSize   = (size_t)m_brickSize*m_brickSize*m_brickSize*m_nbValuePerTuple*sizeFormat;
+        m_levels.resize(header.nbLevels);
+        memcpy(m_levels.data(), m_data + sizeof(header), header.nbLevels*sizeof(VTKBrickLevel));
+
+        for(const VTKBrickLevel& level : m_levels)
+        {
+            uint64_t nbBricks = (uint64_t)level.nbBricks[0]*level.nbBricks[1]*level.nbBricks[2];
+            if(level.offset > m_dataSize || (m_dataSize - level.offset)/m_brickDataSize < nbBricks)
+            {
+                close();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool VTKBrickPyramid::getBrickDescriptor(uint32_t level, uint32_t x, uint32_t y, uint32_t z, VTKStructuredPoints* descriptor) const
+    {
+        const VTKBrickLevel* l = getLevel(level);
+        uint32_t brick[3] = {x, y, z};
+        if(l == NULL || x >= l->nbBricks[0] || y >= l->nbBricks[1] || z >= l->nbBricks[2])
+            return false;
+
+        for(uint32_t i = 0; i < 3; i++)
+        {
+            uint32_t first = brick[i]*m_brickSize;
+            descriptor->size[i]    = std::min(m_brickSize, l->descriptor.size[i] - first);
+            descriptor->spacing[i] = l->descriptor.spacing[i];
+            descriptor->origin[i]  = l->descriptor.origin[i] + first*l->descriptor.spacing[i];
+        }
+        return true;
+    }
+
+    const void* VTKBrickPyramid::getBrick(uint32_t level, uint32_t x, uint32_t y, uint32_t z) const
+    {
+        const VTKBrickLevel* l = getLevel(level);
+        if(l == NULL || x >= l->nbBricks[0] || y >= l->nbBricks[1] || z >= l->nbBricks[2])
+            return NULL;
+        return m_data + l->offset + (((uint64_t)z*l->nbBricks[1] + y)*l->nbBricks[0] + x)*m_brickDataSize;
+    }
+
+    bool VTKBrickPyramid::readBrick(uint32_t level, uint32_t x, uint32_t y, uint32_t z, void* dest, size_t capacity) const
+    {
+        const void* brick = getBrick(level, x, y, z);
+        if(brick == NULL || dest == NULL || capacity < m_brickDataSize)
+            return false;
+        memcpy(dest, brick, m_brickDataSize);
+        return true;
+    }
+}
@@ -0,0 +1,285 @@
+#include <cstring>
+#include "VTKByteSwap.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define VTK_BYTESWAP_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define VTK_BYTESWAP_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER)
+#define VTK_TARGET(x)
+#define VTK_BSWAP32(x) _byteswap_ulong(x)
+#define VTK_BSWAP64(x) _byteswap_uint64(x)
+#else
+#define VTK_TARGET(x) __attribute__((target(x)))
+#define VTK_BSWAP32(x) __builtin_bswap32(x)
+#define VTK_BSWAP64(x) __builtin_bswap64(x)
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define VTK_HOST_BIG_ENDIAN
+#endif
+
+namespace sereno
+{
+    /** \brief  A bulk conversion kernel */
+    typedef void (*VTKByteSwapKernel)(const uint8_t* src, uint8_t* dest, size_t nbValues);
+
+/*----------------------------------------------------------------------------*/
+/*-------------------------------Scalar kernels-------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+    static void swap32Scalar(const uint8_t* src, uint8_t* dest, size_t nbValues)
+    {
+        for(size_t i = 0; i < nbValues; i++, src+=4, dest+=4)
+        {
+            uint32_t v;
+            memcpy(&v, src, 4);
+            v = VTK_BSWAP32(v);
+            memcpy(dest, &v, 4);
+        }
+    }
+
+    static void swap64Scalar(const uint8_t* src, uint8_t* dest, size_t nbValues)
+    {
+        for(size_t i = 0; i < nbValues; i++, src+=8, dest+=8)
+        {
+            uint64_t v;
+            memcpy(&v, src, 8);
+            v = VTK_BSWAP64(v);
+            memcpy(dest, &v, 8);
+        }
+    }
+
+/*----------------------------------------------------------------------------*/
+/*--------------------------------x86 kernels---------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+#ifdef VTK_BYTESWAP_X86
+    /* SSE2 has no byte shuffle : swap the bytes inside each 16 bits word, then swap the words */
+    VTK_TARGET("sse2") static void swap32SSE2(const uint8_t* src, uint8_t* dest, size_t nbValues)
+    {
+        size_t i = 0;
+        for(; i + 4 <= nbValues; i+=4, src+=16, dest+=16)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i*)src);
+            v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+            v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+            v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+            _mm_storeu_si128((__m128i*)dest, v);
+        }
+        swap32Scalar(src, dest, nbValues-i);
+    }
+
+    VTK_TARGET("sse2") static void swap64SSE2(const uint8_t* src, uint8_t* dest, size_t nbValues)
+    {
+        size_t i = 0;
+        for(; i + 2 <= nbValues; i+=2, src+=16, dest+=16)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i*)src);
+            v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+            v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+            v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+            _mm_storeu_si128((__m128i*)dest, v);
+        }
+        swap64Scalar(src, dest, nbValues-i);
+    }
+
+    VTK_TARGET("avx2") static void swap32AVX2(const uint8_t* src, uint8_t* dest, size_t nbValues)
+    {
+        const __m256i mask = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                              3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        size_t i = 0;
+        for(; i + 16 <= nbValues; i+=16, src+=64, dest+=64)
+        {
+            __m256i v0 = _mm256_loadu_si256((const __m256i*)src);
+            __m256i v1 = _mm256_loadu_si256((const __m256i*)(src+32));
+            _mm256_storeu_si256((__m256i*)dest,      _mm256_shuffle_epi8(v0, mask));
+            _mm256_storeu_si256((__m256i*)(dest+32), _mm256_shuffle_epi8(v1, mask));
+        }
+        for(; i + 8 <= nbValues; i+=8, src+=32, dest+=32)
+            _mm256_storeu_si256((__m256i*)dest, _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)src), mask));
+        swap32Scalar(src, dest, nbValues-i);
+    }
+
+    VTK_TARGET("avx2") static void swap64AVX2(const uint8_t* src, uint8_t* dest, size_t nbValues)
+    {
+        const __m256i mask = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                              7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        size_t i = 0;
+        for(; i + 8 <= nbValues; i+=8, src+=64, dest+=64)
+        {
+            __m256i v0 = _mm256_loadu_si256((const __m256i*)src);
+            __m256i v1 = _mm256_loadu_si256((const __m256i*)(src+32));
+            _mm256_storeu_si256((__m256i*)dest,      _mm256_shuffle_epi8(v0, mask));
+            _mm256_storeu_si256((__m256i*)(dest+32), _mm256_shuffle_epi8(v1, mask));
+        }
+        for(; i + 4 <= nbValues; i+=4, src+=32, dest+=32)
+            _mm256_storeu_si256((__m256i*)dest, _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)src), mask));
+        swap64Scalar(src, dest, nbValues-i);
+    }
+
+    VTK_TARGET("avx512f,avx512bw") static void swap32AVX512(const uint8_t* src, uint8_t* dest, size_t nbValues)
+    {
+        const __m512i mask = _mm512_set4_epi32(0x0c0d0e0f, 0x08090a0b, 0x04050607, 0x00010203);
+        size_t i = 0;
+        for(; i + 16 <= nbValues; i+=16, src+=64, dest+=64)
+            _mm512_storeu_si512((void*)dest, _mm512_shuffle_epi8(_mm512_loadu_si512((const void*)src), mask));
+        swap32Scalar(src, dest, nbValues-i);
+    }
+
+    VTK_TARGET("avx512f,avx512bw") static void swap64AVX512(const uint8_t* src, uint8_t* dest, size_t nbValues)
+    {
+        const __m512i mask = _mm512_set4_epi64(0x08090a0b0c0d0e0f, 0x0001020304050607, 0x08090a0b0c0d0e0f, 0x0001020304050607);
+        size_t i = 0;
+        for(; i + 8 <= nbValues; i+=8, src+=64, dest+=64)
+            _mm512_storeu_si512((void*)dest, _mm512_shuffle_epi8(_mm512_loadu_si512((const void*)src), mask));
+        swap64Scalar(src, dest, nbValues-i);
+    }
+
+    /** \brief  The x86 instruction sets the kernels can use */
+    enum VTKByteSwapISA
+    {
+        VTK_ISA_SSE2,
+        VTK_ISA_AVX2,
+        VTK_ISA_AVX512
+    };
+
+    /* \brief Detect the best instruction set supported by the running CPU (and by the OS for the wide registers)
+     * \return the instruction set to use */
+    static VTKByteSwapISA detectISA()
+    {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        if(info[0] < 7)
+            return VTK_ISA_SSE2;
+
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        if(!osxsave)
+            return VTK_ISA_SSE2;
+        unsigned long long xcr0 = _xgetbv(0);
+
+        __cpuidex(info, 7, 0);
+        if((info[1] & (1 << 16)) && (info[1] & (1 << 30)) && (xcr0 & 0xe6) == 0xe6) //AVX512F, AVX512BW, ZMM state
+            return VTK_ISA_AVX512;
+        if((info[1] & (1 << 5)) && (xcr0 & 0x6) == 0x6) //AVX2, YMM state
+            return VTK_ISA_AVX2;
+        return VTK_ISA_SSE2;
+#else
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+            return VTK_ISA_AVX512;
+        if(__builtin_cpu_supports("avx2"))
+            return VTK_ISA_AVX2;
+        return VTK_ISA_SSE2;
+#endif
+    }
+#endif
+
+/*----------------------------------------------------------------------------*/
+/*--------------------------------NEON kernels--------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+#ifdef VTK_BYTESWAP_NEON
+    static void swap32NEON(const uint8_t* src, uint8_t* dest, size_t nbValues)
+    {
+        size_t i = 0;
+        for(; i + 4 <= nbValues; i+=4, src+=16, dest+=16)
+            vst1q_u8(dest, vrev32q_u8(vld1q_u8(src)));
+        swap32Scalar(src, dest, nbValues-i);
+    }
+
+    static void swap64NEON(const uint8_t* src, uint8_t* dest, size_t nbValues)
+    {
+        size_t i = 0;
+        for(; i + 2 <= nbValues; i+=2, src+=16, dest+=16)
+            vst1q_u8(dest, vrev64q_u8(vld1q_u8(src)));
+        swap64Scalar(src, dest, nbValues-i);
+    }
+#endif
+
+/*----------------------------------------------------------------------------*/
+/*---------------------------------Dispatching--------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+    /** \brief  The kernels selected for the running CPU */
+    struct VTKByteSwapKernels
+    {
+        VTKByteSwapKernel swap32; /*!< Kernel swapping 32 bits values*/
+        VTKByteSwapKernel swap64; /*!< Kernel swapping 64 bits values*/
+    };
+
+    /* \brief Get the kernels to use. The CPU is inspected only once
+     * \return the kernels to use */
+    static const VTKByteSwapKernels& getKernels()
+    {
+        static const VTKByteSwapKernels kernels = []()
+        {
+#if defined(VTK_BYTESWAP_X86)
+            switch(detectISA())
+            {
+                case VTK_ISA_AVX512:
+                    return VTKByteSwapKernels{swap32AVX512, swap64AVX512};
+                case VTK_ISA_AVX2:
+                    return VTKByteSwapKernels{swap32AVX2, swap64AVX2};
+                default:
+                    return VTKByteSwapKernels{swap32SSE2, swap64SSE2};
+            }
+#elif defined(VTK_BYTESWAP_NEON)
+            return VTKByteSwapKernels{swap32NEON, swap64NEON};
+#else
+            return VTKByteSwapKernels{swap32Scalar, swap64Scalar};
+#endif
+        }();
+        return kernels;
+    }
+
+    void VTKByteSwap_bigEndianToHost32(const void* src, void* dest, size_t nbValues)
+    {
+#ifdef VTK_HOST_BIG_ENDIAN
+        if(src != dest)
+            memcpy(dest, src, nbValues*4);
+#else
+        getKernels().swap32((const uint8_t*)src, (uint8_t*)dest, nbValues);
+#endif
+    }
+
+    void VTKByteSwap_bigEndianToHost64(const void* src, void* dest, size_t nbValues)
+    {
+#ifdef VTK_HOST_BIG_ENDIAN
+        if(src != dest)
+            memcpy(dest, src, nbValues*8);
+#else
+        getKernels().swap64((const uint8_t*)src, (uint8_t*)dest, nbValues);
+#endif
+    }
+
+    char VTKByteSwap_bigEndianToHost(const void* src, void* dest, size_t nbValues, VTKValueFormat format)
+    {
+        switch(format)
+        {
+            case VTK_INT:
+            case VTK_FLOAT:
+                VTKByteSwap_bigEndianToHost32(src, dest, nbValues);
+                return 1;
+            case VTK_DOUBLE:
+                VTKByteSwap_bigEndianToHost64(src, dest, nbValues);
+                return 1;
+            case VTK_UNSIGNED_CHAR:
+            case VTK_CHAR:
+                if(src != dest)
+                    memcpy(dest, src, nbValues);
+                return 1;
+            default:
+                return 0;
+        }
+    }
+}
@@ -0,0 +1,317 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#ifdef WIN32
+#include <io.h>
+#include <process.h>
+#include <Windows.h>
+#else
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+#include <sys/stat.h>
+
+#include "VTKCache.h"
+
+namespace sereno
+{
+    /** \brief  Alignment (in bytes) of the arrays in the cache files */
+    static const uint64_t VTK_CACHE_ALIGNMENT = 64;
+
+    /** \brief  Size (in bytes) of the blocks decoded and written at once when writing a cache file */
+    static const size_t VTK_CACHE_BLOCK_SIZE = 4*1024*1024;
+
+    /** \brief  Version of the cache file layout. Increase it every time the layout or the serialized metadata changes */
+    static const uint32_t VTK_CACHE_VERSION = 2;
+
+    /** \brief  Tells the endianness of the machine having written the cache file*/
+    static const uint32_t VTK_CACHE_ENDIANNESS = 0x01020304;
+
+    /** \brief  The header of a cache file. Followed by the VTK file path, the metadata, the array table and the (aligned) arrays */
+    struct VTKCacheHeader
+    {
+        char     magic[8];     /*!< "VTKCACHE"*/
+        uint32_t version;      /*!< VTK_CACHE_VERSION*/
+        uint32_t endianness;   /*!< VTK_CACHE_ENDIANNESS written in the host endianness*/
+        uint64_t sourceSize;   /*!< The size of the VTK file*/
+        int64_t  sourceMTime;  /*!< The modification time of the VTK file*/
+        uint64_t pathSize;     /*!< The size of the VTK file path*/
+        uint64_t metadataSize; /*!< The size of the serialized metadata*/
+        uint64_t nbArrays;     /*!< The number of arrays*/
+    };
+
+    static const char VTK_CACHE_MAGIC[8] = {'V', 'T', 'K', 'C', 'A', 'C', 'H', 'E'};
+
+    /**
+     * \brief  Get the size and the modification time of a file
+     * \param path the file path
+     * \param size[out] the file size
+     * \param mtime[out] the modification time (in nanoseconds when available)
+     * \return false if the file cannot be accessed, true otherwise
+     */
+    static bool getFileKey(const std::string& path, uint64_t* size, int64_t* mtime)
+    {
+#ifdef WIN32
+        struct _stat64 st;
+        if(_stat64(path.c_str(), &st) != 0)
+            return false;
+        *mtime = (int64_t)st.st_mtime*1000000000;
+#else
+        struct stat st;
+        if(stat(path.c_str(), &st) != 0)
+            return false;
+#ifdef __linux__
+        *mtime = (int64_t)st.st_mtim.tv_sec*1000000000 + st.st_mtim.tv_nsec;
+#else
+        *mtime = (int64_t)st.st_mtime*1000000000;
+#endif
+#endif
+        *size = (uint64_t)st.st_size;
+        return true;
+    }
+
+    static uint64_t alignCacheOffset(uint64_t offset)
+    {
+        return (offset + VTK_CACHE_ALIGNMENT - 1) / VTK_CACHE_ALIGNMENT * VTK_CACHE_ALIGNMENT;
+    }
+
+    static uint64_t getArraySize(const VTKCacheArray& array)
+    {
+        return array.nbValues*VTKValueFormatInt(array.format);
+    }
+
+    bool VTKMapFile(const std::string& path, uint8_t** data, size_t* size)
+    {
+#ifdef WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if(file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER fileSize;
+        if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        CloseHandle(file);
+        if(mapping == NULL)
+            return false;
+
+        //The view keeps a reference on the mapping object
+        *data = (uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if(*data == NULL)
+            return false;
+        *size = (size_t)fileSize.QuadPart;
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if(fd < 0)
+            return false;
+
+        struct stat st;
+        if(fstat(fd, &st) != 0 || st.st_size == 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        //The mapping stays valid once the file descriptor is closed
+        void* mapped = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if(mapped == MAP_FAILED)
+            return false;
+
+        *data = (uint8_t*)mapped;
+        *size = st.st_size;
+#endif
+        return true;
+    }
+
+    void VTKUnmapFile(uint8_t* data, size_t size)
+    {
+        if(data == NULL)
+            return;
+#ifdef WIN32
+        UnmapViewOfFile(data);
+#else
+        munmap(data, size);
+#endif
+    }
+
+    VTKCache::~VTKCache()
+    {
+        VTKUnmapFile(m_data, m_dataSize);
+    }
+
+    std::string VTKCache::getCachePath(const std::string& path, const std::string& directory)
+    {
+        if(directory.empty())
+            return path + ".vtkcache";
+
+        //Files having the same name in different directories must not share a cache : hash the whole path (FNV-1a)
+        uint64_t hash = 14695981039346656037ull;
+        for(char c : path)
+            hash = (hash ^ (uint8_t)c) * 1099511628211ull;
+
+        size_t      sep  = path.find_last_of("/\\");
+        std::string name = (sep == std::string::npos ? path : path.substr(sep+1));
+        char        hashStr[17];
+        snprintf(hashStr, sizeof(hashStr), "%016llx", (unsigned long long)hash);
+
+        char last = directory[directory.size()-1];
+        return directory + (last == '/' || last == '\\' ? "" : "/") + name + "." + hashStr + ".vtkcache";
+    }
+
+    bool VTKCache::open(const std::string& cachePath, const std::string& path)
+    {
+        VTKUnmapFile(m_data, m_dataSize);
+        m_data     = NULL;
+        m_dataSize = 0;
+        m_metadata = NULL;
+        m_arrays.clear();
+
+        uint64_t sourceSize;
+        int64_t  sourceMTime;
+        if(!getFileKey(path, &sourceSize, &sourceMTime) || !VTKMapFile(cachePath, &m_data, &m_dataSize))
+            return false;
+
+        //Check the header
+        VTKCacheHeader header;
+        if(m_dataSize < sizeof(header))
+            goto error;
+        memcpy(&header, m_data, sizeof(header));
+        if(memcmp(header.magic, VTK_CACHE_MAGIC, sizeof(VTK_CACHE_MAGIC)) != 0 || header.version != VTK_CACHE_VERSION ||
+           header.endianness != VTK_CACHE_ENDIANNESS || header.sourceSize != sourceSize || header.sourceMTime != sourceMTime ||
+           header.pathSize != path.size())
+            goto error;
+
+        {
+            uint64_t pathOffset     = sizeof(header);
+            uint64_t metadataOffset = pathOffset + header.pathSize;
+            uint64_t arraysOffset   = metadataOffset + header.metadataSize;
+            if(arraysOffset < metadataOffset || arraysOffset > m_dataSize || (m_dataSize - arraysOffset)/sizeof(VTKCacheArray) < header.nbArrays ||
+               memcmp(m_data + pathOffset, path.data(), path.size()) != 0)
+                goto error;
+
+            m_metadata     = m_data + metadataOffset;
+            m_metadataSize = header.metadataSize;
+            m_arrays.resize(header.nbArrays);
+            memcpy(m_arrays.data(), m_data + arraysOffset, header.nbArrays*sizeof(VTKCacheArray));
+        }
+
+        for(const VTKCacheArray& array : m_arrays)
+            if(VTKValueFormatInt(array.format) == 0 || array.cacheOffset > m_dataSize || (m_dataSize - array.cacheOffset)/VTKValueFormatInt(array.format) < array.nbValues)
+                goto error;
+        return true;
+
+    error:
+        VTKUnmapFile(m_data, m_dataSize);
+        m_data     = NULL;
+        m_dataSize = 0;
+        m_metadata = NULL;
+        m_arrays.clear();
+        return false;
+    }
+
+    bool VTKCache::write(const std::string& cachePath, const std::string& path, const std::string& metadata,
+                         const std::vector<VTKCacheArray>& arrays, const DecodeFunction& decode)
+    {
+        VTKCacheHeader header;
+        memcpy(header.magic, VTK_CACHE_MAGIC, sizeof(VTK_CACHE_MAGIC));
+        header.version      = VTK_CACHE_VERSION;
+        header.endianness   = VTK_CACHE_ENDIANNESS;
+        header.pathSize     = path.size();
+        header.metadataSize = metadata.size();
+        header.nbArrays     = arrays.size();
+        if(!getFileKey(path, &header.sourceSize, &header.sourceMTime))
+            return false;
+
+        //Layout the arrays
+        std::vector<VTKCacheArray> table = arrays;
+        std::sort(table.begin(), table.end(), [](const VTKCacheArray& a, const VTKCacheArray& b){return a.fileOffset < b.fileOffset;});
+        uint64_t offset = alignCacheOffset(sizeof(header) + path.size() + metadata.size() + table.size()*sizeof(VTKCacheArray));
+        for(VTKCacheArray& array : table)
+        {
+            array.cacheOffset = offset;
+            offset = alignCacheOffset(offset + getArraySize(array));
+        }
+
+        //Write aside : concurrent readers never see a partial cache
+#ifdef WIN32
+        std::string tmpPath = cachePath + "." + std::to_string(_getpid()) + ".tmp";
+#else
+        std::string tmpPath = cachePath + "." + std::to_string(getpid()) + ".tmp";
+#endif
+        FILE* file = fopen(tmpPath.c_str(), "wb");
+        if(file == NULL)
+            return false;
+
+        bool     valid   = true;
+        uint64_t written = 0;
+        auto writeData = [&](const void* data, size_t size)
+        {
+            valid    = valid && fwrite(data, 1, size, file) == size;
+            written += size;
+        };
+
+        static const uint8_t padding[VTK_CACHE_ALIGNMENT] = {0};
+        writeData(&header, sizeof(header));
+        writeData(path.data(), path.size());
+        writeData(metadata.data(), metadata.size());
+        writeData(table.data(), table.size()*sizeof(VTKCacheArray));
+
+        std::vector<uint8_t> block;
+        for(uint32_t i = 0; i < table.size() && valid; i++)
+        {
+            const VTKCacheArray& array = table[i];
+            writeData(padding, array.cacheOffset - written);
+
+            size_t sizeFormat = VTKValueFormatInt(array.format);
+            size_t grain      = std::max<size_t>(1, VTK_CACHE_BLOCK_SIZE/sizeFormat);
+            block.resize(std::min<uint64_t>(grain, array.nbValues)*sizeFormat);
+            for(uint64_t j = 0; j < array.nbValues && valid; j += grain)
+            {
+                size_t n = std::min<uint64_t>(grain, array.nbValues - j);
+                valid = valid && decode(array, j, n, block.data());
+                writeData(block.data(), n*sizeFormat);
+            }
+        }
+
+        valid = (fclose(file) == 0) && valid;
+        if(valid)
+        {
+#ifdef WIN32
+            remove(cachePath.c_str());
+#endif
+            valid = (rename(tmpPath.c_str(), cachePath.c_str()) == 0);
+        }
+        if(!valid)
+            remove(tmpPath.c_str());
+        return valid;
+    }
+
+    const uint8_t* VTKCache::getMetadata(size_t* size) const
+    {
+        *size = m_metadataSize;
+        return m_metadata;
+    }
+
+    const uint8_t* VTKCache::getValues(size_t fileOffset, size_t size) const
+    {
+        //Last array beginning before fileOffset
+        auto it = std::upper_bound(m_arrays.begin(), m_arrays.end(), fileOffset, [](size_t off, const VTKCacheArray& a){return off < a.fileOffset;});
+        if(it == m_arrays.begin())
+            return NULL;
+        --it;
+
+        uint64_t inArray = fileOffset - it->fileOffset;
+        uint64_t arraySize = getArraySize(*it);
+        if(inArray > arraySize || arraySize - inArray < size)
+            return NULL;
+        return m_data + it->cacheOffset + inArray;
+    }
+}
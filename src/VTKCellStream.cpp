@@ -0,0 +1,88 @@
+#include <algorithm>
+#include "VTKCellStream.h"
+#include "VTKParser.h"
+
+namespace sereno
+{
+    VTKCellStream::VTKCellStream(const VTKParser& parser, uint32_t batchSize, uint32_t firstCell) : m_parser(parser), m_batchSize(batchSize == 0 ? 1 : batchSize)
+    {
+        uint32_t nbValues;
+        if(m_parser.getDatasetType() != VTK_UNSTRUCTURED_GRID || !m_parser.getUnstructuredGridCellsRange(firstCell, 0, &m_nextValue, &nbValues))
+        {
+            m_error = true;
+            return;
+        }
+        m_nextCell = firstCell;
+
+        //Start reading ahead the first batch
+        const VTKUnstructuredGrid& grid = m_parser.m_unstrGrid;
+        m_parser.adviseData(grid.cells.offset + m_nextValue*sizeof(int32_t), (size_t)m_batchSize*8*sizeof(int32_t), true);
+        m_parser.adviseData(grid.cellTypes.offset + m_nextCell*sizeof(int32_t), (size_t)m_batchSize*sizeof(int32_t), true);
+    }
+
+    bool VTKCellStream::walkBatch(uint32_t& nbCells, uint32_t& nbValues) const
+    {
+        const VTKCells& cells = m_parser.m_unstrGrid.cells;
+        const uint8_t*  data  = m_parser.m_data + cells.offset;
+
+        uint64_t value = m_nextValue;
+        nbCells = std::min(m_batchSize, cells.nbCells - m_nextCell);
+
+        const uint32_t* index = m_parser.getUnstructuredGridCellIndex();
+        if(index)
+        {
+            nbValues = index[m_nextCell+nbCells] - m_nextValue;
+            return true;
+        }
+
+        for(uint32_t i = 0; i < nbCells; i++)
+        {
+            if(value >= cells.wholeSize)
+                return false;
+            value += 1 + (uint32_t)readVTKValue<int32_t>((void*)(data + value*sizeof(int32_t)), VTK_INT);
+        }
+
+        if(value > cells.wholeSize)
+            return false;
+        nbValues = (uint32_t)(value - m_nextValue);
+        return true;
+    }
+
+    const VTKCellBatch* VTKCellStream::next()
+    {
+        const VTKUnstructuredGrid& grid = m_parser.m_unstrGrid;
+        if(m_error || m_nextCell >= grid.cells.nbCells || m_nextCell >= grid.cellTypes.nbCells)
+            return NULL;
+
+        uint32_t nbCells, nbValues;
+        if(!walkBatch(nbCells, nbValues))
+        {
+            m_error = true;
+            return NULL;
+        }
+
+        m_batch.firstCell = m_nextCell;
+        m_batch.nbCells   = nbCells;
+        m_batch.cellValues.resize(nbValues);
+        m_batch.cellTypes.resize(nbCells);
+
+        size_t valuesOffset = grid.cells.offset     + (size_t)m_nextValue*sizeof(int32_t);
+        size_t typesOffset  = grid.cellTypes.offset + (size_t)m_nextCell*sizeof(int32_t);
+        if(!m_parser.decodeBinaryValues(valuesOffset, nbValues, VTK_INT, m_batch.cellValues.data()) ||
+           !m_parser.decodeBinaryValues(typesOffset,  nbCells,  VTK_INT, m_batch.cellTypes.data()))
+        {
+            m_error = true;
+            return NULL;
+        }
+
+        //The batch is copied : release its pages and read ahead the next batch while this one is processed
+        m_parser.adviseData(valuesOffset, nbValues*sizeof(int32_t), false);
+        m_parser.adviseData(typesOffset,  nbCells*sizeof(int32_t),  false);
+        m_parser.adviseData(valuesOffset + nbValues*sizeof(int32_t), nbValues*sizeof(int32_t), true);
+        m_parser.adviseData(typesOffset  + nbCells*sizeof(int32_t),  nbCells*sizeof(int32_t),  true);
+
+        m_nextCell  += nbCells;
+        m_nextValue += nbValues;
+        return &m_batch;
+    }
+}
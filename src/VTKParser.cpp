@@ -1,41 +1,681 @@
 #include <utility>
+#include <algorithm>
+#include <atomic>
+#include <limits>
 #include "VTKParser.h"
 
 namespace sereno
 {
-    const std::regex VTKParser::versionRegex("^# vtk DataFile Version (\\d+)\\.(\\d+)\\s*");
-    const std::regex VTKParser::datasetRegex("^DATASET (UNSTRUCTURED_GRID|STRUCTURED_GRID|STRUCTURED_POINTS)\\s*");
-    const std::regex VTKParser::pointsRegex("^POINTS (\\d+) (\\w+)\\s*");
-    const std::regex VTKParser::cellsRegex("^CELLS (\\d+) (\\d+)\\s*");
-    const std::regex VTKParser::dimensionsRegex("^DIMENSIONS (\\d+) (\\d+) (\\d+)\\s*");
-    const std::regex VTKParser::spacingRegex("^SPACING ([+-]?\\d*.?\\d+(?:e[+-]?\\d+)?) ([+-]?\\d*.?\\d+(?:e[+-]?\\d+)?) ([+-]?\\d*.?\\d+(?:e[+-]?\\d+)?)\\s*");
-    const std::regex VTKParser::originRegex("^ORIGIN ([+-]?\\d*.?\\d+(?:e[+-]?\\d+)?) ([+-]?\\d*.?\\d+(?:e[+-]?\\d+)?) ([+-]?\\d*.?\\d+(?:e[+-]?\\d+)?)\\s*");
-    const std::regex VTKParser::pointDataRegex("^POINT_DATA (\\d+)\\s*");
-    const std::regex VTKParser::cellDataRegex("^CELL_DATA (\\d+)\\s*");
-    const std::regex VTKParser::informationRegex("^INFORMATION (\\d+)\\s*");
-    const std::regex VTKParser::dataRegex("^DATA (\\d+) ((?:[+-]?\\d*.?\\d+)*)\\s*");
-    const std::regex VTKParser::nameLocationRegex("^NAME ([a-zA-Z_0-9]+) LOCATION ([a-zA-Z_0-9]+)\\s*");
-    const std::regex VTKParser::cellTypesRegex("^CELL_TYPES (\\d+)\\s*");
-    const std::regex VTKParser::fieldRegex("^FIELD (\\w+) (\\d+)\\s*");
-    const std::regex VTKParser::fieldValueRegex("^(\\w+) (\\d+) (\\d+) (\\w+)\\s*");
-
-    /* \brief Get the next line from a file
-     * \param f the file to read
-     * \return the next line */
-    static std::string getLineFromFile(FILE* f)
-    {
-        char c[1024];
-        std::string ret;
-        do
-        {
-            if(!fgets(c, 1024, f))
-                break;
-            ret = ret + c;
-        }while(ret.back() != '\n');
-        return ret;
+    /** \brief  Default size (in bytes) under which arrays are decoded serially */
+    static const size_t VTK_DEFAULT_PARALLEL_THRESHOLD = 1024*1024;
+
+    /** \brief  Size (in bytes) of the chunks decoded by one thread. Keeps the source and destination chunks in the L2 cache */
+    static const size_t VTK_DECODE_CHUNK_SIZE = 128*1024;
+
+    /** \brief  Size (in bytes) of the windows of a batch read (see parseArrays) : the next window is prefetched while the current one is decoded */
+    static const size_t VTK_BATCH_WINDOW_SIZE = 16*1024*1024;
+
+    /** \brief  Number of cells per chunk when filling the cell buffers in parallel */
+    static const uint32_t VTK_FILL_CHUNK_NB_CELLS = 4096;
+
+    /** \brief  Number of partitions of the faces hashed when extracting the boundary of the cells */
+    static const uint32_t VTK_FACE_PARTITIONS = 64;
+
+    /** \brief  Size (in bytes) of the chunks of text parsed by one thread when reading ASCII values */
+    static const size_t VTK_ASCII_CHUNK_SIZE = 256*1024;
+
+    /** \brief  Number of chunks per thread whose values are counted at once when searching the end of ASCII values */
+    static const size_t VTK_ASCII_CHUNKS_PER_THREAD = 4;
+
+    /** \brief  A chunk of ASCII values, beginning and ending at a white space so that no value is split */
+    struct VTKAsciiChunk
+    {
+        size_t begin;      /*!< The first character*/
+        size_t end;        /*!< The character after the last one*/
+        size_t nbTokens;   /*!< The number of tokens in this chunk*/
+        size_t firstValue; /*!< The index of the first token of this chunk in the values*/
+    };
+
+    /* \brief Is c a white space separating ASCII values ?
+     * \param c the character to test
+     * \return true if c is a space, a tabulation, a '\r' or a '\n' */
+    static inline bool isAsciiSpace(char c)
+    {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    /**
+     * \brief  Count the tokens (sequences of non white space characters) of a text
+     * \param first the first character
+     * \param last the character after the last one
+     * \return the number of tokens
+     */
+    static size_t countAsciiTokens(const char* first, const char* last)
+    {
+        size_t n       = 0;
+        bool   inToken = false;
+        for(; first < last; first++)
+        {
+            bool space = isAsciiSpace(*first);
+            n      += (!space && !inToken);
+            inToken = !space;
+        }
+        return n;
+    }
+
+    /**
+     * \brief  Parse ASCII values
+     * \tparam T the type of the values stored
+     * \tparam P the type parsed (wider than T for the 8 bits values, which are then range checked)
+     * \param first the first character
+     * \param last the character after the last one
+     * \param dest the values to write
+     * \param nbValues the number of values to parse
+     * \return the pointer after the last value parsed, NULL on error (missing or invalid value)
+     */
+    template <typename T, typename P>
+    static const char* parseAsciiValues(const char* first, const char* last, T* dest, size_t nbValues)
+    {
+        for(size_t i = 0; i < nbValues; i++)
+        {
+            while(first < last && isAsciiSpace(*first))
+                first++;
+
+            P           value;
+            const char* end = VTKFromChars(first, last, value);
+            if(end == NULL || (end < last && !isAsciiSpace(*end)) ||
+               (sizeof(T) < sizeof(P) && (value < std::numeric_limits<T>::lowest() || value > std::numeric_limits<T>::max())))
+                return NULL;
+            dest[i] = (T)value;
+            first   = end;
+        }
+        return first;
+    }
+
+    /**
+     * \brief  Parse ASCII values of a given format
+     * \param first the first character
+     * \param last the character after the last one
+     * \param dest the values to write
+     * \param format the format of the values
+     * \param nbValues the number of values to parse
+     * \return the pointer after the last value parsed, NULL on error (missing or invalid value, unknown format)
+     */
+    static const char* parseAsciiValues(const char* first, const char* last, void* dest, VTKValueFormat format, size_t nbValues)
+    {
+        switch(format)
+        {
+            case VTK_INT:
+                return parseAsciiValues<int32_t, int32_t>(first, last, (int32_t*)dest, nbValues);
+            case VTK_DOUBLE:
+                return parseAsciiValues<double, double>(first, last, (double*)dest, nbValues);
+            case VTK_FLOAT:
+                return parseAsciiValues<float, float>(first, last, (float*)dest, nbValues);
+            case VTK_UNSIGNED_CHAR:
+                return parseAsciiValues<uint8_t, uint32_t>(first, last, (uint8_t*)dest, nbValues);
+            case VTK_CHAR:
+                return parseAsciiValues<int8_t, int32_t>(first, last, (int8_t*)dest, nbValues);
+            default:
+                return NULL;
+        }
+    }
+
+    /** \brief  A face of a 3D cell, identified by its sorted point indices */
+    struct VTKFaceRecord
+    {
+        int32_t key[4]; /*!< The sorted point indices of the face. -1 for the missing fourth point of triangles*/
+        size_t  face;   /*!< The face index (cell*VTK_CELL_MAX_FACES + face in cell)*/
+
+        bool operator<(const VTKFaceRecord& r) const
+        {
+            for(uint32_t i = 0; i < 4; i++)
+                if(key[i] != r.key[i])
+                    return key[i] < r.key[i];
+            return false;
+        }
+
+        bool sameFace(const VTKFaceRecord& r) const
+        {
+            return key[0] == r.key[0] && key[1] == r.key[1] && key[2] == r.key[2] && key[3] == r.key[3];
+        }
+
+        uint32_t partition() const
+        {
+            uint32_t h = (uint32_t)key[0]*73856093u ^ (uint32_t)key[1]*19349663u ^ (uint32_t)key[2]*83492791u ^ (uint32_t)key[3]*2654435761u;
+            return (h ^ (h >> 16)) % VTK_FACE_PARTITIONS;
+        }
+    };
+
+    /** \brief  The corners of the cells of a structured grid in the VTK order (voxel offsets along the grid axes having more than one point) */
+    static const uint8_t VTK_GRID_CELL_CORNERS[8][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+                                                        {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+
+    /** \brief  A boundary side of a structured grid, made of the quads between its axes u and v */
+    struct VTKGridSide
+    {
+        uint64_t base;      /*!< The first point of the side*/
+        uint64_t strideU;   /*!< The distance between two consecutive points along u*/
+        uint64_t strideV;   /*!< The distance between two consecutive points along v*/
+        uint32_t nbQuadsU;  /*!< The number of quads along u*/
+        size_t   firstQuad; /*!< The index of the first quad of this side among every boundary quad*/
+        bool     outward;   /*!< Does u x v point outside the grid ? If not, the quads are reversed*/
+    };
+
+    /**
+     * \brief  Get the axes of a structured grid having more than one point. They define the cells : hexahedra (3 axes), quads (2), lines (1) or one vertex (0)
+     * \param grid the structured grid
+     * \param axes[out] the axes, in increasing order
+     * \return the number of axes
+     */
+    static uint32_t getGridCellAxes(const VTKGrid& grid, uint32_t axes[3])
+    {
+        uint32_t nbAxes = 0;
+        for(uint32_t i = 0; i < 3; i++)
+            if(grid.size[i] > 1)
+                axes[nbAxes++] = i;
+        return nbAxes;
+    }
+
+    /**
+     * \brief  Get the boundary sides of a structured grid. Flat grids (2 axes) have only one side, not duplicated
+     * \param grid the structured grid
+     * \param sides[out] the sides
+     * \return the number of boundary quads
+     */
+    static size_t getGridSides(const VTKGrid& grid, std::vector<VTKGridSide>& sides)
+    {
+        uint64_t stride[3] = {1, grid.size[0], (uint64_t)grid.size[0]*grid.size[1]};
+        size_t   nbQuads   = 0;
+        for(uint32_t a = 0; a < 3; a++)
+        {
+            //(u, v, a) is direct : u x v points toward +a
+            uint32_t u = (a+1)%3;
+            uint32_t v = (a+2)%3;
+            if(grid.size[u] < 2 || grid.size[v] < 2)
+                continue;
+
+            for(uint32_t s = 0; s < 2; s++)
+            {
+                if(s == 1 && grid.size[a] < 2)
+                    break;
+
+                VTKGridSide side;
+                side.base      = (s == 0 ? (uint64_t)(grid.size[a]-1)*stride[a] : 0);
+                side.strideU   = stride[u];
+                side.strideV   = stride[v];
+                side.nbQuadsU  = grid.size[u]-1;
+                side.firstQuad = nbQuads;
+                side.outward   = (s == 0);
+                sides.push_back(side);
+                nbQuads += (size_t)(grid.size[u]-1)*(grid.size[v]-1);
+            }
+        }
+        return nbQuads;
+    }
+
+    /* \brief Write an index in an element buffer
+     * \param buffer the element buffer
+     * \param i the position of the index in buffer
+     * \param index the index to write
+     * \param format the format of the indices of buffer */
+    static inline void writeElementIndex(void* buffer, size_t i, uint64_t index, VTKIndexFormat format)
+    {
+        if(format == VTK_INDEX_UINT16)
+            ((uint16_t*)buffer)[i] = (uint16_t)index;
+        else
+            ((uint32_t*)buffer)[i] = (uint32_t)index;
+    }
+
+    /** \brief  Append POD values and strings to the serialized metadata of a cache file */
+    struct VTKMetadataWriter
+    {
+        std::string& data; /*!< The serialized metadata*/
+
+        template <typename T>
+        void write(const T& value)
+        {
+            data.append((const char*)&value, sizeof(T));
+        }
+
+        void write(const std::string& str)
+        {
+            write((uint64_t)str.size());
+            data.append(str);
+        }
+    };
+
+    /** \brief  Read the values written by VTKMetadataWriter. Reads beyond the end invalidate the reader */
+    struct VTKMetadataReader
+    {
+        const uint8_t* data;         /*!< The next value*/
+        size_t         size;         /*!< The remaining size*/
+        bool           valid = true; /*!< Has every value been read correctly ?*/
+
+        template <typename T>
+        void read(T& value)
+        {
+            if(!valid || size < sizeof(T))
+            {
+                valid = false;
+                return;
+            }
+            memcpy(&value, data, sizeof(T));
+            data += sizeof(T);
+            size -= sizeof(T);
+        }
+
+        void read(std::string& str)
+        {
+            uint64_t strSize = 0;
+            read(strSize);
+            if(!valid || size < strSize)
+            {
+                valid = false;
+                return;
+            }
+            str.assign((const char*)data, strSize);
+            data += strSize;
+            size -= strSize;
+        }
+    };
+
+    /**
+     * \brief  Convert a value into another type. Integer types are saturated to their range (NaN == 0)
+     * \param value the value to convert
+     * \return the converted value
+     */
+    template <typename D, typename S>
+    static D saturateValue(S value)
+    {
+        if(!std::numeric_limits<D>::is_integer)
+            return (D)value;
+        if(value != value)
+            return 0;
+        if((double)value <= (double)std::numeric_limits<D>::lowest())
+            return std::numeric_limits<D>::lowest();
+        if((double)value >= (double)std::numeric_limits<D>::max())
+            return std::numeric_limits<D>::max();
+        return (D)value;
+    }
+
+    /**
+     * \brief  Convert values from one type to another, saturating integer types (see saturateValue)
+     * \param src the values to convert
+     * \param dest the converted values
+     * \param n the number of values
+     */
+    template <typename S, typename D>
+    static void convertValues(const void* src, void* dest, size_t n)
+    {
+        for(size_t i = 0; i < n; i++)
+            ((D*)dest)[i] = saturateValue<D>(((const S*)src)[i]);
+    }
+
+    /** \brief  Tells if values can be stored in a format in the files read (the conversion formats cannot)
+     * \param format the format to test
+     * \return true if format is a file format, false otherwise */
+    static bool isFileFormat(VTKValueFormat format)
+    {
+        return format == VTK_INT || format == VTK_DOUBLE || format == VTK_FLOAT || format == VTK_UNSIGNED_CHAR || format == VTK_CHAR;
+    }
+
+    /**
+     * \brief  Convert a float into a half float (IEEE 754 binary16), rounding to the nearest even value
+     * \param value the value to convert
+     * \return the bits of the half float
+     */
+    static uint16_t floatToHalf(float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        uint16_t sign    = (bits >> 16) & 0x8000;
+        uint32_t absBits = bits & 0x7fffffff;
+
+        //Infinite and NaN (kept quiet)
+        if(absBits >= 0x7f800000)
+            return sign | 0x7c00 | (absBits > 0x7f800000 ? 0x200 : 0);
+
+        //Rounded to infinity (>= 65520)
+        if(absBits >= 0x477ff000)
+            return sign | 0x7c00;
+
+        //Subnormal half floats (< 2^-14), or 0 (<= 2^-25)
+        if(absBits < 0x38800000)
+        {
+            if(absBits <= 0x33000000)
+                return sign;
+            uint32_t shift    = 126 - (absBits >> 23);
+            uint32_t mantissa = (absBits & 0x7fffff) | 0x800000;
+            uint32_t half     = mantissa >> shift;
+            uint32_t rest     = mantissa & ((1u << shift) - 1);
+            uint32_t middle   = 1u << (shift - 1);
+            if(rest > middle || (rest == middle && (half & 1)))
+                half++;
+            return sign | half;
+        }
+
+        //Normal half floats : rebias the exponent (127 -> 15). A rounding carry goes to the exponent
+        uint32_t half = (absBits - 0x38000000) >> 13;
+        uint32_t rest = absBits & 0x1fff;
+        if(rest > 0x1000 || (rest == 0x1000 && (half & 1)))
+            half++;
+        return sign | half;
+    }
+
+    /**
+     * \brief  Convert values into half floats
+     * \param src the values to convert
+     * \param dest the converted values
+     * \param n the number of values
+     */
+    template <typename S>
+    static void convertToHalf(const void* src, void* dest, size_t n)
+    {
+        for(size_t i = 0; i < n; i++)
+            ((uint16_t*)dest)[i] = floatToHalf((float)((const S*)src)[i]);
+    }
+
+    /**
+     * \brief  Convert values from one type to another format
+     * \param src the values to convert
+     * \param dest the converted values
+     * \param destFormat the format of dest
+     * \param n the number of values
+     * \return false if destFormat is not a known format, true otherwise
+     */
+    template <typename S>
+    static bool convertValues(const void* src, void* dest, VTKValueFormat destFormat, size_t n)
+    {
+        switch(destFormat)
+        {
+            case VTK_INT:
+                convertValues<S, int32_t>(src, dest, n);
+                return true;
+            case VTK_DOUBLE:
+                convertValues<S, double>(src, dest, n);
+                return true;
+            case VTK_FLOAT:
+                convertValues<S, float>(src, dest, n);
+                return true;
+            case VTK_UNSIGNED_CHAR:
+                convertValues<S, uint8_t>(src, dest, n);
+                return true;
+            case VTK_CHAR:
+                convertValues<S, int8_t>(src, dest, n);
+                return true;
+            case VTK_UNSIGNED_SHORT:
+                convertValues<S, uint16_t>(src, dest, n);
+                return true;
+            case VTK_HALF_FLOAT:
+                convertToHalf<S>(src, dest, n);
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * \brief  Convert values from one format to another
+     * \param src the values to convert
+     * \param srcFormat the format of src
+     * \param dest the converted values
+     * \param destFormat the format of dest
+     * \param n the number of values
+     * \return false if a format is not known, true otherwise
+     */
+    static bool convertValues(const void* src, VTKValueFormat srcFormat, void* dest, VTKValueFormat destFormat, size_t n)
+    {
+        switch(srcFormat)
+        {
+            case VTK_INT:
+                return convertValues<int32_t>(src, dest, destFormat, n);
+            case VTK_DOUBLE:
+                return convertValues<double>(src, dest, destFormat, n);
+            case VTK_FLOAT:
+                return convertValues<float>(src, dest, destFormat, n);
+            case VTK_UNSIGNED_CHAR:
+                return convertValues<uint8_t>(src, dest, destFormat, n);
+            case VTK_CHAR:
+                return convertValues<int8_t>(src, dest, destFormat, n);
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * \brief  Get the range of values, NaN and infinite values being ignored
+     * \param src the values
+     * \param n the number of values
+     * \param minVal[in, out] the minimum value, updated with the values
+     * \param maxVal[in, out] the maximum value, updated with the values
+     */
+    template <typename S>
+    static void getValuesRange(const void* src, size_t n, double* minVal, double* maxVal)
+    {
+        double low  = *minVal;
+        double high = *maxVal;
+        for(size_t i = 0; i < n; i++)
+        {
+            double value = (double)((const S*)src)[i];
+            if(value >= -std::numeric_limits<double>::max() && value <= std::numeric_limits<double>::max())
+            {
+                low  = std::min(low, value);
+                high = std::max(high, value);
+            }
+        }
+        *minVal = low;
+        *maxVal = high;
+    }
+
+    /** \brief  See getValuesRange<S>
+     * \return false if format is not a known format, true otherwise */
+    static bool getValuesRange(const void* src, VTKValueFormat format, size_t n, double* minVal, double* maxVal)
+    {
+        switch(format)
+        {
+            case VTK_INT:
+                getValuesRange<int32_t>(src, n, minVal, maxVal);
+                return true;
+            case VTK_DOUBLE:
+                getValuesRange<double>(src, n, minVal, maxVal);
+                return true;
+            case VTK_FLOAT:
+                getValuesRange<float>(src, n, minVal, maxVal);
+                return true;
+            case VTK_UNSIGNED_CHAR:
+                getValuesRange<uint8_t>(src, n, minVal, maxVal);
+                return true;
+            case VTK_CHAR:
+                getValuesRange<int8_t>(src, n, minVal, maxVal);
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /** \brief  Normalization of values : normalized = clamp((value - offset)*invScale, 0, maxValue), rounded */
+    struct VTKQuantizer
+    {
+        double offset;   /*!< The value mapped to 0*/
+        double invScale; /*!< The number of normalized steps per unit*/
+        double maxValue; /*!< The largest normalized value*/
+    };
+
+    /**
+     * \brief  Get the normalization of values onto the whole range of a format
+     * \param minVal the minimum value
+     * \param maxVal the maximum value
+     * \param destFormat the normalized format (VTK_UNSIGNED_CHAR or VTK_UNSIGNED_SHORT)
+     * \param quantizer[out] the normalization
+     * \param quantization[out] the mapping to get the values back
+     * \return false if destFormat cannot hold normalized values, true otherwise
+     */
+    static bool getQuantizer(double minVal, double maxVal, VTKValueFormat destFormat, VTKQuantizer* quantizer, VTKQuantization* quantization)
+    {
+        if(destFormat == VTK_UNSIGNED_CHAR)
+            quantizer->maxValue = 255.0;
+        else if(destFormat == VTK_UNSIGNED_SHORT)
+            quantizer->maxValue = 65535.0;
+        else
+            return false;
+
+        //Constant values are all mapped to 0
+        quantizer->offset      = minVal;
+        quantizer->invScale    = (maxVal > minVal ? quantizer->maxValue/(maxVal - minVal) : 0.0);
+        quantization->offset   = minVal;
+        quantization->scale    = (maxVal > minVal ? (maxVal - minVal)/quantizer->maxValue : 0.0);
+        return true;
+    }
+
+    template <typename S, typename D>
+    static void quantizeValues(const void* src, void* dest, size_t n, const VTKQuantizer& quantizer)
+    {
+        for(size_t i = 0; i < n; i++)
+        {
+            //NaN fails both comparisons and goes to 0
+            double value = ((double)((const S*)src)[i] - quantizer.offset)*quantizer.invScale;
+            value = (value > 0.0 ? (value < quantizer.maxValue ? value : quantizer.maxValue) : 0.0);
+            ((D*)dest)[i] = (D)(value + 0.5);
+        }
+    }
+
+    template <typename S>
+    static void quantizeValues(const void* src, void* dest, VTKValueFormat destFormat, size_t n, const VTKQuantizer& quantizer)
+    {
+        if(destFormat == VTK_UNSIGNED_CHAR)
+            quantizeValues<S, uint8_t>(src, dest, n, quantizer);
+        else
+            quantizeValues<S, uint16_t>(src, dest, n, quantizer);
+    }
+
+    /**
+     * \brief  Normalize values (see VTKQuantizer)
+     * \param src the values to normalize
+     * \param srcFormat the format of src
+     * \param dest the normalized values
+     * \param destFormat the format of dest (VTK_UNSIGNED_CHAR or VTK_UNSIGNED_SHORT, see getQuantizer)
+     * \param n the number of values
+     * \param quantizer the normalization
+     * \return false if srcFormat is not a known format, true otherwise
+     */
+    static bool quantizeValues(const void* src, VTKValueFormat srcFormat, void* dest, VTKValueFormat destFormat, size_t n, const VTKQuantizer& quantizer)
+    {
+        switch(srcFormat)
+        {
+            case VTK_INT:
+                quantizeValues<int32_t>(src, dest, destFormat, n, quantizer);
+                return true;
+            case VTK_DOUBLE:
+                quantizeValues<double>(src, dest, destFormat, n, quantizer);
+                return true;
+            case VTK_FLOAT:
+                quantizeValues<float>(src, dest, destFormat, n, quantizer);
+                return true;
+            case VTK_UNSIGNED_CHAR:
+                quantizeValues<uint8_t>(src, dest, destFormat, n, quantizer);
+                return true;
+            case VTK_CHAR:
+                quantizeValues<int8_t>(src, dest, destFormat, n, quantizer);
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /** \brief  Partial statistics of one component, merged into a VTKComponentStats once every chunk is done */
+    struct VTKStatsAccumulator
+    {
+        double   min      = std::numeric_limits<double>::infinity();  /*!< The minimum finite value*/
+        double   max      = -std::numeric_limits<double>::infinity(); /*!< The maximum finite value*/
+        double   sum      = 0.0;                                      /*!< The sum of the finite values*/
+        uint64_t nbFinite = 0;                                        /*!< The number of finite values*/
+        uint64_t nbNaN    = 0;                                        /*!< The number of NaN values*/
+    };
+
+    /**
+     * \brief  Accumulate the statistics of interleaved components
+     * \param src the values
+     * \param n the number of values
+     * \param component the component of the first value
+     * \param nbComponents the number of components
+     * \param acc[in, out] the statistics of each component
+     */
+    template <typename S>
+    static void accumulateStats(const void* src, size_t n, uint32_t component, uint32_t nbComponents, VTKStatsAccumulator* acc)
+    {
+        for(size_t i = 0; i < n; i++)
+        {
+            double               value = (double)((const S*)src)[i];
+            VTKStatsAccumulator& a     = acc[component];
+            if(value >= -std::numeric_limits<double>::max() && value <= std::numeric_limits<double>::max())
+            {
+                a.min  = std::min(a.min, value);
+                a.max  = std::max(a.max, value);
+                a.sum += value;
+                a.nbFinite++;
+            }
+            else if(value != value)
+                a.nbNaN++;
+            if(++component == nbComponents)
+                component = 0;
+        }
+    }
+
+    /** \brief  See accumulateStats<S>
+     * \return false if format is not a known format, true otherwise */
+    static bool accumulateStats(const void* src, VTKValueFormat format, size_t n, uint32_t component, uint32_t nbComponents, VTKStatsAccumulator* acc)
+    {
+        switch(format)
+        {
+            case VTK_INT:
+                accumulateStats<int32_t>(src, n, component, nbComponents, acc);
+                return true;
+            case VTK_DOUBLE:
+                accumulateStats<double>(src, n, component, nbComponents, acc);
+                return true;
+            case VTK_FLOAT:
+                accumulateStats<float>(src, n, component, nbComponents, acc);
+                return true;
+            case VTK_UNSIGNED_CHAR:
+                accumulateStats<uint8_t>(src, n, component, nbComponents, acc);
+                return true;
+            case VTK_CHAR:
+                accumulateStats<int8_t>(src, n, component, nbComponents, acc);
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * \brief  Merge partial statistics into the statistics of a component
+     * \param acc the partial statistics of the component
+     * \param nbAcc the number of partial statistics
+     * \param stride the distance between two partial statistics in acc
+     * \param stats[out] the statistics of the component
+     */
+    static void mergeStats(const VTKStatsAccumulator* acc, size_t nbAcc, size_t stride, VTKComponentStats* stats)
+    {
+        VTKStatsAccumulator merged;
+        for(size_t i = 0; i < nbAcc; i++)
+        {
+            const VTKStatsAccumulator& a = acc[i*stride];
+            merged.min       = std::min(merged.min, a.min);
+            merged.max       = std::max(merged.max, a.max);
+            merged.sum      += a.sum;
+            merged.nbFinite += a.nbFinite;
+            merged.nbNaN    += a.nbNaN;
+        }
+
+        if(merged.nbFinite == 0)
+            merged.min = merged.max = 0.0;
+        stats->min   = merged.min;
+        stats->max   = merged.max;
+        stats->mean  = (merged.nbFinite ? merged.sum/merged.nbFinite : 0.0);
+        stats->nbNaN = merged.nbNaN;
     }
 
-    VTKValueFormat VTKParser::vtkStringToFormat(const std::string& str)
+    VTKValueFormat VTKParser::vtkStringToFormat(const VTKToken& str)
     {
         if(str == "int")
             return VTK_INT;
@@ -50,29 +690,41 @@ namespace sereno
         return VTK_NO_VALUE_FORMAT;
     }
 
-    VTKParser::VTKParser(const std::string& path) : m_path(path)
+    VTKParser::VTKParser(const std::string& path) : m_type(VTK_DATASET_TYPE_NONE), m_path(path),
+                                                    m_threadPool(new VTKThreadPool()), m_parallelThreshold(VTK_DEFAULT_PARALLEL_THRESHOLD)
     {
         //Open the file and do a memory mapping on it
-#ifdef WIN32
-        fopen_s(&m_file, path.c_str(), "rb");
-#else
-		m_file = fopen(path.c_str(), "rb");
-#endif
-	}
+        mapFile(path);
+    }
 
-    VTKParser::VTKParser(VTKParser&& mvt) : m_type(mvt.m_type), m_path(std::move(mvt.m_path)), m_file(mvt.m_file)
+    VTKParser::VTKParser(VTKParser&& mvt) : m_type(mvt.m_type), m_cellData(std::move(mvt.m_cellData)), m_ptsData(std::move(mvt.m_ptsData)),
+                                            m_fileFormat(mvt.m_fileFormat), m_path(std::move(mvt.m_path)),
+                                            m_minorVer(mvt.m_minorVer), m_majorVer(mvt.m_majorVer), m_header(std::move(mvt.m_header)),
+                                            m_data(mvt.m_data), m_dataSize(mvt.m_dataSize), m_asciiData(std::move(mvt.m_asciiData)),
+                                            m_threadPool(std::move(mvt.m_threadPool)), m_parallelThreshold(mvt.m_parallelThreshold),
+                                            m_cellIndex(std::move(mvt.m_cellIndex)),
+                                            m_cacheEnabled(mvt.m_cacheEnabled), m_cacheDirectory(std::move(mvt.m_cacheDirectory)),
+                                            m_cache(std::move(mvt.m_cache))
     {
         switch(mvt.m_type)
         {
             case VTK_STRUCTURED_GRID:
                 new(&m_grid) VTKGrid(std::move(mvt.m_grid));
                 break;
+            case VTK_UNSTRUCTURED_GRID:
+                new(&m_unstrGrid) VTKUnstructuredGrid(std::move(mvt.m_unstrGrid));
+                break;
+            case VTK_STRUCTURED_POINTS:
+                new(&m_strPoints) VTKStructuredPoints(std::move(mvt.m_strPoints));
+                break;
             default:
                 break;
         }
 
-        mvt.m_file = NULL;
-        mvt.m_type     = VTK_DATASET_TYPE_NONE;
+        mvt.m_data       = NULL;
+        mvt.m_dataSize   = 0;
+        mvt.m_type       = VTK_DATASET_TYPE_NONE;
+        mvt.m_threadPool.reset(new VTKThreadPool(m_threadPool->getNbThreads()));
     }
 
     VTKParser::~VTKParser()
@@ -89,130 +741,191 @@ namespace sereno
         }
     }
 
+    bool VTKParser::mapFile(const std::string& path)
+    {
+        return VTKMapFile(path, &m_data, &m_dataSize);
+    }
+
     void VTKParser::closeParser()
     {
-        if(m_file)
-            fclose(m_file);
+        if(isDataMapped())
+            VTKUnmapFile(m_data, m_dataSize);
+        m_data     = NULL;
+        m_dataSize = 0;
+        std::vector<uint8_t>().swap(m_asciiData);
+        m_cache.reset();
+    }
+
+    void VTKParser::useAsciiData()
+    {
+        //The text is not needed anymore
+        if(isDataMapped())
+            VTKUnmapFile(m_data, m_dataSize);
+        m_data     = m_asciiData.data();
+        m_dataSize = m_asciiData.size();
+    }
+
+    void VTKParser::setNbThreads(uint32_t nbThreads)
+    {
+        m_threadPool.reset(new VTKThreadPool(nbThreads));
+    }
+
+    void VTKParser::setCacheEnabled(bool enable, const std::string& directory)
+    {
+        m_cacheEnabled   = enable;
+        m_cacheDirectory = directory;
     }
 
-#define GET_VTK_NEXT_LINE(x) \
+#define GET_VTK_NEXT_LINE(_tokenizer) \
     {\
-        line = getLineFromFile(x); \
-        if(line.size() == 0) \
+        if(!_tokenizer.nextLine()) \
         {\
             std::cerr << "Unexpected EOF\n";\
             return false;\
         }\
     }
 
+#define VTK_PARSE_ARRAY(_tokenizer, _nbValues, _format, _offset) \
+    {\
+        size_t _off;\
+        if(!parseArrayValues(_tokenizer, _nbValues, _format, _off)) \
+            return false;\
+        _offset = _off;\
+    }
 
-#define VTK_STRINGIFY(a) #a
+#define VTK_PARSE_END_OF_BLOCK(_tokenizer) \
+    {\
+        GET_VTK_NEXT_LINE(_tokenizer) \
+        if(!_tokenizer.isLineEnd()) \
+        {\
+            std::cerr << "Unexpected token " << _tokenizer.getLine().toString() << std::endl;\
+            return false;\
+        }\
+    }
 
-#pragma GCC diagnostic ignored "-Wshadow"
-#define VTK_PARSE_METADATA(_file)        \
+#define VTK_PARSE_METADATA(_tokenizer)              \
     {\
-        size_t _off = ftell(_file);      \
-        line = getLineFromFile(_file);   \
-        if(line == "METADATA\n")         \
-        {                                \
-            if(!parseMetadata(_file))    \
-                return false;            \
-        }                                \
-        else                             \
-            fseek(_file, _off, SEEK_SET);\
+        size_t _off = _tokenizer.getCursor();       \
+        if(_tokenizer.nextLine() &&                 \
+           _tokenizer.nextKeyword("METADATA") &&    \
+           _tokenizer.isLineEnd())                  \
+        {                                           \
+            if(!parseMetadata(_tokenizer))          \
+                return false;                       \
+        }                                           \
+        else                                        \
+            _tokenizer.setCursor(_off);             \
     }\
 
     bool VTKParser::parse()
     {
-        fseek(m_file, 0, SEEK_SET);
+        //Parsed again : an ASCII file does not keep its text mapped once parsed (see useAsciiData)
+        if(m_data != NULL && !isDataMapped())
+        {
+            m_data     = NULL;
+            m_dataSize = 0;
+            mapFile(m_path);
+        }
+
+        if(m_data == NULL)
+        {
+            std::cerr << "Could not map the file " << m_path << std::endl;
+            return false;
+        }
+
+        m_cache.reset();
+        if(m_cacheEnabled && loadCache())
+            return true;
+
+        VTKTokenizer tokenizer(m_data, m_dataSize);
+        VTKToken     token;
 
         bool hasParsedPointData = false;
         bool hasParsedCellData  = false;
 
-        std::smatch match;
-
         //Version
-        std::string line = getLineFromFile(m_file);
-        if(std::regex_match(line, match, versionRegex))
+        if(!tokenizer.nextLine()           || !tokenizer.nextKeyword("#")        || !tokenizer.nextKeyword("vtk") ||
+           !tokenizer.nextKeyword("DataFile") || !tokenizer.nextKeyword("Version") || !tokenizer.nextToken(token))
         {
-            try
-            {
-                m_majorVer = std::stoi(match[1].str());
-                m_minorVer = std::stoi(match[2].str());
-            }
-
-            catch(const std::exception& e)
-            {
-                std::cerr << "Error at parsing the VTK file version. Discarding. error : " <<  e.what() << std::endl;
-                goto error;
-            }
+            std::cerr << "Wrong version VTK format in the VERSION part. " << tokenizer.getLine().toString() << "\n";
+            goto error;
         }
         else
         {
-            std::cerr << "Wrong version VTK format in the VERSION part. " << line << "\n";
-            goto error;
+            const char* end   = token.str + token.size;
+            const char* minor = VTKFromChars(token.str, end, m_majorVer);
+            if(minor == NULL || minor == end || *minor != '.' || VTKFromChars(minor+1, end, m_minorVer) != end || !tokenizer.isLineEnd())
+            {
+                std::cerr << "Error at parsing the VTK file version. Discarding. " << tokenizer.getLine().toString() << std::endl;
+                goto error;
+            }
         }
 
         //Header
-        m_header = getLineFromFile(m_file);
-        if(m_header.size() == 0)
+        if(!tokenizer.nextLine())
         {
             std::cerr << "Not header.\n";
             goto error;
         }
+        m_header = tokenizer.getLine().toString();
 
         //Binary or Ascii ?
-        line = getLineFromFile(m_file);
-        if(line != "BINARY\n")
+        if(!tokenizer.nextLine() || !tokenizer.nextToken(token) || (token != "BINARY" && token != "ASCII") || !tokenizer.isLineEnd())
         {
-            std::cerr << "Do not handle type other than BINARY. Received " << line << std::endl;
+            std::cerr << "Do not handle type other than BINARY or ASCII. Received " << tokenizer.getLine().toString() << std::endl;
             goto error;
         }
-        m_fileFormat = VTK_BINARY;
+        m_fileFormat = (token == "BINARY" ? VTK_BINARY : VTK_ASCII);
+        m_asciiData.clear();
 
         //Parse dataset information
-        GET_VTK_NEXT_LINE(m_file)
-        if(std::regex_match(line, match, datasetRegex))
+        if(!tokenizer.nextLine())
+        {
+            std::cerr << "Unexpected EOF\n";
+            goto error;
+        }
+        if(tokenizer.nextKeyword("DATASET") && tokenizer.nextToken(token) && tokenizer.isLineEnd())
         {
-            if(match[1].str() == "UNSTRUCTURED_GRID")
+            if(token == "UNSTRUCTURED_GRID")
             {
                 m_type = VTK_UNSTRUCTURED_GRID;
-                if(!parseUnstructuredGrid(m_file))
+                if(!parseUnstructuredGrid(tokenizer))
                     goto error;
             }
-            else if(match[1].str() == "STRUCTURED_GRID")
+            else if(token == "STRUCTURED_GRID")
             {
                 m_type = VTK_STRUCTURED_GRID;
-                if(!parseStructuredGrid(m_file))
+                if(!parseStructuredGrid(tokenizer))
                     goto error;
             }
-            else if(match[1].str() == "STRUCTURED_POINTS")
+            else if(token == "STRUCTURED_POINTS")
             {
                 m_type = VTK_STRUCTURED_POINTS;
-                if(!parseStructuredPoints(m_file))
+                if(!parseStructuredPoints(tokenizer))
                     goto error;
             }
             else
             {
-                std::cerr << "Unexpecting vtk dataset structure... Received : " << match[1].str() << "\n";
+                std::cerr << "Unexpecting vtk dataset structure... Received : " << token.toString() << "\n";
                 goto error;
             }
         }
         else
         {
-            std::cerr << "Expecting the DATASET line and got " << line << std::endl;
+            std::cerr << "Expecting the DATASET line and got " << tokenizer.getLine().toString() << std::endl;
             goto error;
         }
 
         for(uint32_t i = 0; i < 2; i++)
         {
             //Check end of file
-            line = getLineFromFile(m_file);
-            if(line.size() == 0)
+            if(!tokenizer.nextLine())
                 goto success;
 
             //Parse point data if exist
-            if(std::regex_match(line, match, pointDataRegex))
+            if(!tokenizer.nextToken(token))
+                continue;
+            if(token == "POINT_DATA" && tokenizer.nextNumber(m_ptsData.n) && tokenizer.isLineEnd())
             {
                 if(hasParsedPointData)
                 {
@@ -220,11 +933,11 @@ namespace sereno
                     goto error;
                 }
                 hasParsedPointData = true;
-                parseValues(m_file, m_ptsData);
+                parseValues(tokenizer, m_ptsData);
             }
 
             //Parse cell data if exist
-            else if(std::regex_match(line, match, cellDataRegex))
+            else if(token == "CELL_DATA" && tokenizer.nextNumber(m_cellData.n) && tokenizer.isLineEnd())
             {
                 if(hasParsedCellData)
                 {
@@ -232,446 +945,2556 @@ namespace sereno
                     goto error;
                 }
                 hasParsedCellData = true;
-                parseValues(m_file, m_cellData);
+                parseValues(tokenizer, m_cellData);
             }
         }
 
     success:
+        if(m_fileFormat == VTK_ASCII)
+            useAsciiData();
+        if(m_cacheEnabled)
+            saveCache();
         return true;
     error:
         return false;
     }
 
-    bool VTKParser::parseUnstructuredGrid(FILE* file)
+    bool VTKParser::parseUnstructuredGrid(VTKTokenizer& tokenizer)
     {
         bool parsedPoints    = false;
         bool parsedCells     = false;
         bool parsedCellTypes = false;
 
-        std::string line;
-        std::smatch match;
+        VTKToken token;
+        m_cellIndex.clear();
 
-        try
+        for(uint32_t i = 0; i < 3; i++)
         {
-            for(uint32_t i = 0; i < 3; i++)
+            GET_VTK_NEXT_LINE(tokenizer)
+            if(!tokenizer.nextToken(token))
             {
-                GET_VTK_NEXT_LINE(file)
-                if(!parsedPoints && std::regex_match(line, match, pointsRegex))
-                {
-                    parsedPoints = true;
-
-                    //Parsing points 
-                    m_unstrGrid.ptsPos.nbPoints = std::stoi(match[1].str());
-                    m_unstrGrid.ptsPos.format   = vtkStringToFormat(match[2].str());
-                    m_unstrGrid.ptsPos.offset   = ftell(file);
-                    fseek(file, 3*m_unstrGrid.ptsPos.nbPoints*VTKValueFormatInt(m_unstrGrid.ptsPos.format), SEEK_CUR);
+                std::cerr << "Expecting a valid unstructured grid token\n";
+                return false;
+            }
 
-                    GET_VTK_NEXT_LINE(file)
-                    if(line != "\n")
-                    {
-                        std::cerr << line << "Unexpected token\n";
-                        return false;
-                    }
+            //Parsing points
+            if(!parsedPoints && token == "POINTS")
+            {
+                parsedPoints = true;
 
-                    //Parsing points metadata
-                    VTK_PARSE_METADATA(file)
+                if(!tokenizer.nextNumber(m_unstrGrid.ptsPos.nbPoints) || !tokenizer.nextToken(token) || !tokenizer.isLineEnd())
+                {
+                    std::cerr << "Error at dataset block : " << tokenizer.getLine().toString() << std::endl;
+                    return false;
                 }
+                m_unstrGrid.ptsPos.format = vtkStringToFormat(token);
+                VTK_PARSE_ARRAY(tokenizer, 3*(size_t)m_unstrGrid.ptsPos.nbPoints, m_unstrGrid.ptsPos.format, m_unstrGrid.ptsPos.offset)
+                VTK_PARSE_END_OF_BLOCK(tokenizer)
 
-                //Parsing cells
-                else if(!parsedCells && std::regex_match(line, match, cellsRegex))
-                {
-                    parsedCells = true;
-                    m_unstrGrid.cells.nbCells   = std::stoi(match[1].str());
-                    m_unstrGrid.cells.wholeSize = std::stoi(match[2].str());
-                    m_unstrGrid.cells.offset    = ftell(file);
-                    fseek(file, m_unstrGrid.cells.wholeSize*sizeof(int), SEEK_CUR);
-                    GET_VTK_NEXT_LINE(file); //"\n"
-                    if(line != "\n")
-                    {
-                        std::cerr << "Unexpected token\n";
-                        return false;
-                    }
+                //Parsing points metadata
+                VTK_PARSE_METADATA(tokenizer)
+            }
 
-                    VTK_PARSE_METADATA(file)
-                }
-                else if(!parsedCellTypes && std::regex_match(line, match, cellTypesRegex))
+            //Parsing cells
+            else if(!parsedCells && token == "CELLS")
+            {
+                parsedCells = true;
+                if(!tokenizer.nextNumber(m_unstrGrid.cells.nbCells) || !tokenizer.nextNumber(m_unstrGrid.cells.wholeSize) || !tokenizer.isLineEnd())
                 {
-                    parsedCellTypes = true;
-
-                    m_unstrGrid.cellTypes.offset  = ftell(file);
-                    m_unstrGrid.cellTypes.nbCells = std::stoi(match[1].str());
-                    fseek(file, m_unstrGrid.cellTypes.nbCells*sizeof(int), SEEK_CUR);
-                    GET_VTK_NEXT_LINE(file)
-                    if(line != "\n")
-                    {
-                        std::cerr << "Unexpecting token.\n";
-                        return false;
-                    }
-                    VTK_PARSE_METADATA(file)
+                    std::cerr << "Error at dataset block : " << tokenizer.getLine().toString() << std::endl;
+                    return false;
                 }
-                else
+                VTK_PARSE_ARRAY(tokenizer, m_unstrGrid.cells.wholeSize, VTK_INT, m_unstrGrid.cells.offset)
+                VTK_PARSE_END_OF_BLOCK(tokenizer)
+                VTK_PARSE_METADATA(tokenizer)
+            }
+
+            //Parsing cell types
+            else if(!parsedCellTypes && token == "CELL_TYPES")
+            {
+                parsedCellTypes = true;
+                if(!tokenizer.nextNumber(m_unstrGrid.cellTypes.nbCells) || !tokenizer.isLineEnd())
                 {
-                    std::cerr << "Expecting a valid unstructured grid token\n";
+                    std::cerr << "Error at dataset block : " << tokenizer.getLine().toString() << std::endl;
                     return false;
                 }
+                VTK_PARSE_ARRAY(tokenizer, m_unstrGrid.cellTypes.nbCells, VTK_INT, m_unstrGrid.cellTypes.offset)
+                VTK_PARSE_END_OF_BLOCK(tokenizer)
+                VTK_PARSE_METADATA(tokenizer)
+            }
+            else
+            {
+                std::cerr << "Expecting a valid unstructured grid token\n";
+                return false;
             }
-        }
-        catch(const std::exception& e)
-        {
-            std::cerr << "Error at dataset block : " << e.what() << std::endl;
-            return false;
         }
         return true;
     }
 
-    bool VTKParser::parseStructuredPoints(FILE* file)
+    bool VTKParser::parseStructuredPoints(VTKTokenizer& tokenizer)
     {
         bool parsedDimensions = false;
         bool parsedSpacing    = false;
         bool parsedOrigin     = false;
 
-        std::smatch match;
-        std::string line;
+        VTKToken token;
+
+        for(uint32_t i = 0; i < 3; i++) //Parse three information
+        {
+            GET_VTK_NEXT_LINE(tokenizer)
+            if(!tokenizer.nextToken(token))
+            {
+                std::cerr << "Expecting a valid structured points token\n";
+                return false;
+            }
+
+            bool valid = true;
+            if(!parsedDimensions && token == "DIMENSIONS")
+            {
+                parsedDimensions = true;
+                for(uint32_t j = 0; j < 3; j++)
+                    valid = valid && tokenizer.nextNumber(m_strPoints.size[j]);
+            }
+
+            else if(!parsedSpacing && token == "SPACING")
+            {
+                parsedSpacing = true;
+                for(uint32_t j = 0; j < 3; j++)
+                    valid = valid && tokenizer.nextNumber(m_strPoints.spacing[j]);
+            }
+
+            else if(!parsedOrigin && token == "ORIGIN")
+            {
+                parsedOrigin = true;
+                for(uint32_t j = 0; j < 3; j++)
+                    valid = valid && tokenizer.nextNumber(m_strPoints.origin[j]);
+            }
+            else
+            {
+                std::cerr << "Expecting a valid structured points token\n";
+                return false;
+            }
+
+            if(!valid || !tokenizer.isLineEnd())
+            {
+                std::cerr << "Error while parsing structured points : " << tokenizer.getLine().toString() << std::endl;
+                return false;
+            }
+            VTK_PARSE_METADATA(tokenizer)
+        }
+
+        return true;
+    }
+
+    bool VTKParser::parseStructuredGrid(VTKTokenizer& tokenizer)
+    {
+        bool parsedDimensions = false;
+        bool parsedPoints     = false;
 
-        setlocale(LC_ALL, "C");
+        VTKToken token;
 
-        try
+        for(uint32_t i = 0; i < 2; i++)
         {
-            for(uint32_t i = 0; i < 3; i++) //Parse three information
+            GET_VTK_NEXT_LINE(tokenizer)
+            if(!tokenizer.nextToken(token))
             {
-                GET_VTK_NEXT_LINE(file)
-                if(!parsedDimensions && std::regex_match(line, match, dimensionsRegex))
-                {
-                    parsedDimensions = true;
-                    for(uint32_t j = 0; j < 3; j++)
-                        m_strPoints.size[j] = std::stoi(match[j+1].str());
-                    VTK_PARSE_METADATA(file)
-                }
+                std::cerr << "Expecting a valid structured grid token\n";
+                return false;
+            }
 
-                else if(!parsedSpacing && std::regex_match(line, match, spacingRegex))
+            //Parsing dimensions
+            if(!parsedDimensions && token == "DIMENSIONS")
+            {
+                parsedDimensions = true;
+                bool valid = true;
+                for(uint32_t j = 0; j < 3; j++)
+                    valid = valid && tokenizer.nextNumber(m_grid.size[j]) && m_grid.size[j] > 0;
+                if(!valid || !tokenizer.isLineEnd())
                 {
-                    parsedSpacing = true;
-                    for(uint32_t j = 0; j < 3; j++)
-                        m_strPoints.spacing[j] = std::stod(match[j+1].str());
-                    VTK_PARSE_METADATA(file)
+                    std::cerr << "Error while parsing structured grid : " << tokenizer.getLine().toString() << std::endl;
+                    return false;
                 }
+                VTK_PARSE_METADATA(tokenizer)
+            }
 
-                else if(!parsedOrigin && std::regex_match(line, match, originRegex))
-                {
-                    parsedOrigin = true;
-                    for(uint32_t j = 0; j < 3; j++)
-                        m_strPoints.origin[j] = std::stod(match[j+1].str());
-                    VTK_PARSE_METADATA(file)
-                }
-                else
+            //Parsing points
+            else if(!parsedPoints && token == "POINTS")
+            {
+                parsedPoints = true;
+                if(!tokenizer.nextNumber(m_grid.ptsPos.nbPoints) || !tokenizer.nextToken(token) || !tokenizer.isLineEnd())
                 {
-                    std::cerr << "Expecting a valid structured points token\n";
+                    std::cerr << "Error at dataset block : " << tokenizer.getLine().toString() << std::endl;
                     return false;
                 }
+                m_grid.ptsPos.format = vtkStringToFormat(token);
+                VTK_PARSE_ARRAY(tokenizer, 3*(size_t)m_grid.ptsPos.nbPoints, m_grid.ptsPos.format, m_grid.ptsPos.offset)
+                VTK_PARSE_END_OF_BLOCK(tokenizer)
+                VTK_PARSE_METADATA(tokenizer)
+            }
+            else
+            {
+                std::cerr << "Expecting a valid structured grid token\n";
+                return false;
             }
         }
-        catch(const std::exception& e)
+
+        //The connectivity is implicit : every point of the grid has to be given
+        if((uint64_t)m_grid.size[0]*m_grid.size[1]*m_grid.size[2] != m_grid.ptsPos.nbPoints)
         {
-            std::cerr << "Error while parsing structured points : " << e.what() << std::endl;
+            std::cerr << "The structured grid dimensions " << m_grid.size[0] << "x" << m_grid.size[1] << "x" << m_grid.size[2]
+                      << " do not match its " << m_grid.ptsPos.nbPoints << " points" << std::endl;
             return false;
         }
-
         return true;
     }
 
-    bool VTKParser::parseStructuredGrid(FILE* file)
-    {
-        return false;
-    }
-
-    bool VTKParser::parseMetadata(FILE* file)
+    bool VTKParser::parseMetadata(VTKTokenizer& tokenizer)
     {
-        std::string line;
-        std::smatch match;
+        VTKToken token;
+        uint32_t n;
         while(true)
         {
-            GET_VTK_NEXT_LINE(file)
-            if(line == "\n")
+            GET_VTK_NEXT_LINE(tokenizer)
+            if(!tokenizer.nextToken(token))
                 break;
 
-            else if(std::regex_match(line, match, informationRegex))
+            else if(token == "INFORMATION" && tokenizer.nextNumber(n) && tokenizer.isLineEnd())
             {}
 
-            else if(std::regex_match(line, match, nameLocationRegex))
+            else if(token == "NAME" && tokenizer.nextToken(token) && tokenizer.nextKeyword("LOCATION") && tokenizer.nextToken(token) && tokenizer.isLineEnd())
             {}
 
-            else if(std::regex_match(line, match, dataRegex))
-            {}
+            else if(token == "DATA" && tokenizer.nextNumber(n))
+            {
+                double v;
+                while(tokenizer.nextNumber(v))
+                {}
+                if(!tokenizer.isLineEnd())
+                {
+                    std::cerr << "Unexpecting token " << tokenizer.getLine().toString() << std::endl;
+                    return false;
+                }
+            }
 
             else
             {
-                std::cerr << "Unexpecting token " << line << std::endl;
+                std::cerr << "Unexpecting token " << tokenizer.getLine().toString() << std::endl;
                 return false;
             }
         }
         return true;
     }
 
-    bool VTKParser::parseValues(FILE* file, VTKData& data)
+    bool VTKParser::parseValues(VTKTokenizer& tokenizer, VTKData& data)
     {
-        std::smatch match;
+        VTKToken token;
         while(true)
         {
-            uint32_t    filePos = ftell(file);
-            std::string line    = getLineFromFile(file);
-            if(line.size() == 0) //EOF
+            size_t filePos = tokenizer.getCursor();
+            if(!tokenizer.nextLine()) //EOF
                 return true;
 
             //Checking for fields
-            else if(std::regex_match(line, match, fieldRegex))
+            else if(tokenizer.nextKeyword("FIELD") && tokenizer.nextToken(token))
             {
-                try
+                VTKValue value;
+                value.setType(VTK_FIELD_DATA);
+                value.fieldData.name = token.toString();
+
+                //Parse every field arrays
+                uint32_t nbField;
+                if(!tokenizer.nextNumber(nbField) || !tokenizer.isLineEnd())
                 {
-                    VTKValue value;
-                    value.setType(VTK_FIELD_DATA);
-                    value.fieldData.name = match[1].str();
+                    std::cerr << "Error at reading a field " << tokenizer.getLine().toString() << std::endl;
+                    return false;
+                }
 
-                    //Parse every field arrays
-                    uint32_t nbField = std::stoi(match[2].str());
-                    for(uint32_t i = 0; i < nbField; i++)
-                    {
-                        GET_VTK_NEXT_LINE(file)
-                        if(!std::regex_match(line, match, fieldValueRegex))
-                        {
-                            std::cerr << "Error at reading a field value\n" << line;
-                            return false;
-                        }
+                for(uint32_t i = 0; i < nbField; i++)
+                {
+                    GET_VTK_NEXT_LINE(tokenizer)
 
-                        VTKFieldValue fieldValue;
-                        fieldValue.name            = match[1].str();
-                        fieldValue.nbTuples        = std::stoi(match[3].str());
-                        fieldValue.nbValuePerTuple = std::stoi(match[2].str());
-                        fieldValue.format          = vtkStringToFormat(match[4].str());
-                        fieldValue.offset          = ftell(file);
+                    VTKFieldValue fieldValue;
+                    VTKToken      name;
+                    if(!tokenizer.nextToken(name) || !tokenizer.nextNumber(fieldValue.nbValuePerTuple) || !tokenizer.nextNumber(fieldValue.nbTuples) ||
+                       !tokenizer.nextToken(token) || !tokenizer.isLineEnd())
+                    {
+                        std::cerr << "Error at reading a field value\n" << tokenizer.getLine().toString() << std::endl;
+                        return false;
+                    }
 
-                        value.fieldData.values.push_back(fieldValue);
+                    fieldValue.name   = name.toString();
+                    fieldValue.format = vtkStringToFormat(token);
+                    VTK_PARSE_ARRAY(tokenizer, (size_t)fieldValue.nbTuples*fieldValue.nbValuePerTuple, fieldValue.format, fieldValue.offset)
+                    value.fieldData.values.push_back(fieldValue);
 
-                        fseek(file, fieldValue.nbTuples*fieldValue.nbValuePerTuple*VTKValueFormatInt(fieldValue.format), SEEK_CUR);
-                        char endLine;
-                        fread(&endLine, 1, 1, file);
-                        if(endLine != '\n')
-                            fseek(file, -1, SEEK_CUR);
+                    //The binary values are directly followed by a new line, the ASCII values end their line
+                    if(m_fileFormat == VTK_ASCII)
+                        VTK_PARSE_END_OF_BLOCK(tokenizer)
+                    else
+                        tokenizer.skipNewLine();
 
-                        VTK_PARSE_METADATA(file)
-                    }
-                    data.values.push_back(value);
-                }
-                catch(const std::exception& e)
-                {
-                    std::cerr << e.what() << std::endl;
-                    return false;
+                    VTK_PARSE_METADATA(tokenizer)
                 }
+                data.values.push_back(value);
             }
 
             else
             {
-                fseek(file, filePos, SEEK_SET);
+                tokenizer.setCursor(filePos);
                 break;
             }
         }
         return true;
     }
 
-#undef GET_VTK_NEXT_LINE
+    bool VTKParser::parseArrayValues(VTKTokenizer& tokenizer, size_t nbValues, VTKValueFormat format, size_t& offset)
+    {
+        size_t sizeFormat = VTKValueFormatInt(format);
+        if(m_fileFormat == VTK_BINARY)
+        {
+            offset = tokenizer.getCursor();
+            if(!tokenizer.skipBytes(nbValues*sizeFormat))
+            {
+                std::cerr << "Unexpected EOF\n";
+                return false;
+            }
+            return true;
+        }
 
+        if(sizeFormat == 0)
+        {
+            std::cerr << "Unknown ASCII values format\n";
+            return false;
+        }
 
-/*----------------------------------------------------------------------------*/
-/*-----------------------------Read data methods------------------------------*/
-/*----------------------------------------------------------------------------*/
-    void* VTKParser::parseAllUnstructuredGridPoints() const
-    {
-        return getAllBinaryValues(m_unstrGrid.ptsPos.offset, m_unstrGrid.ptsPos.nbPoints*3, m_unstrGrid.ptsPos.format);
-    }
+        //Split the text at white spaces in chunks, and count their values per window of chunks (in parallel) until nbValues is reached
+        const char*                text     = (const char*)m_data;
+        size_t                     start    = tokenizer.getCursor();
+        size_t                     pos      = start;
+        size_t                     nbTokens = 0;
+        size_t                     window   = m_threadPool->getNbThreads()*VTK_ASCII_CHUNKS_PER_THREAD;
+        std::vector<VTKAsciiChunk> chunks;
+        while(nbTokens < nbValues && pos < m_dataSize)
+        {
+            size_t firstChunk = chunks.size();
+            for(size_t i = 0; i < window && pos < m_dataSize; i++)
+            {
+                VTKAsciiChunk chunk;
+                chunk.begin = pos;
+                chunk.end   = std::min(pos + VTK_ASCII_CHUNK_SIZE, m_dataSize);
+                while(chunk.end < m_dataSize && !isAsciiSpace(text[chunk.end]))
+                    chunk.end++;
+                pos = chunk.end;
+                chunks.push_back(chunk);
+            }
 
-    int32_t* VTKParser::parseAllUnstructuredGridCellsComposition() const
-    {
-        return (int32_t*)getAllBinaryValues(m_unstrGrid.cells.offset, m_unstrGrid.cells.wholeSize, VTK_INT);
-    }
+            m_threadPool->parallelFor(chunks.size() - firstChunk, 1, [&](size_t begin, size_t end)
+            {
+                for(size_t i = firstChunk+begin; i < firstChunk+end; i++)
+                    chunks[i].nbTokens = countAsciiTokens(text + chunks[i].begin, text + chunks[i].end);
+            });
 
-    int32_t* VTKParser::parseAllUnstructuredGridCellTypes() const
-    {
-        return (int32_t*)getAllBinaryValues(m_unstrGrid.cellTypes.offset, m_unstrGrid.cellTypes.nbCells, VTK_INT);
-    }
+            for(size_t i = firstChunk; i < chunks.size(); i++)
+            {
+                chunks[i].firstValue = nbTokens;
+                nbTokens += chunks[i].nbTokens;
+                if(nbTokens >= nbValues)
+                {
+                    chunks.resize(i+1);
+                    break;
+                }
+            }
+        }
 
-    std::vector<std::string> VTKParser::getPointFieldValueNames() const
-    {
-        std::vector<std::string> res;
-        for(auto& it : m_ptsData.values)
-            if(it.type == VTK_FIELD_DATA)
-                for(auto& it2 : it.fieldData.values)
-                    res.push_back(it2.name);
-        return res;
-    }
+        if(nbTokens < nbValues)
+        {
+            std::cerr << "Unexpected EOF while reading " << nbValues << " ASCII values\n";
+            return false;
+        }
 
-    std::vector<const VTKFieldValue*> VTKParser::getPointFieldValueDescriptors() const
-    {
-        std::vector<const VTKFieldValue*> res;
-        for(auto& it : m_ptsData.values)
-            if(it.type == VTK_FIELD_DATA)
-                for(auto& it2 : it.fieldData.values)
-                    res.push_back(&it2);
-        return res;
-    }
+        //Parse the chunks in parallel. The values are stored as in a BINARY file (big endian), so that every reader handles both formats the same way
+        offset = m_asciiData.size();
+        m_asciiData.resize(offset + nbValues*sizeFormat);
 
-    std::vector<std::string> VTKParser::getCellFieldValueNames() const
-    {
-        std::vector<std::string> res;
-        for(auto& it : m_cellData.values)
-            if(it.type == VTK_FIELD_DATA)
-                for(auto& it2 : it.fieldData.values)
-                    res.push_back(it2.name);
-        return res;
-    }
+        uint8_t*          dest   = m_asciiData.data() + offset;
+        size_t            endPos = start;
+        std::atomic<bool> valid(true);
+        size_t            grain  = (pos - start < m_parallelThreshold ? chunks.size() : 1);
+        m_threadPool->parallelFor(chunks.size(), grain, [&](size_t begin, size_t end)
+        {
+            for(size_t i = begin; i < end && valid; i++)
+            {
+                const VTKAsciiChunk& chunk     = chunks[i];
+                size_t               n         = std::min(chunk.nbTokens, nbValues - chunk.firstValue);
+                uint8_t*             chunkDest = dest + chunk.firstValue*sizeFormat;
+                const char*          last      = parseAsciiValues(text + chunk.begin, text + chunk.end, chunkDest, format, n);
+                if(last == NULL)
+                {
+                    valid = false;
+                    return;
+                }
 
-    std::vector<const VTKFieldValue*> VTKParser::getCellFieldValueDescriptors() const
-    {
-        std::vector<const VTKFieldValue*> res;
-        for(auto& it : m_cellData.values)
-            if(it.type == VTK_FIELD_DATA)
-                for(auto& it2 : it.fieldData.values)
-                    res.push_back(&it2);
-        return res;
-    }
+                VTKByteSwap_bigEndianToHost(chunkDest, chunkDest, n, format);
+                if(i == chunks.size()-1)
+                    endPos = last - text;
+            }
+        });
 
-    void* VTKParser::parseAllFieldValues(const VTKFieldValue* fieldData) const
-    {
-        return getAllBinaryValues(fieldData->offset, fieldData->nbTuples*fieldData->nbValuePerTuple, fieldData->format);
+        if(!valid)
+        {
+            std::cerr << "Invalid ASCII value while reading " << nbValues << " values\n";
+            return false;
+        }
+        tokenizer.setCursor(endPos);
+        return true;
     }
 
-    VTKCellConstruction VTKParser::getCellConstructionDescriptor(uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes)
+#undef VTK_PARSE_METADATA
+#undef VTK_PARSE_END_OF_BLOCK
+#undef VTK_PARSE_ARRAY
+#undef GET_VTK_NEXT_LINE
+
+/*----------------------------------------------------------------------------*/
+/*---------------------------------Cache file---------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+    bool VTKParser::loadCache()
     {
-        VTKCellConstruction con;
-        con.mode    = VTK_GL_NO_MODE;
-        con.error   = 0;
-        con.size    = 0;
-        con.nbCells = 0;
-        con.next    = 0;
+        std::unique_ptr<VTKCache> cache(new VTKCache());
+        if(!cache->open(VTKCache::getCachePath(m_path, m_cacheDirectory), m_path))
+            return false;
 
-        for(uint32_t i = 0; i < nbCells; i++)
+        size_t         size;
+        const uint8_t* metadata = cache->getMetadata(&size);
+        if(!deserializeMetadata(metadata, size))
         {
-            //Determine which VTKCell to use
-            const VTKCellVT* cell = NULL;
-            switch (cellTypes[i])
-            {
-                case VTK_CELL_WEDGE:
-                    cell = &vtkWedge;
-                    break;
-                default:
-                    goto error;
+            std::cerr << "Corrupted cache file for " << m_path << ". Parsing the VTK file" << std::endl;
+            return false;
+        }
 
+        //ASCII files : rebuild the binary values read directly (cell index, cell streams) from the cached ones
+        if(m_fileFormat == VTK_ASCII)
+        {
+            std::vector<VTKCacheArray> arrays;
+            getCacheArrays(arrays);
+
+            size_t asciiSize = 0;
+            for(const VTKCacheArray& array : arrays)
+                asciiSize = std::max<size_t>(asciiSize, array.fileOffset + array.nbValues*VTKValueFormatInt(array.format));
+            m_asciiData.resize(asciiSize);
+
+            for(const VTKCacheArray& array : arrays)
+            {
+                size_t         size   = array.nbValues*VTKValueFormatInt(array.format);
+                const uint8_t* values = cache->getValues(array.fileOffset, size);
+                if(values == NULL)
+                {
+                    std::cerr << "Corrupted cache file for " << m_path << ". Parsing the VTK file" << std::endl;
+                    m_asciiData.clear();
+                    return false;
+                }
+                VTKByteSwap_bigEndianToHost(values, m_asciiData.data() + array.fileOffset, array.nbValues, array.format);
             }
+            useAsciiData();
+        }
 
-            //Check type
-            if(con.mode != VTK_GL_NO_MODE && con.mode != cell->getMode())
-                return con;
-            con.mode = cell->getMode();
+        m_cache = std::move(cache);
+        return true;
+    }
 
-            //Check nbPoints (error)
-            if (cell->nbPoints() > 0 && cellValues[0] != cell->nbPoints())
-                goto error;
+    void VTKParser::saveCache() const
+    {
+        std::string metadata;
+        serializeMetadata(metadata);
 
-            //add size, next and nbCell
-            con.size    += cell->sizeBuffer(cellValues);
-            con.next    += cellValues[0] + 1;
-            con.nbCells++;
-            cellValues  += cellValues[0] + 1;
-        }
+        std::vector<VTKCacheArray> arrays;
+        getCacheArrays(arrays);
 
-        return con;
-    error:
-        con.error = 1;
-        return con;
+        std::string cachePath = VTKCache::getCachePath(m_path, m_cacheDirectory);
+        bool saved = VTKCache::write(cachePath, m_path, metadata, arrays, [this](const VTKCacheArray& array, size_t firstValue, size_t nbValues, void* dest)
+        {
+            return decodeBinaryValues(array.fileOffset + firstValue*VTKValueFormatInt(array.format), nbValues, array.format, dest);
+        });
+        if(!saved)
+            std::cerr << "Could not write the cache file " << cachePath << std::endl;
     }
 
-    void VTKParser::fillUnstructuredGridCellBuffer(uint32_t nbCells, void* ptValues, int32_t* cellValues, int32_t* cellTypes, void* buffer, VTKValueFormat destFormat)
+    void VTKParser::serializeMetadata(std::string& metadata) const
     {
-        if(destFormat == VTK_NO_VALUE_FORMAT)
-            destFormat = m_unstrGrid.ptsPos.format;
+        VTKMetadataWriter writer{metadata};
+        writer.write(m_type);
+        writer.write(m_fileFormat);
+        writer.write(m_majorVer);
+        writer.write(m_minorVer);
+        writer.write(m_header);
 
-        uint32_t offset = 0;
-        for (uint32_t i = 0; i < nbCells; i++)
+        switch(m_type)
         {
-            //Determine which VTKCell to use
-            const VTKCellVT* cell = NULL;
-            switch (cellTypes[i])
-            {
-            case VTK_CELL_WEDGE:
-                cell = &vtkWedge;
+            case VTK_STRUCTURED_GRID:
+                writer.write(m_grid);
+                break;
+            case VTK_UNSTRUCTURED_GRID:
+                writer.write(m_unstrGrid);
+                break;
+            case VTK_STRUCTURED_POINTS:
+                writer.write(m_strPoints);
                 break;
             default:
-                return;
-            }
-
-            cell->fillBuffer(ptValues, m_unstrGrid.ptsPos.format, cellValues, (uint8_t*)buffer + offset, destFormat);
-            offset += cell->sizeBuffer(cellValues)*VTKValueFormatInt(destFormat);
+                break;
         }
-    }
-
-    void* VTKParser::getAllBinaryValues(size_t offset, uint32_t nbValues, VTKValueFormat format) const
-    {
-        int sizeFormat = VTKValueFormatInt(format);
-        uint8_t buffer[8];
-        fseek(m_file, offset, SEEK_SET);
-        uint8_t* data = (uint8_t*)malloc(sizeFormat*nbValues);
 
-        for(uint64_t i = 0; i < nbValues; i++)
+        for(const VTKData* data : {&m_ptsData, &m_cellData})
         {
-            fread(buffer, sizeFormat, 1, m_file);
-            switch(format)
+            writer.write(data->n);
+            writer.write((uint64_t)data->values.size());
+            for(const VTKValue& value : data->values)
             {
-                case VTK_INT:
-                {
-                    uint32_t val = readVTKValue<uint32_t>(buffer, VTK_INT);
-                    memcpy(data+i*sizeFormat, &val, sizeof(val));
-                    break;
-                }
-                case VTK_FLOAT:
-                {
-                    float val = readVTKValue<float>(buffer, VTK_FLOAT);
-                    memcpy(data+i*sizeFormat, &val, sizeof(val));
-                    break;
-                }
-                case VTK_DOUBLE:
+                writer.write(value.type);
+                if(value.type != VTK_FIELD_DATA)
+                    continue;
+
+                writer.write(value.fieldData.name);
+                writer.write((uint64_t)value.fieldData.values.size());
+                for(const VTKFieldValue& fieldValue : value.fieldData.values)
                 {
-                    double val = readVTKValue<double>(buffer, VTK_DOUBLE);
-                    memcpy(data+i*sizeFormat, &val, sizeof(val));
-                    break;
+                    writer.write(fieldValue.name);
+                    writer.write(fieldValue.format);
+                    writer.write(fieldValue.nbTuples);
+                    writer.write(fieldValue.nbValuePerTuple);
+                    writer.write(fieldValue.offset);
                 }
-                case VTK_UNSIGNED_CHAR:
-                case VTK_CHAR:
-                    data[i] = buffer[0];
-                    break;
-                default:
-                    free(data);
-                    return NULL;
             }
         }
-        return data;
     }
 
-    void VTKParser::fillUnstructuredGridCellElementBuffer(uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes, int32_t* buffer)
+    bool VTKParser::deserializeMetadata(const uint8_t* metadata, size_t size)
     {
-        uint32_t offset = 0;
-        for (uint32_t i = 0; i < nbCells; i++)
+        VTKMetadataReader reader{metadata, size};
+        VTKDatasetType    type = VTK_DATASET_TYPE_NONE;
+        reader.read(type);
+        reader.read(m_fileFormat);
+        reader.read(m_majorVer);
+        reader.read(m_minorVer);
+        reader.read(m_header);
+
+        m_type = type;
+        switch(m_type)
         {
-            //Determine which VTKCell to use
-            const VTKCellVT* cell = NULL;
-            switch (cellTypes[i])
-            {
-                case VTK_CELL_WEDGE:
-                    cell = &vtkWedge;
-                    break;
-                default:
+            case VTK_STRUCTURED_GRID:
+                reader.read(m_grid);
+                break;
+            case VTK_UNSTRUCTURED_GRID:
+                reader.read(m_unstrGrid);
+                m_cellIndex.clear();
+                break;
+            case VTK_STRUCTURED_POINTS:
+                reader.read(m_strPoints);
+                break;
+            default:
+                reader.valid = false;
+                break;
+        }
+
+        for(VTKData* data : {&m_ptsData, &m_cellData})
+        {
+            uint64_t nbValues = 0;
+            reader.read(data->n);
+            reader.read(nbValues);
+            data->values.clear();
+            for(uint64_t i = 0; i < nbValues && reader.valid; i++)
+            {
+                VTKValueType valueType = VTK_NO_VALUE_TYPE;
+                reader.read(valueType);
+
+                VTKValue value;
+                value.setType(valueType == VTK_FIELD_DATA ? VTK_FIELD_DATA : VTK_NO_VALUE_TYPE);
+                if(valueType == VTK_FIELD_DATA)
+                {
+                    uint64_t nbFieldValues = 0;
+                    reader.read(value.fieldData.name);
+                    reader.read(nbFieldValues);
+                    for(uint64_t j = 0; j < nbFieldValues && reader.valid; j++)
+                    {
+                        VTKFieldValue fieldValue;
+                        reader.read(fieldValue.name);
+                        reader.read(fieldValue.format);
+                        reader.read(fieldValue.nbTuples);
+                        reader.read(fieldValue.nbValuePerTuple);
+                        reader.read(fieldValue.offset);
+                        value.fieldData.values.push_back(fieldValue);
+                    }
+                }
+                data->values.push_back(value);
+            }
+        }
+
+        if(!reader.valid || reader.size != 0)
+        {
+            m_type = VTK_DATASET_TYPE_NONE;
+            m_ptsData.values.clear();
+            m_cellData.values.clear();
+            return false;
+        }
+        return true;
+    }
+
+    void VTKParser::adviseData(size_t offset, size_t size, bool willNeed) const
+    {
+#ifndef WIN32
+        //MADV_DONTNEED would zero the values of an ASCII file
+        if(offset >= m_dataSize || !isDataMapped())
+            return;
+        size = std::min(size, m_dataSize - offset);
+
+        //Prefetch the whole pages touched, release only the pages fully consumed
+        size_t pageSize = sysconf(_SC_PAGESIZE);
+        size_t begin    = (willNeed ? offset / pageSize : (offset + pageSize - 1) / pageSize) * pageSize;
+        size_t end      = (willNeed ? (offset + size + pageSize - 1) / pageSize : (offset + size) / pageSize) * pageSize;
+        if(end > begin)
+            madvise(m_data + begin, end - begin, (willNeed ? MADV_WILLNEED : MADV_DONTNEED));
+#endif
+    }
+
+    void VTKParser::getCacheArrays(std::vector<VTKCacheArray>& arrays) const
+    {
+        auto addArray = [&arrays](size_t offset, uint64_t nbValues, VTKValueFormat format)
+        {
+            if(nbValues > 0 && VTKValueFormatInt(format) != 0)
+                arrays.push_back(VTKCacheArray{offset, nbValues, format, 0});
+        };
+
+        switch(m_type)
+        {
+            case VTK_UNSTRUCTURED_GRID:
+                addArray(m_unstrGrid.ptsPos.offset, 3*(uint64_t)m_unstrGrid.ptsPos.nbPoints, m_unstrGrid.ptsPos.format);
+                addArray(m_unstrGrid.cells.offset, m_unstrGrid.cells.wholeSize, VTK_INT);
+                addArray(m_unstrGrid.cellTypes.offset, m_unstrGrid.cellTypes.nbCells, VTK_INT);
+                break;
+            case VTK_STRUCTURED_GRID:
+                addArray(m_grid.ptsPos.offset, 3*(uint64_t)m_grid.ptsPos.nbPoints, m_grid.ptsPos.format);
+                break;
+            default:
+                break;
+        }
+
+        for(const VTKData* data : {&m_ptsData, &m_cellData})
+            for(const VTKValue& value : data->values)
+                if(value.type == VTK_FIELD_DATA)
+                    for(const VTKFieldValue& fieldValue : value.fieldData.values)
+                        addArray(fieldValue.offset, (uint64_t)fieldValue.nbTuples*fieldValue.nbValuePerTuple, fieldValue.format);
+    }
+
+
+/*----------------------------------------------------------------------------*/
+/*-----------------------------Read data methods------------------------------*/
+/*----------------------------------------------------------------------------*/
+    void* VTKParser::parseAllUnstructuredGridPoints() const
+    {
+        return getAllBinaryValues(m_unstrGrid.ptsPos.offset, 3*(size_t)m_unstrGrid.ptsPos.nbPoints, m_unstrGrid.ptsPos.format);
+    }
+
+    int32_t* VTKParser::parseAllUnstructuredGridCellsComposition() const
+    {
+        return (int32_t*)getAllBinaryValues(m_unstrGrid.cells.offset, m_unstrGrid.cells.wholeSize, VTK_INT);
+    }
+
+    int32_t* VTKParser::parseAllUnstructuredGridCellTypes() const
+    {
+        return (int32_t*)getAllBinaryValues(m_unstrGrid.cellTypes.offset, m_unstrGrid.cellTypes.nbCells, VTK_INT);
+    }
+
+    bool VTKParser::parseAllUnstructuredGridPoints(void* dest, size_t capacity) const
+    {
+        return decodeBinaryValues(m_unstrGrid.ptsPos.offset, 3*(size_t)m_unstrGrid.ptsPos.nbPoints, m_unstrGrid.ptsPos.format, dest, capacity);
+    }
+
+    void* VTKParser::parseAllUnstructuredGridPoints(VTKValueFormat destFormat) const
+    {
+        size_t size = 3*(size_t)m_unstrGrid.ptsPos.nbPoints*VTKValueFormatInt(destFormat);
+        void*  data = malloc(size);
+        if(!parseAllUnstructuredGridPoints(data, size, destFormat))
+        {
+            free(data);
+            return NULL;
+        }
+        return data;
+    }
+
+    void* VTKParser::parseAllUnstructuredGridPoints(VTKComponentStats* bounds) const
+    {
+        VTKArrayRead read = getUnstructuredGridPointsRead();
+        read.stats = bounds;
+        return (parseArrays(&read, 1) ? read.dest : NULL);
+    }
+
+    bool VTKParser::parseAllUnstructuredGridPoints(void* dest, size_t capacity, VTKValueFormat destFormat) const
+    {
+        size_t nbValues = 3*(size_t)m_unstrGrid.ptsPos.nbPoints;
+        if(dest == NULL || VTKValueFormatInt(destFormat) == 0 || capacity/VTKValueFormatInt(destFormat) < nbValues)
+            return false;
+        return convertBinaryValues(m_unstrGrid.ptsPos.offset, nbValues, m_unstrGrid.ptsPos.format, dest, destFormat);
+    }
+
+    VTKArrayView<int32_t> VTKParser::parseAllUnstructuredGridCellsComposition(int32_t* dest, size_t capacity) const
+    {
+        if(!decodeBinaryValues(m_unstrGrid.cells.offset, m_unstrGrid.cells.wholeSize, VTK_INT, dest, capacity*sizeof(int32_t)))
+            return VTKArrayView<int32_t>();
+        return VTKArrayView<int32_t>(dest, m_unstrGrid.cells.wholeSize);
+    }
+
+    VTKArrayView<int32_t> VTKParser::parseAllUnstructuredGridCellTypes(int32_t* dest, size_t capacity) const
+    {
+        if(!decodeBinaryValues(m_unstrGrid.cellTypes.offset, m_unstrGrid.cellTypes.nbCells, VTK_INT, dest, capacity*sizeof(int32_t)))
+            return VTKArrayView<int32_t>();
+        return VTKArrayView<int32_t>(dest, m_unstrGrid.cellTypes.nbCells);
+    }
+
+    void* VTKParser::parseUnstructuredGridPoints(uint32_t firstPoint, uint32_t nbPoints) const
+    {
+        size_t size = 3*(size_t)nbPoints*VTKValueFormatInt(m_unstrGrid.ptsPos.format);
+        void*  data = malloc(size);
+        if(!parseUnstructuredGridPoints(firstPoint, nbPoints, data, size))
+        {
+            free(data);
+            return NULL;
+        }
+        return data;
+    }
+
+    bool VTKParser::parseUnstructuredGridPoints(uint32_t firstPoint, uint32_t nbPoints, void* dest, size_t capacity) const
+    {
+        const VTKPointPositions& pos = m_unstrGrid.ptsPos;
+        if((uint64_t)firstPoint + nbPoints > pos.nbPoints)
+            return false;
+        return decodeBinaryValues(pos.offset + 3*(size_t)firstPoint*VTKValueFormatInt(pos.format), 3*(size_t)nbPoints, pos.format, dest, capacity);
+    }
+
+    void* VTKParser::parseAllStructuredGridPoints() const
+    {
+        return getAllBinaryValues(m_grid.ptsPos.offset, 3*(size_t)m_grid.ptsPos.nbPoints, m_grid.ptsPos.format);
+    }
+
+    bool VTKParser::parseAllStructuredGridPoints(void* dest, size_t capacity) const
+    {
+        return decodeBinaryValues(m_grid.ptsPos.offset, 3*(size_t)m_grid.ptsPos.nbPoints, m_grid.ptsPos.format, dest, capacity);
+    }
+
+    void* VTKParser::parseAllStructuredGridPoints(VTKValueFormat destFormat) const
+    {
+        size_t size = 3*(size_t)m_grid.ptsPos.nbPoints*VTKValueFormatInt(destFormat);
+        void*  data = malloc(size);
+        if(!parseAllStructuredGridPoints(data, size, destFormat))
+        {
+            free(data);
+            return NULL;
+        }
+        return data;
+    }
+
+    void* VTKParser::parseAllStructuredGridPoints(VTKComponentStats* bounds) const
+    {
+        VTKArrayRead read = getStructuredGridPointsRead();
+        read.stats = bounds;
+        return (parseArrays(&read, 1) ? read.dest : NULL);
+    }
+
+    bool VTKParser::parseAllStructuredGridPoints(void* dest, size_t capacity, VTKValueFormat destFormat) const
+    {
+        size_t nbValues = 3*(size_t)m_grid.ptsPos.nbPoints;
+        if(dest == NULL || VTKValueFormatInt(destFormat) == 0 || capacity/VTKValueFormatInt(destFormat) < nbValues)
+            return false;
+        return convertBinaryValues(m_grid.ptsPos.offset, nbValues, m_grid.ptsPos.format, dest, destFormat);
+    }
+
+    void* VTKParser::parseStructuredGridPoints(uint32_t firstPoint, uint32_t nbPoints) const
+    {
+        size_t size = 3*(size_t)nbPoints*VTKValueFormatInt(m_grid.ptsPos.format);
+        void*  data = malloc(size);
+        if(!parseStructuredGridPoints(firstPoint, nbPoints, data, size))
+        {
+            free(data);
+            return NULL;
+        }
+        return data;
+    }
+
+    bool VTKParser::parseStructuredGridPoints(uint32_t firstPoint, uint32_t nbPoints, void* dest, size_t capacity) const
+    {
+        const VTKPointPositions& pos = m_grid.ptsPos;
+        if((uint64_t)firstPoint + nbPoints > pos.nbPoints)
+            return false;
+        return decodeBinaryValues(pos.offset + 3*(size_t)firstPoint*VTKValueFormatInt(pos.format), 3*(size_t)nbPoints, pos.format, dest, capacity);
+    }
+
+    uint32_t VTKParser::getStructuredGridNbCells() const
+    {
+        if(m_type != VTK_STRUCTURED_GRID)
+            return 0;
+
+        uint64_t nbCells = 1;
+        for(uint32_t i = 0; i < 3; i++)
+            nbCells *= std::max(m_grid.size[i], (uint32_t)2) - 1;
+        return (uint32_t)nbCells;
+    }
+
+    VTKCellType VTKParser::getStructuredGridCellType() const
+    {
+        uint32_t axes[3];
+        switch(getGridCellAxes(m_grid, axes))
+        {
+            case 3:
+                return VTK_CELL_HEXAHEDRON;
+            case 2:
+                return VTK_CELL_QUAD;
+            case 1:
+                return VTK_CELL_LINE;
+            default:
+                return VTK_CELL_VERTEX;
+        }
+    }
+
+    bool VTKParser::buildUnstructuredGridCellIndex()
+    {
+        const VTKCells& cells = m_unstrGrid.cells;
+        if(m_type != VTK_UNSTRUCTURED_GRID || cells.offset > m_dataSize || (m_dataSize - cells.offset)/sizeof(int32_t) < cells.wholeSize)
+            return false;
+
+        std::vector<uint32_t> index(cells.nbCells+1);
+        if(!buildCellIndexFromTypes(index) && !buildCellIndexFromCounts(index))
+            return false;
+
+        m_cellIndex = std::move(index);
+        return true;
+    }
+
+    bool VTKParser::buildCellIndexFromTypes(std::vector<uint32_t>& index) const
+    {
+        const VTKCells&     cells     = m_unstrGrid.cells;
+        const VTKCellTypes& cellTypes = m_unstrGrid.cellTypes;
+        if(cellTypes.nbCells != cells.nbCells || cellTypes.offset > m_dataSize || (m_dataSize - cellTypes.offset)/sizeof(int32_t) < cellTypes.nbCells)
+            return false;
+
+        const uint8_t* counts = m_data + cells.offset;
+        const uint8_t* types  = m_data + cellTypes.offset;
+        size_t         grain  = (cells.nbCells*sizeof(int32_t) < m_parallelThreshold ? cells.nbCells : VTK_DECODE_CHUNK_SIZE/sizeof(int32_t));
+        grain = std::max(grain, (size_t)1);
+
+        //First pass : the number of values per chunk of cells
+        std::vector<uint64_t> chunkSizes((cells.nbCells + grain - 1) / grain + 1, 0);
+        std::atomic<bool>     fixedSize(true);
+        m_threadPool->parallelFor(cells.nbCells, grain, [&](size_t begin, size_t end)
+        {
+            uint64_t size = 0;
+            for(size_t i = begin; i < end; i++)
+            {
+                int32_t nbPoints = VTKCellTypeInt((VTKCellType)readVTKValue<int32_t>((void*)(types + i*sizeof(int32_t)), VTK_INT));
+                if(nbPoints <= 0)
+                {
+                    fixedSize = false;
+                    return;
+                }
+                size += 1 + nbPoints;
+            }
+            chunkSizes[begin/grain+1] = size;
+        });
+        if(!fixedSize)
+            return false;
+
+        //Prefix sum of the chunks
+        for(size_t i = 1; i < chunkSizes.size(); i++)
+            chunkSizes[i] += chunkSizes[i-1];
+        if(chunkSizes.back() > cells.wholeSize)
+            return false;
+
+        //Second pass : the position of each cell, checked against the counts of the file
+        std::atomic<bool> valid(true);
+        m_threadPool->parallelFor(cells.nbCells, grain, [&](size_t begin, size_t end)
+        {
+            uint32_t value = (uint32_t)chunkSizes[begin/grain];
+            for(size_t i = begin; i < end; i++)
+            {
+                int32_t nbPoints = VTKCellTypeInt((VTKCellType)readVTKValue<int32_t>((void*)(types + i*sizeof(int32_t)), VTK_INT));
+                if(readVTKValue<int32_t>((void*)(counts + value*sizeof(int32_t)), VTK_INT) != nbPoints)
+                {
+                    valid = false;
+                    return;
+                }
+                index[i] = value;
+                value   += 1 + nbPoints;
+            }
+        });
+        index[cells.nbCells] = (uint32_t)chunkSizes.back();
+        return valid;
+    }
+
+    bool VTKParser::buildCellIndexFromCounts(std::vector<uint32_t>& index) const
+    {
+        const VTKCells& cells = m_unstrGrid.cells;
+        const uint8_t*  data  = m_data + cells.offset;
+        uint64_t        value = 0;
+        for(uint32_t i = 0; i < cells.nbCells; i++)
+        {
+            if(value >= cells.wholeSize)
+                return false;
+            index[i] = (uint32_t)value;
+            value   += 1 + (uint32_t)readVTKValue<int32_t>((void*)(data + value*sizeof(int32_t)), VTK_INT);
+        }
+
+        if(value > cells.wholeSize)
+            return false;
+        index[cells.nbCells] = (uint32_t)value;
+        return true;
+    }
+
+    /** \brief  Number of bits of each coordinate in a Morton code */
+    static const uint32_t VTK_MORTON_BITS = 21;
+
+    /** \brief  A Morton code and the point (or cell) it belongs to */
+    struct VTKMortonEntry
+    {
+        uint64_t code;  /*!< The Morton code*/
+        uint32_t index; /*!< The index of the point or of the cell*/
+    };
+
+    /* \brief Spread the VTK_MORTON_BITS bits of a value every 3 bits */
+    static uint64_t spreadMortonBits(uint64_t v)
+    {
+        v &= (1u << VTK_MORTON_BITS)-1;
+        v  = (v | v << 32) & 0x001f00000000ffffull;
+        v  = (v | v << 16) & 0x001f0000ff0000ffull;
+        v  = (v | v << 8)  & 0x100f00f00f00f00full;
+        v  = (v | v << 4)  & 0x10c30c30c30c30c3ull;
+        v  = (v | v << 2)  & 0x1249249249249249ull;
+        return v;
+    }
+
+    /* \brief Get the Morton code of a position quantized in a bounding box (NaN and out of the box coordinates are clamped) */
+    static uint64_t getMortonCode(const double pos[3], const double min[3], const double scale[3])
+    {
+        const double maxValue = (1u << VTK_MORTON_BITS)-1;
+        uint64_t     code     = 0;
+        for(uint32_t i = 0; i < 3; i++)
+        {
+            double q = (pos[i] - min[i])*scale[i];
+            q        = (q >= maxValue ? maxValue : (q > 0 ? q : 0.0));
+            code    |= spreadMortonBits((uint64_t)q) << i;
+        }
+        return code;
+    }
+
+    /** \brief  Number of bits of the Morton codes sorted per radix sort pass */
+    static const uint32_t VTK_MORTON_RADIX_BITS = 11;
+
+    /**
+     * \brief Sort Morton entries by code. Least significant digit first radix sort : stable, so equal codes keep their original order.
+     * The entries are split in blocks having their own histograms : the blocks are counted and scattered in parallel,
+     * each block writing after the same digits of the previous blocks. A range of the thread pool can hold several blocks
+     * \param entries the entries to sort
+     * \param pool the threads sorting the entries
+     * \param grain the minimum number of entries per block (entries.size() == sort on the calling thread)
+     */
+    static void sortMortonEntries(std::vector<VTKMortonEntry>& entries, VTKThreadPool& pool, size_t grain)
+    {
+        const uint32_t nbBuckets = 1u << VTK_MORTON_RADIX_BITS;
+        const uint32_t nbPasses  = (3*VTK_MORTON_BITS + VTK_MORTON_RADIX_BITS - 1) / VTK_MORTON_RADIX_BITS;
+        if(entries.empty())
+            return;
+
+        //A few blocks per thread : the histograms of all the blocks stay small
+        size_t n         = entries.size();
+        size_t blockSize = std::max(std::max(grain, (size_t)1), (n + 4*pool.getNbThreads() - 1) / (4*pool.getNbThreads()));
+        size_t nbBlocks  = (n + blockSize - 1) / blockSize;
+
+        //The histograms of every pass and every block in one read. They give the number of entries per digit of every pass,
+        //but those of a block only hold until the first scatter
+        std::vector<size_t> histograms(nbBlocks*nbPasses*nbBuckets, 0);
+        pool.parallelFor(n, blockSize, [&](size_t begin, size_t end)
+        {
+            for(size_t b = begin; b < end; b += blockSize)
+            {
+                size_t* histogram = &histograms[(b/blockSize)*nbPasses*nbBuckets];
+                for(size_t i = b; i < std::min(b + blockSize, end); i++)
+                    for(uint32_t p = 0; p < nbPasses; p++)
+                        histogram[p*nbBuckets + ((entries[i].code >> (p*VTK_MORTON_RADIX_BITS)) & (nbBuckets-1))]++;
+            }
+        });
+
+        std::vector<VTKMortonEntry> tmp(n);
+        bool                        scattered = false;
+        for(uint32_t p = 0; p < nbPasses; p++)
+        {
+            uint32_t shift = p*VTK_MORTON_RADIX_BITS;
+            auto getHistogram = [&](size_t block) {return &histograms[(block*nbPasses + p)*nbBuckets];};
+
+            //Every entry has the same digit
+            size_t sameDigit = 0;
+            for(size_t b = 0; b < nbBlocks; b++)
+                sameDigit += getHistogram(b)[(entries[0].code >> shift) & (nbBuckets-1)];
+            if(sameDigit == n)
+                continue;
+
+            //The blocks have changed since the first read
+            if(scattered)
+                pool.parallelFor(n, blockSize, [&](size_t begin, size_t end)
+                {
+                    for(size_t b = begin; b < end; b += blockSize)
+                    {
+                        size_t* histogram = getHistogram(b/blockSize);
+                        std::fill(histogram, histogram + nbBuckets, 0);
+                        for(size_t i = b; i < std::min(b + blockSize, end); i++)
+                            histogram[(entries[i].code >> shift) & (nbBuckets-1)]++;
+                    }
+                });
+
+            //Position of the first entry of each digit of each block
+            size_t sum = 0;
+            for(uint32_t i = 0; i < nbBuckets; i++)
+                for(size_t b = 0; b < nbBlocks; b++)
+                {
+                    size_t count       = getHistogram(b)[i];
+                    getHistogram(b)[i] = sum;
+                    sum               += count;
+                }
+
+            pool.parallelFor(n, blockSize, [&](size_t begin, size_t end)
+            {
+                for(size_t b = begin; b < end; b += blockSize)
+                {
+                    size_t* histogram = getHistogram(b/blockSize);
+                    for(size_t i = b; i < std::min(b + blockSize, end); i++)
+                        tmp[histogram[(entries[i].code >> shift) & (nbBuckets-1)]++] = entries[i];
+                }
+            });
+            entries.swap(tmp);
+            scattered = true;
+        }
+    }
+
+    bool VTKParser::getCellOffsets(uint32_t nbCells, const int32_t* cellValues, size_t nbValues, std::vector<size_t>& offsets)
+    {
+        offsets.resize(nbCells+1);
+        size_t value = 0;
+        for(uint32_t i = 0; i < nbCells; i++)
+        {
+            if(value >= nbValues || cellValues[value] < 0 || nbValues - value - 1 < (size_t)cellValues[value])
+                return false;
+            offsets[i] = value;
+            value     += 1 + cellValues[value];
+        }
+        offsets[nbCells] = value;
+        return true;
+    }
+
+    template <typename T>
+    bool VTKParser::computeMortonOrder(const T* points, uint32_t nbCells, const int32_t* cellValues, size_t nbValues, uint32_t* pointOrder, uint32_t* cellOrder) const
+    {
+        uint32_t nbPoints = m_unstrGrid.ptsPos.nbPoints;
+        size_t   grain    = ((size_t)nbPoints*3*sizeof(T) < m_parallelThreshold ? nbPoints : VTK_DECODE_CHUNK_SIZE/(3*sizeof(T)));
+        grain = std::max(grain, (size_t)1);
+
+        //Bounding box of the points : one box per block of grain points, merged afterward
+        std::vector<double> chunkBounds(6*((nbPoints + grain - 1) / grain));
+        m_threadPool->parallelFor(nbPoints, grain, [&](size_t begin, size_t end)
+        {
+            for(size_t b = begin; b < end; b += grain)
+            {
+                double* bounds = &chunkBounds[6*(b/grain)];
+                for(uint32_t i = 0; i < 3; i++)
+                {
+                    bounds[i]   = std::numeric_limits<double>::infinity();
+                    bounds[3+i] = -std::numeric_limits<double>::infinity();
+                }
+                for(size_t p = b; p < std::min(b + grain, end); p++)
+                    for(uint32_t i = 0; i < 3; i++)
+                    {
+                        double v = (double)points[3*p+i];
+                        bounds[i]   = std::min(bounds[i], v);
+                        bounds[3+i] = std::max(bounds[3+i], v);
+                    }
+            }
+        });
+
+        double min[3], max[3], scale[3];
+        for(uint32_t i = 0; i < 3; i++)
+        {
+            min[i] = std::numeric_limits<double>::infinity();
+            max[i] = -std::numeric_limits<double>::infinity();
+            for(size_t j = 0; j < chunkBounds.size(); j += 6)
+            {
+                min[i] = std::min(min[i], chunkBounds[j+i]);
+                max[i] = std::max(max[i], chunkBounds[j+3+i]);
+            }
+            double extent = max[i] - min[i];
+            scale[i] = (extent > 0 && extent < std::numeric_limits<double>::infinity() ? ((1u << VTK_MORTON_BITS)-1) / extent : 0.0);
+        }
+
+        //Points
+        std::vector<VTKMortonEntry> entries(nbPoints);
+        m_threadPool->parallelFor(nbPoints, grain, [&](size_t begin, size_t end)
+        {
+            for(size_t p = begin; p < end; p++)
+            {
+                double pos[3] = {(double)points[3*p], (double)points[3*p+1], (double)points[3*p+2]};
+                entries[p].code  = getMortonCode(pos, min, scale);
+                entries[p].index = p;
+            }
+        });
+        sortMortonEntries(entries, *m_threadPool, grain);
+        m_threadPool->parallelFor(nbPoints, grain, [&](size_t begin, size_t end)
+        {
+            for(size_t p = begin; p < end; p++)
+                pointOrder[p] = entries[p].index;
+        });
+
+        if(nbCells == 0)
+            return true;
+
+        //Cells, by their centroid
+        std::vector<size_t> offsets;
+        if(!getCellOffsets(nbCells, cellValues, nbValues, offsets))
+            return false;
+
+        std::atomic<bool> valid(true);
+        size_t cellGrain = (offsets.back()*sizeof(int32_t) < m_parallelThreshold ? nbCells : VTK_DECODE_CHUNK_SIZE/(4*sizeof(int32_t)));
+        cellGrain = std::max(cellGrain, (size_t)1);
+        entries.resize(nbCells);
+        m_threadPool->parallelFor(nbCells, cellGrain, [&](size_t begin, size_t end)
+        {
+            for(size_t c = begin; c < end; c++)
+            {
+                const int32_t* cell   = cellValues + offsets[c];
+                double         pos[3] = {0, 0, 0};
+                for(int32_t k = 1; k <= cell[0]; k++)
+                {
+                    if(cell[k] < 0 || (uint32_t)cell[k] >= nbPoints)
+                    {
+                        valid = false;
+                        return;
+                    }
+                    for(uint32_t i = 0; i < 3; i++)
+                        pos[i] += (double)points[3*(size_t)cell[k]+i];
+                }
+                for(uint32_t i = 0; i < 3 && cell[0] > 0; i++)
+                    pos[i] /= cell[0];
+
+                entries[c].code  = getMortonCode(pos, min, scale);
+                entries[c].index = c;
+            }
+        });
+        if(!valid)
+            return false;
+
+        sortMortonEntries(entries, *m_threadPool, cellGrain);
+        m_threadPool->parallelFor(nbCells, cellGrain, [&](size_t begin, size_t end)
+        {
+            for(size_t c = begin; c < end; c++)
+                cellOrder[c] = entries[c].index;
+        });
+        return true;
+    }
+
+    bool VTKParser::computeUnstructuredGridMortonOrder(const void* points, uint32_t nbCells, const int32_t* cellValues, size_t nbValues, uint32_t* pointOrder, uint32_t* cellOrder) const
+    {
+        if(m_type != VTK_UNSTRUCTURED_GRID || points == NULL || pointOrder == NULL || (nbCells > 0 && (cellValues == NULL || cellOrder == NULL)))
+            return false;
+
+        switch(m_unstrGrid.ptsPos.format)
+        {
+            case VTK_INT:
+                return computeMortonOrder((const int32_t*)points, nbCells, cellValues, nbValues, pointOrder, cellOrder);
+            case VTK_DOUBLE:
+                return computeMortonOrder((const double*)points, nbCells, cellValues, nbValues, pointOrder, cellOrder);
+            case VTK_FLOAT:
+                return computeMortonOrder((const float*)points, nbCells, cellValues, nbValues, pointOrder, cellOrder);
+            case VTK_UNSIGNED_CHAR:
+                return computeMortonOrder((const uint8_t*)points, nbCells, cellValues, nbValues, pointOrder, cellOrder);
+            case VTK_CHAR:
+                return computeMortonOrder((const int8_t*)points, nbCells, cellValues, nbValues, pointOrder, cellOrder);
+            default:
+                return false;
+        }
+    }
+
+    bool VTKParser::permuteTuples(const void* src, uint32_t nbTuples, size_t tupleSize, const uint32_t* order, void* dest) const
+    {
+        if(src == NULL || order == NULL || dest == NULL || src == dest)
+            return false;
+
+        std::atomic<bool> valid(true);
+        size_t grain = (nbTuples*tupleSize < m_parallelThreshold ? nbTuples : VTK_DECODE_CHUNK_SIZE/std::max(tupleSize, (size_t)1));
+        m_threadPool->parallelFor(nbTuples, std::max(grain, (size_t)1), [&](size_t begin, size_t end)
+        {
+            for(size_t i = begin; i < end; i++)
+            {
+                if(order[i] >= nbTuples)
+                {
+                    valid = false;
+                    return;
+                }
+                memcpy((uint8_t*)dest + i*tupleSize, (const uint8_t*)src + order[i]*tupleSize, tupleSize);
+            }
+        });
+        return valid;
+    }
+
+    bool VTKParser::remapUnstructuredGridCells(uint32_t nbCells, const int32_t* cellValues, size_t nbValues, uint32_t nbPoints, const uint32_t* pointOrder,
+                                               const uint32_t* cellOrder, int32_t* dest) const
+    {
+        if(cellValues == NULL || pointOrder == NULL || dest == NULL || cellValues == dest)
+            return false;
+
+        //The cells have to be walked in order to find where each of them begins
+        std::vector<size_t> offsets;
+        if(!getCellOffsets(nbCells, cellValues, nbValues, offsets))
+            return false;
+
+        //New index of every point. A point set twice (pointOrder not a permutation) is detected by the compare-exchange
+        std::atomic<bool>                  valid(true);
+        const uint32_t                     unset      = std::numeric_limits<uint32_t>::max();
+        size_t                             pointGrain = ((size_t)nbPoints*sizeof(uint32_t) < m_parallelThreshold ? nbPoints : VTK_DECODE_CHUNK_SIZE/sizeof(uint32_t));
+        std::vector<std::atomic<uint32_t>> remap(nbPoints);
+        pointGrain = std::max(pointGrain, (size_t)1);
+        m_threadPool->parallelFor(nbPoints, pointGrain, [&](size_t begin, size_t end)
+        {
+            for(size_t i = begin; i < end; i++)
+                remap[i].store(unset, std::memory_order_relaxed);
+        });
+        m_threadPool->parallelFor(nbPoints, pointGrain, [&](size_t begin, size_t end)
+        {
+            for(size_t i = begin; i < end; i++)
+            {
+                uint32_t expected = unset;
+                if(pointOrder[i] >= nbPoints || !remap[pointOrder[i]].compare_exchange_strong(expected, (uint32_t)i, std::memory_order_relaxed))
+                {
+                    valid = false;
+                    return;
+                }
+            }
+        });
+        if(!valid)
+            return false;
+
+        //Position of every reordered cell : sizes summed per chunk, then a prefix sum over the chunks, then over the cells of each chunk
+        std::vector<size_t> destOffsets;
+        size_t              grain = (offsets.back()*sizeof(int32_t) < m_parallelThreshold ? nbCells : VTK_DECODE_CHUNK_SIZE/(4*sizeof(int32_t)));
+        grain = std::max(grain, (size_t)1);
+        if(cellOrder)
+        {
+            std::vector<std::atomic<bool>> seen(nbCells);
+            std::vector<size_t>             chunkSizes((nbCells + grain - 1)/grain, 0);
+            m_threadPool->parallelFor(nbCells, grain, [&](size_t begin, size_t end)
+            {
+                for(size_t i = begin; i < end; i++)
+                    seen[i].store(false, std::memory_order_relaxed);
+            });
+            m_threadPool->parallelFor(nbCells, grain, [&](size_t begin, size_t end)
+            {
+                for(size_t i = begin; i < end; i++)
+                {
+                    uint32_t c = cellOrder[i];
+                    if(c >= nbCells || seen[c].exchange(true, std::memory_order_relaxed))
+                    {
+                        valid = false;
+                        return;
+                    }
+                    chunkSizes[i/grain] += offsets[c+1] - offsets[c];
+                }
+            });
+            if(!valid)
+                return false;
+
+            size_t sum = 0;
+            for(size_t& size : chunkSizes)
+            {
+                size_t chunkSize = size;
+                size             = sum;
+                sum             += chunkSize;
+            }
+
+            destOffsets.resize(nbCells);
+            m_threadPool->parallelFor(nbCells, grain, [&](size_t begin, size_t end)
+            {
+                size_t value = chunkSizes[begin/grain];
+                for(size_t i = begin; i < end; i++)
+                {
+                    destOffsets[i] = value;
+                    value         += offsets[cellOrder[i]+1] - offsets[cellOrder[i]];
+                }
+            });
+        }
+
+        m_threadPool->parallelFor(nbCells, grain, [&](size_t begin, size_t end)
+        {
+            for(size_t i = begin; i < end; i++)
+            {
+                const int32_t* cell = cellValues + offsets[cellOrder ? cellOrder[i] : i];
+                int32_t*       out  = dest + (cellOrder ? destOffsets[i] : offsets[i]);
+                out[0] = cell[0];
+                for(int32_t k = 1; k <= cell[0]; k++)
+                {
+                    if(cell[k] < 0 || (uint32_t)cell[k] >= nbPoints)
+                    {
+                        valid = false;
+                        return;
+                    }
+                    out[k] = remap[cell[k]].load(std::memory_order_relaxed);
+                }
+            }
+        });
+        return valid;
+    }
+
+    bool VTKParser::getUnstructuredGridCellsRange(uint32_t firstCell, uint32_t nbCells, uint32_t* firstValue, uint32_t* nbValues) const
+    {
+        const VTKCells& cells = m_unstrGrid.cells;
+        if((uint64_t)firstCell + nbCells > cells.nbCells || cells.offset > m_dataSize || (m_dataSize - cells.offset)/sizeof(int32_t) < cells.wholeSize)
+            return false;
+
+        if(!m_cellIndex.empty())
+        {
+            *firstValue = m_cellIndex[firstCell];
+            *nbValues   = m_cellIndex[firstCell+nbCells] - m_cellIndex[firstCell];
+            return true;
+        }
+
+        //Walk the counts
+        const uint8_t* data  = m_data + cells.offset;
+        uint64_t       value = 0;
+        for(uint32_t i = 0; i < firstCell+nbCells; i++)
+        {
+            if(i == firstCell)
+                *firstValue = (uint32_t)value;
+            if(value >= cells.wholeSize)
+                return false;
+            value += 1 + (uint32_t)readVTKValue<int32_t>((void*)(data + value*sizeof(int32_t)), VTK_INT);
+        }
+        if(nbCells == 0)
+            *firstValue = (uint32_t)value;
+
+        if(value > cells.wholeSize)
+            return false;
+        *nbValues = (uint32_t)(value - *firstValue);
+        return true;
+    }
+
+    int32_t* VTKParser::parseUnstructuredGridCellsComposition(uint32_t firstCell, uint32_t nbCells, uint32_t* nbValues) const
+    {
+        uint32_t first, nb;
+        if(!getUnstructuredGridCellsRange(firstCell, nbCells, &first, &nb))
+            return NULL;
+        if(nbValues)
+            *nbValues = nb;
+        return (int32_t*)getAllBinaryValues(m_unstrGrid.cells.offset + first*sizeof(int32_t), nb, VTK_INT);
+    }
+
+    VTKArrayView<int32_t> VTKParser::parseUnstructuredGridCellsComposition(uint32_t firstCell, uint32_t nbCells, int32_t* dest, size_t capacity) const
+    {
+        uint32_t first, nb;
+        if(!getUnstructuredGridCellsRange(firstCell, nbCells, &first, &nb) ||
+           !decodeBinaryValues(m_unstrGrid.cells.offset + first*sizeof(int32_t), nb, VTK_INT, dest, capacity*sizeof(int32_t)))
+            return VTKArrayView<int32_t>();
+        return VTKArrayView<int32_t>(dest, nb);
+    }
+
+    int32_t* VTKParser::parseUnstructuredGridCellTypes(uint32_t firstCell, uint32_t nbCells) const
+    {
+        if((uint64_t)firstCell + nbCells > m_unstrGrid.cellTypes.nbCells)
+            return NULL;
+        return (int32_t*)getAllBinaryValues(m_unstrGrid.cellTypes.offset + firstCell*sizeof(int32_t), nbCells, VTK_INT);
+    }
+
+    VTKArrayView<int32_t> VTKParser::parseUnstructuredGridCellTypes(uint32_t firstCell, uint32_t nbCells, int32_t* dest, size_t capacity) const
+    {
+        if((uint64_t)firstCell + nbCells > m_unstrGrid.cellTypes.nbCells ||
+           !decodeBinaryValues(m_unstrGrid.cellTypes.offset + firstCell*sizeof(int32_t), nbCells, VTK_INT, dest, capacity*sizeof(int32_t)))
+            return VTKArrayView<int32_t>();
+        return VTKArrayView<int32_t>(dest, nbCells);
+    }
+
+    std::vector<std::string> VTKParser::getPointFieldValueNames() const
+    {
+        std::vector<std::string> res;
+        for(auto& it : m_ptsData.values)
+            if(it.type == VTK_FIELD_DATA)
+                for(auto& it2 : it.fieldData.values)
+                    res.push_back(it2.name);
+        return res;
+    }
+
+    std::vector<const VTKFieldValue*> VTKParser::getPointFieldValueDescriptors() const
+    {
+        std::vector<const VTKFieldValue*> res;
+        for(auto& it : m_ptsData.values)
+            if(it.type == VTK_FIELD_DATA)
+                for(auto& it2 : it.fieldData.values)
+                    res.push_back(&it2);
+        return res;
+    }
+
+    std::vector<std::string> VTKParser::getCellFieldValueNames() const
+    {
+        std::vector<std::string> res;
+        for(auto& it : m_cellData.values)
+            if(it.type == VTK_FIELD_DATA)
+                for(auto& it2 : it.fieldData.values)
+                    res.push_back(it2.name);
+        return res;
+    }
+
+    std::vector<const VTKFieldValue*> VTKParser::getCellFieldValueDescriptors() const
+    {
+        std::vector<const VTKFieldValue*> res;
+        for(auto& it : m_cellData.values)
+            if(it.type == VTK_FIELD_DATA)
+                for(auto& it2 : it.fieldData.values)
+                    res.push_back(&it2);
+        return res;
+    }
+
+    void* VTKParser::parseAllFieldValues(const VTKFieldValue* fieldData) const
+    {
+        return getAllBinaryValues(fieldData->offset, (size_t)fieldData->nbTuples*fieldData->nbValuePerTuple, fieldData->format);
+    }
+
+    bool VTKParser::parseAllFieldValues(const VTKFieldValue* fieldData, void* dest, size_t capacity) const
+    {
+        return decodeBinaryValues(fieldData->offset, (size_t)fieldData->nbTuples*fieldData->nbValuePerTuple, fieldData->format, dest, capacity);
+    }
+
+    void* VTKParser::parseAllFieldValues(const VTKFieldValue* fieldData, VTKValueFormat destFormat, VTKQuantization* quantization) const
+    {
+        size_t size = (size_t)fieldData->nbTuples*fieldData->nbValuePerTuple*VTKValueFormatInt(destFormat);
+        void*  data = malloc(std::max<size_t>(1, size));
+        if(!parseAllFieldValues(fieldData, data, size, destFormat, quantization))
+        {
+            free(data);
+            return NULL;
+        }
+        return data;
+    }
+
+    bool VTKParser::parseAllFieldValues(const VTKFieldValue* fieldData, void* dest, size_t capacity, VTKValueFormat destFormat, VTKQuantization* quantization) const
+    {
+        size_t nbValues = (size_t)fieldData->nbTuples*fieldData->nbValuePerTuple;
+        if(dest == NULL || VTKValueFormatInt(destFormat) == 0 || capacity/VTKValueFormatInt(destFormat) < nbValues)
+            return false;
+        if(quantization)
+            return quantizeBinaryValues(fieldData->offset, nbValues, fieldData->format, dest, destFormat, quantization);
+        return convertBinaryValues(fieldData->offset, nbValues, fieldData->format, dest, destFormat);
+    }
+
+    void* VTKParser::parseAllFieldValues(const VTKFieldValue* fieldData, VTKComponentStats* stats) const
+    {
+        VTKArrayRead read = getFieldValuesRead(fieldData);
+        read.stats = stats;
+        return (parseArrays(&read, 1) ? read.dest : NULL);
+    }
+
+    bool VTKParser::parseAllFieldValues(const VTKFieldValue* fieldData, void* dest, size_t capacity, VTKComponentStats* stats) const
+    {
+        if(dest == NULL)
+            return false;
+        VTKArrayRead read = getFieldValuesRead(fieldData, dest, capacity);
+        read.stats = stats;
+        return parseArrays(&read, 1);
+    }
+
+    static VTKArrayRead makeArrayRead(size_t offset, size_t nbValues, VTKValueFormat format, uint32_t nbComponents, void* dest, size_t capacity)
+    {
+        VTKArrayRead read;
+        read.offset              = offset;
+        read.nbValues            = nbValues;
+        read.format              = format;
+        read.destFormat          = VTK_NO_VALUE_FORMAT;
+        read.dest                = dest;
+        read.capacity            = capacity;
+        read.normalize           = 0;
+        read.success             = 0;
+        read.quantization.scale  = 1.0;
+        read.quantization.offset = 0.0;
+        read.nbComponents        = nbComponents;
+        read.stats               = NULL;
+        return read;
+    }
+
+    VTKArrayRead VTKParser::getFieldValuesRead(const VTKFieldValue* fieldData, void* dest, size_t capacity)
+    {
+        return makeArrayRead(fieldData->offset, (size_t)fieldData->nbTuples*fieldData->nbValuePerTuple, fieldData->format, fieldData->nbValuePerTuple, dest, capacity);
+    }
+
+    VTKArrayRead VTKParser::getUnstructuredGridPointsRead(void* dest, size_t capacity) const
+    {
+        if(m_type != VTK_UNSTRUCTURED_GRID)
+            return makeArrayRead(0, 0, VTK_NO_VALUE_FORMAT, 0, dest, capacity);
+        return makeArrayRead(m_unstrGrid.ptsPos.offset, 3*(size_t)m_unstrGrid.ptsPos.nbPoints, m_unstrGrid.ptsPos.format, 3, dest, capacity);
+    }
+
+    VTKArrayRead VTKParser::getUnstructuredGridCellsRead(void* dest, size_t capacity) const
+    {
+        if(m_type != VTK_UNSTRUCTURED_GRID)
+            return makeArrayRead(0, 0, VTK_NO_VALUE_FORMAT, 0, dest, capacity);
+        return makeArrayRead(m_unstrGrid.cells.offset, m_unstrGrid.cells.wholeSize, VTK_INT, 1, dest, capacity);
+    }
+
+    VTKArrayRead VTKParser::getUnstructuredGridCellTypesRead(void* dest, size_t capacity) const
+    {
+        if(m_type != VTK_UNSTRUCTURED_GRID)
+            return makeArrayRead(0, 0, VTK_NO_VALUE_FORMAT, 0, dest, capacity);
+        return makeArrayRead(m_unstrGrid.cellTypes.offset, m_unstrGrid.cellTypes.nbCells, VTK_INT, 1, dest, capacity);
+    }
+
+    VTKArrayRead VTKParser::getStructuredGridPointsRead(void* dest, size_t capacity) const
+    {
+        if(m_type != VTK_STRUCTURED_GRID)
+            return makeArrayRead(0, 0, VTK_NO_VALUE_FORMAT, 0, dest, capacity);
+        return makeArrayRead(m_grid.ptsPos.offset, 3*(size_t)m_grid.ptsPos.nbPoints, m_grid.ptsPos.format, 3, dest, capacity);
+    }
+
+    bool VTKParser::parseArrays(VTKArrayRead* reads, size_t nbReads) const
+    {
+        //Check (and allocate) the reads, then sort them in the file order. The range of the normalized arrays is needed before decoding them
+        std::vector<size_t>         order;
+        std::vector<const uint8_t*> cached(nbReads, NULL);
+        std::vector<VTKValueFormat> destFormats(nbReads, VTK_NO_VALUE_FORMAT);
+        std::vector<VTKQuantizer>   quantizers(nbReads);
+        std::vector<size_t>         firstStats(nbReads, 0);
+        bool                        success = true;
+        for(size_t i = 0; i < nbReads; i++)
+        {
+            VTKArrayRead& read = reads[i];
+            destFormats[i]     = (read.destFormat == VTK_NO_VALUE_FORMAT ? read.format : read.destFormat);
+            size_t sizeFormat  = VTKValueFormatInt(read.format);
+            size_t sizeDest    = VTKValueFormatInt(destFormats[i]);
+            read.success = isFileFormat(read.format) && sizeDest != 0 && read.offset <= m_dataSize && (m_dataSize - read.offset)/sizeFormat >= read.nbValues &&
+                           (read.dest == NULL || read.capacity/sizeDest >= read.nbValues) && (read.stats == NULL || read.nbComponents > 0);
+            if(read.success && read.normalize)
+            {
+                double minVal, maxVal;
+                read.success = getBinaryValuesRange(read.offset, read.nbValues, read.format, &minVal, &maxVal) &&
+                               getQuantizer(minVal, maxVal, destFormats[i], &quantizers[i], &read.quantization);
+            }
+            if(read.success && read.dest == NULL)
+            {
+                read.dest     = malloc(std::max<size_t>(1, read.nbValues*sizeDest));
+                read.capacity = read.nbValues*sizeDest;
+                read.success  = (read.dest != NULL);
+            }
+
+            if(!read.success)
+            {
+                success = false;
+                continue;
+            }
+            cached[i] = getCachedValues(read.offset, read.nbValues*sizeFormat);
+            order.push_back(i);
+        }
+        std::sort(order.begin(), order.end(), [reads](size_t a, size_t b){return reads[a].offset < reads[b].offset;});
+
+        //Split the arrays in chunks, and the chunks in windows. Each chunk of an array having statistics accumulates them in its own nbComponents accumulators
+        static const size_t NO_STATS = std::numeric_limits<size_t>::max();
+        struct Chunk
+        {
+            size_t read;     /*!< The read*/
+            size_t first;    /*!< The first value of the chunk*/
+            size_t nbValues; /*!< The number of values of the chunk*/
+            size_t stats;    /*!< The first accumulator of the chunk. NO_STATS if the statistics are not computed*/
+        };
+        std::vector<Chunk>               chunks;
+        std::vector<VTKStatsAccumulator> accumulators;
+        std::vector<size_t>              windows;     //The end of each window in chunks
+        std::vector<size_t>              windowSizes; //The size (in bytes) of each window
+        size_t                           windowSize = 0;
+        for(size_t i : order)
+        {
+            size_t sizeFormat = VTKValueFormatInt(reads[i].format);
+            size_t grain      = std::max<size_t>(1, VTK_DECODE_CHUNK_SIZE/sizeFormat);
+            firstStats[i]     = accumulators.size();
+            for(size_t j = 0; j < reads[i].nbValues; j += grain)
+            {
+                size_t stats = NO_STATS;
+                if(reads[i].stats)
+                {
+                    stats = accumulators.size();
+                    accumulators.resize(stats + reads[i].nbComponents);
+                }
+                chunks.push_back(Chunk{i, j, std::min(grain, reads[i].nbValues - j), stats});
+                windowSize += chunks.back().nbValues*sizeFormat;
+                if(windowSize >= VTK_BATCH_WINDOW_SIZE)
+                {
+                    windows.push_back(chunks.size());
+                    windowSizes.push_back(windowSize);
+                    windowSize = 0;
+                }
+            }
+        }
+        if(windowSize > 0)
+        {
+            windows.push_back(chunks.size());
+            windowSizes.push_back(windowSize);
+        }
+
+        //Prefetch the values of a window read from the VTK file. Chunks separated by less than a chunk (e.g., a few words of text) are prefetched at once
+        auto adviseWindow = [&](size_t begin, size_t end)
+        {
+            size_t rangeBegin = 0;
+            size_t rangeEnd   = 0;
+            for(size_t i = begin; i < end; i++)
+            {
+                const VTKArrayRead& read = reads[chunks[i].read];
+                if(cached[chunks[i].read])
+                    continue;
+
+                size_t sizeFormat = VTKValueFormatInt(read.format);
+                size_t offset     = read.offset + chunks[i].first*sizeFormat;
+                if(rangeEnd > rangeBegin && offset <= rangeEnd + VTK_DECODE_CHUNK_SIZE)
+                {
+                    rangeEnd = std::max(rangeEnd, offset + chunks[i].nbValues*sizeFormat);
+                    continue;
+                }
+                if(rangeEnd > rangeBegin)
+                    adviseData(rangeBegin, rangeEnd - rangeBegin, true);
+                rangeBegin = offset;
+                rangeEnd   = offset + chunks[i].nbValues*sizeFormat;
+            }
+            if(rangeEnd > rangeBegin)
+                adviseData(rangeBegin, rangeEnd - rangeBegin, true);
+        };
+
+        //Converted chunks are decoded in a temporary buffer first (kept in cache), except the chunks of the cache file (already in the host endianness).
+        //The statistics are accumulated on the decoded values while they are still in cache
+        auto decodeChunks = [&](size_t begin, size_t end)
+        {
+            std::vector<uint8_t> tmp;
+            for(size_t i = begin; i < end; i++)
+            {
+                const Chunk&        chunk      = chunks[i];
+                const VTKArrayRead& read       = reads[chunk.read];
+                VTKValueFormat      destFormat = destFormats[chunk.read];
+                size_t              sizeFormat = VTKValueFormatInt(read.format);
+                uint8_t*            dest       = (uint8_t*)read.dest + chunk.first*VTKValueFormatInt(destFormat);
+                const uint8_t*      src        = (cached[chunk.read] ? cached[chunk.read] : m_data + read.offset) + chunk.first*sizeFormat;
+                if(destFormat == read.format && !read.normalize)
+                {
+                    if(cached[chunk.read])
+                        memcpy(dest, src, chunk.nbValues*sizeFormat);
+                    else
+                        VTKByteSwap_bigEndianToHost(src, dest, chunk.nbValues, read.format);
+                    src = dest;
+                }
+                else
+                {
+                    if(!cached[chunk.read])
+                    {
+                        tmp.resize(VTK_DECODE_CHUNK_SIZE);
+                        VTKByteSwap_bigEndianToHost(src, tmp.data(), chunk.nbValues, read.format);
+                        src = tmp.data();
+                    }
+                    if(read.normalize)
+                        quantizeValues(src, read.format, dest, destFormat, chunk.nbValues, quantizers[chunk.read]);
+                    else
+                        convertValues(src, read.format, dest, destFormat, chunk.nbValues);
+                }
+
+                if(chunk.stats != NO_STATS)
+                    accumulateStats(src, read.format, chunk.nbValues, chunk.first % read.nbComponents, read.nbComponents, &accumulators[chunk.stats]);
+            }
+        };
+
+        //Sweep the file forward, window per window
+        size_t begin = 0;
+        if(!windows.empty())
+            adviseWindow(0, windows[0]);
+        for(size_t i = 0; i < windows.size(); i++)
+        {
+            size_t end = windows[i];
+            if(i+1 < windows.size())
+                adviseWindow(end, windows[i+1]);
+
+            if(windowSizes[i] < m_parallelThreshold)
+                decodeChunks(begin, end);
+            else
+                m_threadPool->parallelFor(end - begin, 1, [&](size_t first, size_t last){decodeChunks(begin + first, begin + last);});
+            begin = end;
+        }
+
+        //Merge the statistics of the chunks of each array
+        for(size_t i : order)
+        {
+            const VTKArrayRead& read = reads[i];
+            if(read.stats == NULL)
+                continue;
+            size_t grain    = std::max<size_t>(1, VTK_DECODE_CHUNK_SIZE/VTKValueFormatInt(read.format));
+            size_t nbChunks = (read.nbValues + grain - 1)/grain;
+            for(uint32_t j = 0; j < read.nbComponents; j++)
+                mergeStats(accumulators.data() + firstStats[i] + j, nbChunks, read.nbComponents, &read.stats[j]);
+        }
+        return success;
+    }
+
+    void* VTKParser::parseFieldValues(const VTKFieldValue* fieldData, uint32_t firstTuple, uint32_t nbTuples, uint32_t firstComponent, uint32_t nbComponents) const
+    {
+        if(nbComponents == 0 && firstComponent < fieldData->nbValuePerTuple)
+            nbComponents = fieldData->nbValuePerTuple - firstComponent;
+
+        size_t size = (size_t)nbTuples*nbComponents*VTKValueFormatInt(fieldData->format);
+        void*  data = malloc(size);
+        if(!parseFieldValues(fieldData, firstTuple, nbTuples, data, size, firstComponent, nbComponents))
+        {
+            free(data);
+            return NULL;
+        }
+        return data;
+    }
+
+    bool VTKParser::parseFieldValues(const VTKFieldValue* fieldData, uint32_t firstTuple, uint32_t nbTuples, void* dest, size_t capacity,
+                                     uint32_t firstComponent, uint32_t nbComponents) const
+    {
+        if(nbComponents == 0 && firstComponent < fieldData->nbValuePerTuple)
+            nbComponents = fieldData->nbValuePerTuple - firstComponent;
+
+        size_t sizeFormat = VTKValueFormatInt(fieldData->format);
+        if((uint64_t)firstTuple + nbTuples > fieldData->nbTuples || (uint64_t)firstComponent + nbComponents > fieldData->nbValuePerTuple ||
+           nbComponents == 0 || sizeFormat == 0 || dest == NULL || capacity/sizeFormat/nbComponents < nbTuples)
+            return false;
+
+        return decodeBinaryTuples(fieldData->offset + (size_t)firstTuple*fieldData->nbValuePerTuple*sizeFormat, nbTuples,
+                                  fieldData->nbValuePerTuple, firstComponent, nbComponents, fieldData->format, dest);
+    }
+
+    bool VTKParser::getStructuredPointsSubVolumeDescriptor(const VTKSubVolume& box, VTKStructuredPoints* descriptor) const
+    {
+        if(m_type != VTK_STRUCTURED_POINTS)
+            return false;
+
+        VTKStructuredPoints sub;
+        for(uint32_t i = 0; i < 3; i++)
+        {
+            if(box.step[i] == 0 || box.first[i] > box.last[i] || box.last[i] >= m_strPoints.size[i])
+                return false;
+            sub.size[i]    = (box.last[i] - box.first[i]) / box.step[i] + 1;
+            sub.spacing[i] = m_strPoints.spacing[i]*box.step[i];
+            sub.origin[i]  = m_strPoints.origin[i] + box.first[i]*m_strPoints.spacing[i];
+        }
+
+        if(descriptor)
+            *descriptor = sub;
+        return true;
+    }
+
+    void* VTKParser::parseStructuredPointsFieldValues(const VTKFieldValue* fieldData, const VTKSubVolume& box, VTKStructuredPoints* descriptor) const
+    {
+        VTKStructuredPoints sub;
+        if(!getStructuredPointsSubVolumeDescriptor(box, &sub))
+            return NULL;
+
+        size_t size = (size_t)sub.size[0]*sub.size[1]*sub.size[2]*fieldData->nbValuePerTuple*VTKValueFormatInt(fieldData->format);
+        void*  data = malloc(size);
+        if(!parseStructuredPointsFieldValues(fieldData, box, data, size, descriptor))
+        {
+            free(data);
+            return NULL;
+        }
+        return data;
+    }
+
+    bool VTKParser::parseStructuredPointsFieldValues(const VTKFieldValue* fieldData, const VTKSubVolume& box, void* dest, size_t capacity, VTKStructuredPoints* descriptor) const
+    {
+        VTKStructuredPoints sub;
+        const uint32_t*     size       = m_strPoints.size;
+        size_t              sizeFormat = VTKValueFormatInt(fieldData->format);
+        size_t              tupleSize  = fieldData->nbValuePerTuple*sizeFormat;
+        if(!getStructuredPointsSubVolumeDescriptor(box, &sub) || tupleSize == 0 || (uint64_t)size[0]*size[1]*size[2] != fieldData->nbTuples ||
+           fieldData->offset > m_dataSize || (m_dataSize - fieldData->offset)/tupleSize < fieldData->nbTuples)
+            return false;
+
+        size_t rowSize = sub.size[0]*tupleSize;
+        size_t nbRows  = (size_t)sub.size[1]*sub.size[2];
+        if(dest == NULL || capacity/rowSize < nbRows)
+            return false;
+
+        //Rows of the box : whole runs of tuples when every tuple is read, one tuple every step[0] otherwise
+        const uint8_t* cached = getCachedValues(fieldData->offset, fieldData->nbTuples*tupleSize);
+        const uint8_t* src    = (cached ? cached : m_data + fieldData->offset);
+        auto decodeRows = [&](size_t begin, size_t end)
+        {
+            size_t runSize = (box.step[0] == 1 ? rowSize : tupleSize);
+            for(size_t r = begin; r < end; r++)
+            {
+                uint64_t       j   = box.first[1] + (r % sub.size[1])*box.step[1];
+                uint64_t       k   = box.first[2] + (r / sub.size[1])*box.step[2];
+                const uint8_t* row = src + ((k*size[1] + j)*size[0] + box.first[0])*tupleSize;
+                uint8_t*       out = (uint8_t*)dest + r*rowSize;
+                for(size_t i = 0; i < rowSize; i += runSize)
+                {
+                    const uint8_t* run = row + (i/tupleSize)*box.step[0]*tupleSize;
+                    if(cached)
+                        memcpy(out + i, run, runSize);
+                    else
+                        VTKByteSwap_bigEndianToHost(run, out + i, runSize/sizeFormat, fieldData->format);
+                }
+            }
+        };
+
+        if(nbRows*rowSize < m_parallelThreshold)
+            decodeRows(0, nbRows);
+        else
+            m_threadPool->parallelFor(nbRows, std::max<size_t>(1, VTK_DECODE_CHUNK_SIZE/rowSize), decodeRows);
+
+        if(descriptor)
+            *descriptor = sub;
+        return true;
+    }
+
+    VTKCellConstruction VTKParser::getCellConstructionDescriptor(uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes)
+    {
+        VTKCellConstruction con;
+        con.mode    = VTK_GL_NO_MODE;
+        con.error   = 0;
+        con.size    = 0;
+        con.nbCells = 0;
+        con.next    = 0;
+
+        for(uint32_t i = 0; i < nbCells; i++)
+        {
+            //Determine which VTKCell to use
+            const VTKCellVT* cell = VTKCell_getVT(cellTypes[i]);
+            if(cell == NULL)
+                goto error;
+
+            //Check type
+            if(con.mode != VTK_GL_NO_MODE && con.mode != cell->getMode())
+                return con;
+            con.mode = cell->getMode();
+
+            //Check nbPoints (error)
+            if (cell->nbPoints() > 0 && cellValues[0] != cell->nbPoints())
+                goto error;
+
+            //add size, next and nbCell
+            con.size    += cell->sizeBuffer(cellValues);
+            con.next    += cellValues[0] + 1;
+            con.nbCells++;
+            cellValues  += cellValues[0] + 1;
+        }
+
+        return con;
+    error:
+        con.error = 1;
+        return con;
+    }
+
+    VTKMultiCellConstruction VTKParser::getMultiCellConstructionDescriptor(uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes)
+    {
+        VTKMultiCellConstruction con;
+        memset(&con, 0, sizeof(con));
+
+        for(uint32_t i = 0; i < nbCells; i++)
+        {
+            const VTKCellVT* cell = VTKCell_getVT(cellTypes[i]);
+            if(cell == NULL || (cell->nbPoints() > 0 && cellValues[0] != cell->nbPoints()))
+            {
+                con.error = 1;
+                break;
+            }
+
+            VTKGLMode mode = cell->getMode();
+            con.size[mode] += cell->sizeBuffer(cellValues);
+            con.nbCells[mode]++;
+            con.nbParsedCells++;
+            con.next   += cellValues[0] + 1;
+            cellValues += cellValues[0] + 1;
+        }
+
+        for(uint32_t m = 1; m < VTK_GL_NO_MODE; m++)
+            con.offset[m] = con.offset[m-1] + con.size[m-1];
+        return con;
+    }
+
+    size_t VTKParser::planCellFill(uint32_t nbCells, const int32_t* cellValues, const int32_t* cellTypes, std::vector<CellChunk>& chunks, VTKGLMode mode,
+                                   size_t* modeSizes) const
+    {
+        //Locate each chunk in cellValues (the counts are walked)
+        chunks.resize((nbCells + VTK_FILL_CHUNK_NB_CELLS - 1) / VTK_FILL_CHUNK_NB_CELLS);
+        for(size_t c = 0; c < chunks.size(); c++)
+        {
+            CellChunk& chunk = chunks[c];
+            chunk.cellValues = cellValues;
+            chunk.firstCell  = c*VTK_FILL_CHUNK_NB_CELLS;
+            chunk.nbCells    = std::min(VTK_FILL_CHUNK_NB_CELLS, nbCells - chunk.firstCell);
+            for(uint32_t i = 0; i < chunk.nbCells; i++)
+                cellValues += cellValues[0] + 1;
+        }
+
+        //The size of each chunk
+        m_threadPool->parallelFor(chunks.size(), 1, [&](size_t begin, size_t end)
+        {
+            for(size_t c = begin; c < end; c++)
+            {
+                CellChunk&     chunk  = chunks[c];
+                const int32_t* values = chunk.cellValues;
+                size_t         size   = 0;
+                std::fill(chunk.modeOffsets, chunk.modeOffsets+VTK_GL_NO_MODE, 0);
+                for(uint32_t i = 0; i < chunk.nbCells; i++)
+                {
+                    const VTKCellVT* cell = VTKCell_getVT(cellTypes[chunk.firstCell+i]);
+                    if(cell == NULL)
+                    {
+                        chunk.nbCells = i;
+                        break;
+                    }
+                    uint32_t  cellSize = cell->sizeBuffer((int32_t*)values);
+                    VTKGLMode cellMode = cell->getMode();
+                    if(mode == VTK_GL_NO_MODE || cellMode == mode)
+                        size += cellSize;
+                    chunk.modeOffsets[cellMode] += cellSize;
+                    values += values[0] + 1;
+                }
+                chunk.bufferOffset = size;
+            }
+        });
+
+        //Prefix sum, stopping at the first cell not supported
+        size_t offset = 0;
+        size_t modeOffsets[VTK_GL_NO_MODE] = {0};
+        for(size_t c = 0; c < chunks.size(); c++)
+        {
+            size_t size = chunks[c].bufferOffset;
+            chunks[c].bufferOffset = offset;
+            offset += size;
+
+            for(uint32_t m = 0; m < VTK_GL_NO_MODE; m++)
+            {
+                size_t modeSize = chunks[c].modeOffsets[m];
+                chunks[c].modeOffsets[m] = modeOffsets[m];
+                modeOffsets[m] += modeSize;
+            }
+
+            if(chunks[c].nbCells != std::min(VTK_FILL_CHUNK_NB_CELLS, nbCells - chunks[c].firstCell))
+            {
+                chunks.resize(c+1);
+                break;
+            }
+        }
+
+        if(modeSizes)
+            std::copy(modeOffsets, modeOffsets+VTK_GL_NO_MODE, modeSizes);
+        return offset;
+    }
+
+    void VTKParser::runCellChunks(const std::vector<CellChunk>& chunks, size_t bufferSize, const std::function<void(const CellChunk&)>& func) const
+    {
+        if(bufferSize < m_parallelThreshold)
+        {
+            for(const CellChunk& chunk : chunks)
+                func(chunk);
+            return;
+        }
+
+        m_threadPool->parallelFor(chunks.size(), 1, [&](size_t begin, size_t end)
+        {
+            for(size_t c = begin; c < end; c++)
+                func(chunks[c]);
+        });
+    }
+
+    bool VTKParser::checkCellFillFormats(VTKValueFormat destFormat) const
+    {
+        if(VTKCell_getFillBuffers(&vtkVertex, m_unstrGrid.ptsPos.format, destFormat) == NULL)
+        {
+            std::cerr << "Cannot fill a cell buffer from the points format " << m_unstrGrid.ptsPos.format << " to the format " << destFormat << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    uint32_t VTKParser::getCellTypeRun(const int32_t* cellTypes, uint32_t nbCells)
+    {
+        uint32_t run = 1;
+        while(run < nbCells && cellTypes[run] == cellTypes[0])
+            run++;
+        return run;
+    }
+
+    void VTKParser::fillUnstructuredGridCellBuffer(uint32_t nbCells, void* ptValues, int32_t* cellValues, int32_t* cellTypes, void* buffer, VTKValueFormat destFormat)
+    {
+        if(destFormat == VTK_NO_VALUE_FORMAT)
+            destFormat = m_unstrGrid.ptsPos.format;
+
+        if(!checkCellFillFormats(destFormat))
+            return;
+
+        std::vector<CellChunk> chunks;
+        size_t vertexSize = 3*VTKValueFormatInt(destFormat);
+        size_t size       = planCellFill(nbCells, cellValues, cellTypes, chunks);
+
+        runCellChunks(chunks, size*vertexSize, [&](const CellChunk& chunk)
+        {
+            int32_t* values = (int32_t*)chunk.cellValues;
+            uint8_t* dest   = (uint8_t*)buffer + chunk.bufferOffset*vertexSize;
+
+            //The kernel is selected once per run of cells sharing the same type
+            for(uint32_t i = 0; i < chunk.nbCells;)
+            {
+                uint32_t run = getCellTypeRun(cellTypes + chunk.firstCell + i, chunk.nbCells - i);
+                VTKCELL_FILLBUFFERS fill = VTKCell_getFillBuffers(VTKCell_getVT(cellTypes[chunk.firstCell+i]), m_unstrGrid.ptsPos.format, destFormat);
+                dest += fill(ptValues, &values, run, dest)*vertexSize;
+                i    += run;
+            }
+        });
+    }
+
+    void* VTKParser::getAllBinaryValues(size_t offset, size_t nbValues, VTKValueFormat format) const
+    {
+        uint8_t* data = (uint8_t*)malloc(VTKValueFormatInt(format)*nbValues);
+        if(!decodeBinaryValues(offset, nbValues, format, data))
+        {
+            free(data);
+            return NULL;
+        }
+        return data;
+    }
+
+    bool VTKParser::decodeBinaryValues(size_t offset, size_t nbValues, VTKValueFormat format, void* dest, size_t capacity) const
+    {
+        if(dest == NULL || VTKValueFormatInt(format) == 0 || capacity/VTKValueFormatInt(format) < nbValues)
+            return false;
+        return decodeBinaryValues(offset, nbValues, format, dest);
+    }
+
+    bool VTKParser::decodeBinaryValues(size_t offset, size_t nbValues, VTKValueFormat format, void* dest) const
+    {
+        size_t sizeFormat = VTKValueFormatInt(format);
+        if(sizeFormat == 0 || offset > m_dataSize || (m_dataSize - offset)/sizeFormat < nbValues)
+            return false;
+
+        //Values already in the host endianness (cache file) are only copied
+        const uint8_t* cached = getCachedValues(offset, nbValues*sizeFormat);
+        const uint8_t* src    = (cached ? cached : m_data + offset);
+        auto decodeRange = [&](size_t begin, size_t end)
+        {
+            if(cached)
+                memcpy((uint8_t*)dest + begin*sizeFormat, src + begin*sizeFormat, (end-begin)*sizeFormat);
+            else
+                VTKByteSwap_bigEndianToHost(src + begin*sizeFormat, (uint8_t*)dest + begin*sizeFormat, end-begin, format);
+        };
+
+        if(nbValues*sizeFormat < m_parallelThreshold)
+            decodeRange(0, nbValues);
+        else
+            m_threadPool->parallelFor(nbValues, VTK_DECODE_CHUNK_SIZE/sizeFormat, decodeRange);
+        return true;
+    }
+
+    bool VTKParser::getBinaryValuesRange(size_t offset, size_t nbValues, VTKValueFormat format, double* minVal, double* maxVal) const
+    {
+        size_t sizeFormat = VTKValueFormatInt(format);
+        if(!isFileFormat(format) || offset > m_dataSize || (m_dataSize - offset)/sizeFormat < nbValues)
+            return false;
+
+        //Range per chunk, merged once every chunk is done
+        const uint8_t*      cached   = getCachedValues(offset, nbValues*sizeFormat);
+        const uint8_t*      src      = (cached ? cached : m_data + offset);
+        size_t              grain    = VTK_DECODE_CHUNK_SIZE/sizeFormat;
+        size_t              nbChunks = (nbValues + grain - 1)/grain;
+        std::vector<double> lows(nbChunks, std::numeric_limits<double>::infinity());
+        std::vector<double> highs(nbChunks, -std::numeric_limits<double>::infinity());
+        auto rangeChunk = [&](size_t begin, size_t end)
+        {
+            std::vector<uint8_t> tmp(cached ? 0 : std::min(grain, end-begin)*sizeFormat);
+            for(size_t i = begin; i < end; i += grain)
+            {
+                size_t         n      = std::min(grain, end-i);
+                const uint8_t* values = src + i*sizeFormat;
+                if(!cached)
+                {
+                    VTKByteSwap_bigEndianToHost(values, tmp.data(), n, format);
+                    values = tmp.data();
+                }
+                getValuesRange(values, format, n, &lows[i/grain], &highs[i/grain]);
+            }
+        };
+
+        if(nbValues*sizeFormat < m_parallelThreshold)
+            rangeChunk(0, nbValues);
+        else
+            m_threadPool->parallelFor(nbValues, grain, rangeChunk);
+
+        double low  = std::numeric_limits<double>::infinity();
+        double high = -std::numeric_limits<double>::infinity();
+        for(size_t i = 0; i < nbChunks; i++)
+        {
+            low  = std::min(low,  lows[i]);
+            high = std::max(high, highs[i]);
+        }
+
+        //No finite value
+        if(low > high)
+            low = high = 0.0;
+        *minVal = low;
+        *maxVal = high;
+        return true;
+    }
+
+    bool VTKParser::quantizeBinaryValues(size_t offset, size_t nbValues, VTKValueFormat format, void* dest, VTKValueFormat destFormat, VTKQuantization* quantization) const
+    {
+        double       minVal, maxVal;
+        VTKQuantizer quantizer;
+        if(!getBinaryValuesRange(offset, nbValues, format, &minVal, &maxVal) || !getQuantizer(minVal, maxVal, destFormat, &quantizer, quantization))
+            return false;
+
+        //Decode a chunk in a temporary buffer (kept in cache) and normalize it. Values of the cache file are normalized directly
+        size_t         sizeFormat = VTKValueFormatInt(format);
+        size_t         sizeDest   = VTKValueFormatInt(destFormat);
+        const uint8_t* cached     = getCachedValues(offset, nbValues*sizeFormat);
+        const uint8_t* src        = (cached ? cached : m_data + offset);
+        size_t         grain      = VTK_DECODE_CHUNK_SIZE/sizeFormat;
+        auto quantizeChunk = [&](size_t begin, size_t end)
+        {
+            std::vector<uint8_t> tmp(cached ? 0 : std::min(grain, end-begin)*sizeFormat);
+            for(size_t i = begin; i < end; i += grain)
+            {
+                size_t         n      = std::min(grain, end-i);
+                const uint8_t* values = src + i*sizeFormat;
+                if(!cached)
+                {
+                    VTKByteSwap_bigEndianToHost(values, tmp.data(), n, format);
+                    values = tmp.data();
+                }
+                quantizeValues(values, format, (uint8_t*)dest + i*sizeDest, destFormat, n, quantizer);
+            }
+        };
+
+        if(nbValues*sizeFormat < m_parallelThreshold)
+            quantizeChunk(0, nbValues);
+        else
+            m_threadPool->parallelFor(nbValues, grain, quantizeChunk);
+        return true;
+    }
+
+    bool VTKParser::convertBinaryValues(size_t offset, size_t nbValues, VTKValueFormat format, void* dest, VTKValueFormat destFormat) const
+    {
+        if(format == destFormat)
+            return decodeBinaryValues(offset, nbValues, format, dest);
+
+        size_t sizeFormat = VTKValueFormatInt(format);
+        size_t sizeDest   = VTKValueFormatInt(destFormat);
+        if(sizeFormat == 0 || sizeDest == 0 || offset > m_dataSize || (m_dataSize - offset)/sizeFormat < nbValues)
+            return false;
+
+        //Decode a chunk in a temporary buffer (kept in cache) and convert it. Values of the cache file are converted directly
+        const uint8_t* cached = getCachedValues(offset, nbValues*sizeFormat);
+        const uint8_t* src    = (cached ? cached : m_data + offset);
+        size_t         grain  = VTK_DECODE_CHUNK_SIZE/sizeFormat;
+        auto convertChunk = [&](size_t begin, size_t end)
+        {
+            if(cached)
+            {
+                convertValues(src + begin*sizeFormat, format, (uint8_t*)dest + begin*sizeDest, destFormat, end-begin);
+                return;
+            }
+
+            std::vector<uint8_t> tmp(std::min(grain, end-begin)*sizeFormat);
+            for(size_t i = begin; i < end; i += grain)
+            {
+                size_t n = std::min(grain, end-i);
+                VTKByteSwap_bigEndianToHost(src + i*sizeFormat, tmp.data(), n, format);
+                convertValues(tmp.data(), format, (uint8_t*)dest + i*sizeDest, destFormat, n);
+            }
+        };
+
+        if(nbValues*sizeFormat < m_parallelThreshold)
+            convertChunk(0, nbValues);
+        else
+            m_threadPool->parallelFor(nbValues, grain, convertChunk);
+        return true;
+    }
+
+    bool VTKParser::decodeBinaryTuples(size_t offset, size_t nbTuples, uint32_t nbValuePerTuple, uint32_t firstComponent, uint32_t nbComponents,
+                                       VTKValueFormat format, void* dest) const
+    {
+        //Contiguous values
+        if(nbComponents == nbValuePerTuple)
+            return decodeBinaryValues(offset, nbTuples*(size_t)nbValuePerTuple, format, dest);
+
+        size_t sizeFormat = VTKValueFormatInt(format);
+        size_t tupleSize  = nbValuePerTuple*sizeFormat;
+        size_t readSize   = nbComponents*sizeFormat;
+        if(sizeFormat == 0 || nbTuples == 0 || offset > m_dataSize || (m_dataSize - offset)/tupleSize < nbTuples)
+            return nbTuples == 0 && sizeFormat != 0;
+
+        const uint8_t* cached = getCachedValues(offset, nbTuples*tupleSize);
+        const uint8_t* src    = (cached ? cached : m_data + offset) + firstComponent*sizeFormat;
+        auto decodeRange = [&](size_t begin, size_t end)
+        {
+            for(size_t i = begin; i < end; i++)
+            {
+                if(cached)
+                    memcpy((uint8_t*)dest + i*readSize, src + i*tupleSize, readSize);
+                else
+                    VTKByteSwap_bigEndianToHost(src + i*tupleSize, (uint8_t*)dest + i*readSize, nbComponents, format);
+            }
+        };
+
+        if(nbTuples*tupleSize < m_parallelThreshold)
+            decodeRange(0, nbTuples);
+        else
+            m_threadPool->parallelFor(nbTuples, std::max<size_t>(1, VTK_DECODE_CHUNK_SIZE/tupleSize), decodeRange);
+        return true;
+    }
+
+    void VTKParser::fillUnstructuredGridCellElementBuffer(uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes, int32_t* buffer)
+    {
+        std::vector<CellChunk> chunks;
+        size_t size = planCellFill(nbCells, cellValues, cellTypes, chunks);
+
+        runCellChunks(chunks, size*sizeof(int32_t), [&](const CellChunk& chunk)
+        {
+            int32_t* values = (int32_t*)chunk.cellValues;
+            int32_t* dest   = buffer + chunk.bufferOffset;
+            for(uint32_t i = 0; i < chunk.nbCells; i++)
+            {
+                const VTKCellVT* cell = VTKCell_getVT(cellTypes[chunk.firstCell+i]);
+                cell->fillElementBuffer(values, dest);
+                dest   += cell->sizeBuffer(values);
+                values += values[0] + 1;
+            }
+        });
+    }
+
+    void VTKParser::fillUnstructuredGridCellBuffers(uint32_t nbCells, void* ptValues, int32_t* cellValues, int32_t* cellTypes, void** buffers, VTKValueFormat destFormat) const
+    {
+        if(destFormat == VTK_NO_VALUE_FORMAT)
+            destFormat = m_unstrGrid.ptsPos.format;
+
+        if(!checkCellFillFormats(destFormat))
+            return;
+
+        std::vector<CellChunk> chunks;
+        size_t vertexSize = 3*VTKValueFormatInt(destFormat);
+        size_t size       = planCellFill(nbCells, cellValues, cellTypes, chunks);
+
+        runCellChunks(chunks, size*vertexSize, [&](const CellChunk& chunk)
+        {
+            int32_t* values = (int32_t*)chunk.cellValues;
+            size_t   offsets[VTK_GL_NO_MODE];
+            std::copy(chunk.modeOffsets, chunk.modeOffsets+VTK_GL_NO_MODE, offsets);
+
+            for(uint32_t i = 0; i < chunk.nbCells;)
+            {
+                uint32_t         run  = getCellTypeRun(cellTypes + chunk.firstCell + i, chunk.nbCells - i);
+                const VTKCellVT* cell = VTKCell_getVT(cellTypes[chunk.firstCell+i]);
+                VTKGLMode        mode = cell->getMode();
+                i += run;
+                if(buffers[mode] == NULL)
+                {
+                    for(uint32_t j = 0; j < run; j++)
+                        values += values[0] + 1;
+                    continue;
+                }
+                offsets[mode] += VTKCell_getFillBuffers(cell, m_unstrGrid.ptsPos.format, destFormat)(ptValues, &values, run, (uint8_t*)buffers[mode] + offsets[mode]*vertexSize);
+            }
+        });
+    }
+
+    void VTKParser::fillUnstructuredGridCellElementBuffers(uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes, int32_t** buffers) const
+    {
+        std::vector<CellChunk> chunks;
+        size_t size = planCellFill(nbCells, cellValues, cellTypes, chunks);
+
+        runCellChunks(chunks, size*sizeof(int32_t), [&](const CellChunk& chunk)
+        {
+            int32_t* values = (int32_t*)chunk.cellValues;
+            size_t   offsets[VTK_GL_NO_MODE];
+            std::copy(chunk.modeOffsets, chunk.modeOffsets+VTK_GL_NO_MODE, offsets);
+            for(uint32_t i = 0; i < chunk.nbCells; i++, values += values[0] + 1)
+            {
+                const VTKCellVT* cell = VTKCell_getVT(cellTypes[chunk.firstCell+i]);
+                VTKGLMode        mode = cell->getMode();
+                if(buffers[mode] == NULL)
+                    continue;
+                cell->fillElementBuffer(values, buffers[mode] + offsets[mode]);
+                offsets[mode] += cell->sizeBuffer(values);
+            }
+        });
+    }
+
+    size_t VTKParser::getUnstructuredGridCellElementBufferSize(uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes, VTKGLMode mode) const
+    {
+        std::vector<CellChunk> chunks;
+        return planCellFill(nbCells, cellValues, cellTypes, chunks, mode);
+    }
+
+    bool VTKParser::fillUnstructuredGridCellElementBuffer(uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes, VTKGLMode mode, void* buffer, VTKIndexFormat format) const
+    {
+        std::vector<CellChunk> chunks;
+        size_t size = planCellFill(nbCells, cellValues, cellTypes, chunks, mode);
+
+        std::atomic<bool> valid(true);
+        runCellChunks(chunks, size*VTKIndexFormatInt(format), [&](const CellChunk& chunk)
+        {
+            std::vector<int32_t> ids;
+            int32_t* values = (int32_t*)chunk.cellValues;
+            size_t   offset = chunk.bufferOffset;
+            for(uint32_t i = 0; i < chunk.nbCells; i++, values += values[0] + 1)
+            {
+                const VTKCellVT* cell = VTKCell_getVT(cellTypes[chunk.firstCell+i]);
+                if(cell->getMode() != mode)
+                    continue;
+
+                uint32_t cellSize = cell->sizeBuffer(values);
+                if(format == VTK_INDEX_UINT32)
+                    cell->fillElementBuffer(values, (int32_t*)buffer + offset);
+                else
+                {
+                    ids.resize(cellSize);
+                    cell->fillElementBuffer(values, ids.data());
+                    for(uint32_t j = 0; j < cellSize; j++)
+                    {
+                        if(ids[j] < 0 || ids[j] > UINT16_MAX)
+                        {
+                            valid = false;
+                            return;
+                        }
+                        ((uint16_t*)buffer)[offset+j] = (uint16_t)ids[j];
+                    }
+                }
+                offset += cellSize;
+            }
+        });
+        return valid;
+    }
+
+    void* VTKParser::extractUnstructuredGridBoundaryElementBuffer(uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes, VTKIndexFormat format, size_t* nbIndices) const
+    {
+        std::vector<CellChunk> chunks;
+        planCellFill(nbCells, cellValues, cellTypes, chunks, VTK_GL_TRIANGLES);
+        nbCells = (chunks.empty() ? 0 : chunks.back().firstCell + chunks.back().nbCells);
+
+        //Hash the faces of the 3D cells. Each group of chunks splits its faces in partitions
+        size_t nbGroups = std::min(chunks.size(), (size_t)4*m_threadPool->getNbThreads());
+        std::vector<std::vector<VTKFaceRecord>> records(nbGroups*VTK_FACE_PARTITIONS);
+        m_threadPool->parallelFor(nbGroups, 1, [&](size_t begin, size_t end)
+        {
+            for(size_t g = begin; g < end; g++)
+            {
+                for(size_t c = g*chunks.size()/nbGroups; c < (g+1)*chunks.size()/nbGroups; c++)
+                {
+                    const int32_t* values = chunks[c].cellValues;
+                    for(uint32_t i = 0; i < chunks[c].nbCells; i++, values += values[0] + 1)
+                    {
+                        uint32_t            cell  = chunks[c].firstCell+i;
+                        const VTKCellFaces* faces = VTKCell_getFaces(cellTypes[cell]);
+                        if(faces == NULL)
+                            continue;
+
+                        for(uint32_t f = 0; f < faces->nbFaces; f++)
+                        {
+                            VTKFaceRecord record;
+                            record.key[3] = -1;
+                            for(uint32_t k = 0; k < faces->faceSizes[f]; k++)
+                                record.key[k] = values[1+faces->faces[f][k]];
+                            std::sort(record.key, record.key+4);
+                            record.face = (size_t)cell*VTK_CELL_MAX_FACES + f;
+                            records[g*VTK_FACE_PARTITIONS + record.partition()].push_back(record);
+                        }
+                    }
+                }
+            }
+        });
+
+        //The faces belonging to exactly one cell are on the boundary
+        std::vector<uint8_t> boundary((size_t)nbCells*VTK_CELL_MAX_FACES, 0);
+        m_threadPool->parallelFor(VTK_FACE_PARTITIONS, 1, [&](size_t begin, size_t end)
+        {
+            for(size_t p = begin; p < end; p++)
+            {
+                std::vector<VTKFaceRecord> faces;
+                for(size_t g = 0; g < nbGroups; g++)
+                    faces.insert(faces.end(), records[g*VTK_FACE_PARTITIONS+p].begin(), records[g*VTK_FACE_PARTITIONS+p].end());
+                std::sort(faces.begin(), faces.end());
+
+                for(size_t i = 0; i < faces.size();)
+                {
+                    size_t j = i+1;
+                    while(j < faces.size() && faces[j].sameFace(faces[i]))
+                        j++;
+                    if(j == i+1)
+                        boundary[faces[i].face] = 1;
+                    i = j;
+                }
+            }
+        });
+        records.clear();
+
+        //The boundary triangles of each chunk, then the position of each chunk
+        m_threadPool->parallelFor(chunks.size(), 1, [&](size_t begin, size_t end)
+        {
+            for(size_t c = begin; c < end; c++)
+            {
+                const int32_t* values = chunks[c].cellValues;
+                size_t         size   = 0;
+                for(uint32_t i = 0; i < chunks[c].nbCells; i++, values += values[0] + 1)
+                {
+                    uint32_t            cell  = chunks[c].firstCell+i;
+                    const VTKCellFaces* faces = VTKCell_getFaces(cellTypes[cell]);
+                    if(faces)
+                    {
+                        for(uint32_t f = 0; f < faces->nbFaces; f++)
+                            if(boundary[(size_t)cell*VTK_CELL_MAX_FACES + f])
+                                size += 3*(faces->faceSizes[f]-2);
+                    }
+                    else
+                    {
+                        const VTKCellVT* vt = VTKCell_getVT(cellTypes[cell]);
+                        if(vt->getMode() == VTK_GL_TRIANGLES)
+                            size += vt->sizeBuffer((int32_t*)values);
+                    }
+                }
+                chunks[c].bufferOffset = size;
+            }
+        });
+
+        size_t size = 0;
+        for(CellChunk& chunk : chunks)
+        {
+            size_t chunkSize   = chunk.bufferOffset;
+            chunk.bufferOffset = size;
+            size += chunkSize;
+        }
+
+        //Fill the element buffer
+        uint8_t* buffer = (uint8_t*)malloc(std::max(size*VTKIndexFormatInt(format), (size_t)1));
+        std::atomic<bool> valid(true);
+        runCellChunks(chunks, size*VTKIndexFormatInt(format), [&](const CellChunk& chunk)
+        {
+            std::vector<int32_t> ids;
+            const int32_t* values = chunk.cellValues;
+            for(uint32_t i = 0; i < chunk.nbCells; i++, values += values[0] + 1)
+            {
+                uint32_t            cell  = chunk.firstCell+i;
+                const VTKCellFaces* faces = VTKCell_getFaces(cellTypes[cell]);
+                if(faces)
+                {
+                    for(uint32_t f = 0; f < faces->nbFaces; f++)
+                        if(boundary[(size_t)cell*VTK_CELL_MAX_FACES + f])
+                            for(uint32_t k = 2; k < faces->faceSizes[f]; k++)
+                            {
+                                ids.push_back(values[1+faces->faces[f][0]]);
+                                ids.push_back(values[1+faces->faces[f][k-1]]);
+                                ids.push_back(values[1+faces->faces[f][k]]);
+                            }
+                }
+                else
+                {
+                    const VTKCellVT* vt = VTKCell_getVT(cellTypes[cell]);
+                    if(vt->getMode() == VTK_GL_TRIANGLES)
+                    {
+                        size_t offset = ids.size();
+                        ids.resize(offset + vt->sizeBuffer((int32_t*)values));
+                        vt->fillElementBuffer((int32_t*)values, ids.data() + offset);
+                    }
+                }
+            }
+
+            for(size_t j = 0; j < ids.size(); j++)
+            {
+                if(ids[j] < 0 || (format == VTK_INDEX_UINT16 && ids[j] > UINT16_MAX))
+                {
+                    valid = false;
                     return;
+                }
+                if(format == VTK_INDEX_UINT16)
+                    ((uint16_t*)buffer)[chunk.bufferOffset+j] = (uint16_t)ids[j];
+                else
+                    ((uint32_t*)buffer)[chunk.bufferOffset+j] = (uint32_t)ids[j];
             }
+        });
+
+        if(!valid)
+        {
+            free(buffer);
+            return NULL;
+        }
+        if(nbIndices)
+            *nbIndices = size;
+        return buffer;
+    }
+
+    bool VTKParser::fillStructuredGridCellElementBuffer(uint32_t firstCell, uint32_t nbCells, void* buffer, VTKIndexFormat format) const
+    {
+        uint32_t totalCells = getStructuredGridNbCells();
+        if(m_type != VTK_STRUCTURED_GRID || (uint64_t)firstCell + nbCells > totalCells ||
+           (format == VTK_INDEX_UINT16 && m_grid.ptsPos.nbPoints > UINT16_MAX+1))
+            return false;
 
-            cell->fillElementBuffer(cellValues, buffer + offset);
-            offset += cell->sizeBuffer(cellValues);
+        //The points of a cell relative to its first point
+        uint32_t axes[3];
+        uint32_t nbAxes      = getGridCellAxes(m_grid, axes);
+        uint32_t cellSize    = 1 << nbAxes;
+        uint64_t stride[3]   = {1, m_grid.size[0], (uint64_t)m_grid.size[0]*m_grid.size[1]};
+        uint32_t nbCellsX    = std::max(m_grid.size[0], (uint32_t)2) - 1;
+        uint32_t nbCellsY    = std::max(m_grid.size[1], (uint32_t)2) - 1;
+        uint64_t corners[8];
+        for(uint32_t c = 0; c < cellSize; c++)
+        {
+            corners[c] = 0;
+            for(uint32_t a = 0; a < nbAxes; a++)
+                corners[c] += VTK_GRID_CELL_CORNERS[c][a]*stride[axes[a]];
         }
+
+        size_t indexSize = cellSize*VTKIndexFormatInt(format);
+        size_t grain     = ((size_t)nbCells*indexSize < m_parallelThreshold ? nbCells : std::max<size_t>(1, VTK_DECODE_CHUNK_SIZE/indexSize));
+        m_threadPool->parallelFor(nbCells, grain, [&](size_t begin, size_t end)
+        {
+            for(size_t i = begin; i < end; i++)
+            {
+                uint64_t cell  = firstCell + i;
+                uint64_t first = (cell % nbCellsX)*stride[0] + (cell / nbCellsX % nbCellsY)*stride[1] + (cell / nbCellsX / nbCellsY)*stride[2];
+                for(uint32_t c = 0; c < cellSize; c++)
+                    writeElementIndex(buffer, i*cellSize + c, first + corners[c], format);
+            }
+        });
+        return true;
+    }
+
+    size_t VTKParser::getStructuredGridBoundaryElementBufferSize() const
+    {
+        if(m_type != VTK_STRUCTURED_GRID)
+            return 0;
+
+        std::vector<VTKGridSide> sides;
+        return 6*getGridSides(m_grid, sides);
+    }
+
+    bool VTKParser::fillStructuredGridBoundaryElementBuffer(void* buffer, VTKIndexFormat format) const
+    {
+        if(m_type != VTK_STRUCTURED_GRID || (format == VTK_INDEX_UINT16 && m_grid.ptsPos.nbPoints > UINT16_MAX+1))
+            return false;
+
+        std::vector<VTKGridSide> sides;
+        size_t nbQuads  = getGridSides(m_grid, sides);
+        size_t quadSize = 6*VTKIndexFormatInt(format);
+        size_t grain    = (nbQuads*quadSize < m_parallelThreshold ? nbQuads : std::max<size_t>(1, VTK_DECODE_CHUNK_SIZE/quadSize));
+        m_threadPool->parallelFor(nbQuads, grain, [&](size_t begin, size_t end)
+        {
+            size_t s = 0;
+            for(size_t i = begin; i < end; i++)
+            {
+                while(s+1 < sides.size() && sides[s+1].firstQuad <= i)
+                    s++;
+
+                //Two triangles per quad, wound counter-clockwise seen from outside
+                const VTKGridSide& side = sides[s];
+                size_t   quad = i - side.firstQuad;
+                uint64_t p0   = side.base + (quad % side.nbQuadsU)*side.strideU + (quad / side.nbQuadsU)*side.strideV;
+                uint64_t p1   = p0 + (side.outward ? side.strideU : side.strideV);
+                uint64_t p2   = p0 + side.strideU + side.strideV;
+                uint64_t p3   = p0 + (side.outward ? side.strideV : side.strideU);
+                uint64_t ids[6] = {p0, p1, p2, p0, p2, p3};
+                for(uint32_t j = 0; j < 6; j++)
+                    writeElementIndex(buffer, 6*i + j, ids[j], format);
+            }
+        });
+        return true;
     }
 }
@@ -1,5 +1,6 @@
 #include "VTKParser_C.h"
 #include "VTKParser.h"
+#include "VTKBrickPyramid.h"
 
 namespace sereno
 {
@@ -18,6 +19,26 @@ namespace sereno
         return parser->parse();
     }
 
+    void WINAPI VTKParser_setCacheEnabled(HVTKParser parser, char enable, const char* directory)
+    {
+        parser->setCacheEnabled(enable != 0, directory ? directory : "");
+    }
+
+    char WINAPI VTKParser_isLoadedFromCache(HVTKParser parser)
+    {
+        return parser->isLoadedFromCache();
+    }
+
+    void WINAPI VTKParser_setNbThreads(HVTKParser parser, uint32_t nbThreads)
+    {
+        parser->setNbThreads(nbThreads);
+    }
+
+    void WINAPI VTKParser_setParallelThreshold(HVTKParser parser, size_t size)
+    {
+        parser->setParallelThreshold(size);
+    }
+
     enum VTKDatasetType WINAPI VTKParser_getDatasetType(HVTKParser parser)
     {
         return parser->getDatasetType();
@@ -28,6 +49,11 @@ namespace sereno
         return &parser->getStructuredPointsDescriptor();
     }
 
+    const VTKGrid* WINAPI VTKParser_getStructuredGridDescriptor(HVTKParser parser)
+    {
+        return &parser->getStructuredGridDescriptor();
+    }
+
     VTKPointPositions WINAPI VTKParser_getUnstructuredGridPointDescriptor(HVTKParser parser)
     {
         return parser->getUnstructuredGridPointDescriptor();
@@ -76,6 +102,56 @@ namespace sereno
         return parser->parseAllUnstructuredGridCellTypes();
     }
 
+    char WINAPI VTKParser_parseAllUnstructuredGridPointsInto(HVTKParser parser, void* dest, size_t capacity)
+    {
+        return parser->parseAllUnstructuredGridPoints(dest, capacity);
+    }
+
+    void* WINAPI VTKParser_parseAllUnstructuredGridPointsWithStats(HVTKParser parser, VTKComponentStats* bounds)
+    {
+        return parser->parseAllUnstructuredGridPoints(bounds);
+    }
+
+    char WINAPI VTKParser_parseAllUnstructuredGridCellsCompositionInto(HVTKParser parser, int32_t* dest, size_t capacity)
+    {
+        return parser->parseAllUnstructuredGridCellsComposition(dest, capacity/sizeof(int32_t)).isValid();
+    }
+
+    char WINAPI VTKParser_parseAllUnstructuredGridCellTypesInto(HVTKParser parser, int32_t* dest, size_t capacity)
+    {
+        return parser->parseAllUnstructuredGridCellTypes(dest, capacity/sizeof(int32_t)).isValid();
+    }
+
+    void* WINAPI VTKParser_parseAllUnstructuredGridPointsAs(HVTKParser parser, VTKValueFormat destFormat)
+    {
+        return parser->parseAllUnstructuredGridPoints(destFormat);
+    }
+
+    void* WINAPI VTKParser_parseUnstructuredGridPoints(HVTKParser parser, uint32_t firstPoint, uint32_t nbPoints)
+    {
+        return parser->parseUnstructuredGridPoints(firstPoint, nbPoints);
+    }
+
+    char WINAPI VTKParser_buildUnstructuredGridCellIndex(HVTKParser parser)
+    {
+        return parser->buildUnstructuredGridCellIndex();
+    }
+
+    const uint32_t* WINAPI VTKParser_getUnstructuredGridCellIndex(HVTKParser parser)
+    {
+        return parser->getUnstructuredGridCellIndex();
+    }
+
+    int32_t* WINAPI VTKParser_parseUnstructuredGridCellsComposition(HVTKParser parser, uint32_t firstCell, uint32_t nbCells, uint32_t* nbValues)
+    {
+        return parser->parseUnstructuredGridCellsComposition(firstCell, nbCells, nbValues);
+    }
+
+    int32_t* WINAPI VTKParser_parseUnstructuredGridCellTypes(HVTKParser parser, uint32_t firstCell, uint32_t nbCells)
+    {
+        return parser->parseUnstructuredGridCellTypes(firstCell, nbCells);
+    }
+
     uint32_t WINAPI VTKParser_getFieldNbTuples(HVTKFieldValue value)
     {
         return value->nbTuples;
@@ -101,6 +177,238 @@ namespace sereno
         return parser->parseAllFieldValues(value);
     }
 
+    char WINAPI VTKParser_parseAllFieldValuesInto(HVTKParser parser, HVTKFieldValue value, void* dest, size_t capacity)
+    {
+        return parser->parseAllFieldValues(value, dest, capacity);
+    }
+
+    void* WINAPI VTKParser_parseAllFieldValuesAs(HVTKParser parser, HVTKFieldValue value, VTKValueFormat destFormat, VTKQuantization* quantization)
+    {
+        return parser->parseAllFieldValues(value, destFormat, quantization);
+    }
+
+    char WINAPI VTKParser_parseAllFieldValuesAsInto(HVTKParser parser, HVTKFieldValue value, void* dest, size_t capacity, VTKValueFormat destFormat, VTKQuantization* quantization)
+    {
+        return parser->parseAllFieldValues(value, dest, capacity, destFormat, quantization);
+    }
+
+    void* WINAPI VTKParser_parseAllFieldValuesWithStats(HVTKParser parser, HVTKFieldValue value, VTKComponentStats* stats)
+    {
+        return parser->parseAllFieldValues(value, stats);
+    }
+
+    char WINAPI VTKParser_parseAllFieldValuesWithStatsInto(HVTKParser parser, HVTKFieldValue value, void* dest, size_t capacity, VTKComponentStats* stats)
+    {
+        return parser->parseAllFieldValues(value, dest, capacity, stats);
+    }
+
+    VTKArrayRead WINAPI VTKParser_getFieldValuesRead(HVTKFieldValue value, void* dest, size_t capacity)
+    {
+        return VTKParser::getFieldValuesRead(value, dest, capacity);
+    }
+
+    VTKArrayRead WINAPI VTKParser_getUnstructuredGridPointsRead(HVTKParser parser, void* dest, size_t capacity)
+    {
+        return parser->getUnstructuredGridPointsRead(dest, capacity);
+    }
+
+    VTKArrayRead WINAPI VTKParser_getUnstructuredGridCellsRead(HVTKParser parser, void* dest, size_t capacity)
+    {
+        return parser->getUnstructuredGridCellsRead(dest, capacity);
+    }
+
+    VTKArrayRead WINAPI VTKParser_getUnstructuredGridCellTypesRead(HVTKParser parser, void* dest, size_t capacity)
+    {
+        return parser->getUnstructuredGridCellTypesRead(dest, capacity);
+    }
+
+    VTKArrayRead WINAPI VTKParser_getStructuredGridPointsRead(HVTKParser parser, void* dest, size_t capacity)
+    {
+        return parser->getStructuredGridPointsRead(dest, capacity);
+    }
+
+    char WINAPI VTKParser_parseArrays(HVTKParser parser, VTKArrayRead* reads, size_t nbReads)
+    {
+        return parser->parseArrays(reads, nbReads);
+    }
+
+    void* WINAPI VTKParser_parseFieldValues(HVTKParser parser, HVTKFieldValue value, uint32_t firstTuple, uint32_t nbTuples, uint32_t firstComponent, uint32_t nbComponents)
+    {
+        return parser->parseFieldValues(value, firstTuple, nbTuples, firstComponent, nbComponents);
+    }
+
+    char WINAPI VTKParser_parseFieldValuesInto(HVTKParser parser, HVTKFieldValue value, uint32_t firstTuple, uint32_t nbTuples, uint32_t firstComponent, uint32_t nbComponents,
+                                               void* dest, size_t capacity)
+    {
+        return parser->parseFieldValues(value, firstTuple, nbTuples, dest, capacity, firstComponent, nbComponents);
+    }
+
+    char WINAPI VTKParser_getStructuredPointsSubVolumeDescriptor(HVTKParser parser, const VTKSubVolume* box, VTKStructuredPoints* descriptor)
+    {
+        return parser->getStructuredPointsSubVolumeDescriptor(*box, descriptor);
+    }
+
+    void* WINAPI VTKParser_parseStructuredPointsFieldValues(HVTKParser parser, HVTKFieldValue value, const VTKSubVolume* box, VTKStructuredPoints* descriptor)
+    {
+        return parser->parseStructuredPointsFieldValues(value, *box, descriptor);
+    }
+
+    char WINAPI VTKParser_parseStructuredPointsFieldValuesInto(HVTKParser parser, HVTKFieldValue value, const VTKSubVolume* box, void* dest, size_t capacity,
+                                                               VTKStructuredPoints* descriptor)
+    {
+        return parser->parseStructuredPointsFieldValues(value, *box, dest, capacity, descriptor);
+    }
+
+    void* WINAPI VTKParser_extractUnstructuredGridBoundaryElementBuffer(HVTKParser parser, uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes,
+                                                                       VTKIndexFormat format, size_t* nbIndices)
+    {
+        return parser->extractUnstructuredGridBoundaryElementBuffer(nbCells, cellValues, cellTypes, format, nbIndices);
+    }
+
+    void* WINAPI VTKParser_parseAllStructuredGridPoints(HVTKParser parser)
+    {
+        return parser->parseAllStructuredGridPoints();
+    }
+
+    void* WINAPI VTKParser_parseAllStructuredGridPointsAs(HVTKParser parser, VTKValueFormat destFormat)
+    {
+        return parser->parseAllStructuredGridPoints(destFormat);
+    }
+
+    char WINAPI VTKParser_parseAllStructuredGridPointsInto(HVTKParser parser, void* dest, size_t capacity)
+    {
+        return parser->parseAllStructuredGridPoints(dest, capacity);
+    }
+
+    void* WINAPI VTKParser_parseAllStructuredGridPointsWithStats(HVTKParser parser, VTKComponentStats* bounds)
+    {
+        return parser->parseAllStructuredGridPoints(bounds);
+    }
+
+    void* WINAPI VTKParser_parseStructuredGridPoints(HVTKParser parser, uint32_t firstPoint, uint32_t nbPoints)
+    {
+        return parser->parseStructuredGridPoints(firstPoint, nbPoints);
+    }
+
+    uint32_t WINAPI VTKParser_getStructuredGridNbCells(HVTKParser parser)
+    {
+        return parser->getStructuredGridNbCells();
+    }
+
+    VTKCellType WINAPI VTKParser_getStructuredGridCellType(HVTKParser parser)
+    {
+        return parser->getStructuredGridCellType();
+    }
+
+    char WINAPI VTKParser_fillStructuredGridCellElementBuffer(HVTKParser parser, uint32_t firstCell, uint32_t nbCells, void* buffer, VTKIndexFormat format)
+    {
+        return parser->fillStructuredGridCellElementBuffer(firstCell, nbCells, buffer, format);
+    }
+
+    size_t WINAPI VTKParser_getStructuredGridBoundaryElementBufferSize(HVTKParser parser)
+    {
+        return parser->getStructuredGridBoundaryElementBufferSize();
+    }
+
+    char WINAPI VTKParser_fillStructuredGridBoundaryElementBuffer(HVTKParser parser, void* buffer, VTKIndexFormat format)
+    {
+        return parser->fillStructuredGridBoundaryElementBuffer(buffer, format);
+    }
+
+    HVTKCellStream WINAPI VTKParser_newCellStream(HVTKParser parser, uint32_t batchSize)
+    {
+        return new VTKCellStream(*parser, batchSize);
+    }
+
+    char WINAPI VTKCellStream_next(HVTKCellStream stream, uint32_t* nbCells, int32_t** cellValues, uint32_t* nbValues, int32_t** cellTypes)
+    {
+        const VTKCellBatch* batch = stream->next();
+        if(batch == NULL)
+            return 0;
+
+        *nbCells    = batch->nbCells;
+        *cellValues = (int32_t*)batch->cellValues.data();
+        *nbValues   = batch->cellValues.size();
+        *cellTypes  = (int32_t*)batch->cellTypes.data();
+        return 1;
+    }
+
+    char WINAPI VTKCellStream_hasError(HVTKCellStream stream)
+    {
+        return stream->hasError();
+    }
+
+    void WINAPI VTKCellStream_delete(HVTKCellStream stream)
+    {
+        delete stream;
+    }
+
+    char WINAPI VTKBrickPyramid_build(HVTKParser parser, HVTKFieldValue value, const char* path, uint32_t brickSize)
+    {
+        return VTKBrickPyramid::build(*parser, value, path, brickSize);
+    }
+
+    HVTKBrickPyramid WINAPI VTKBrickPyramid_open(const char* path)
+    {
+        VTKBrickPyramid* pyramid = new VTKBrickPyramid();
+        if(!pyramid->open(path))
+        {
+            delete pyramid;
+            return NULL;
+        }
+        return pyramid;
+    }
+
+    void WINAPI VTKBrickPyramid_delete(HVTKBrickPyramid pyramid)
+    {
+        delete pyramid;
+    }
+
+    uint32_t WINAPI VTKBrickPyramid_getNbLevels(HVTKBrickPyramid pyramid)
+    {
+        return pyramid->getNbLevels();
+    }
+
+    const VTKBrickLevel* WINAPI VTKBrickPyramid_getLevel(HVTKBrickPyramid pyramid, uint32_t level)
+    {
+        return pyramid->getLevel(level);
+    }
+
+    uint32_t WINAPI VTKBrickPyramid_getBrickSize(HVTKBrickPyramid pyramid)
+    {
+        return pyramid->getBrickSize();
+    }
+
+    VTKValueFormat WINAPI VTKBrickPyramid_getFormat(HVTKBrickPyramid pyramid)
+    {
+        return pyramid->getFormat();
+    }
+
+    uint32_t WINAPI VTKBrickPyramid_getNbValuePerTuple(HVTKBrickPyramid pyramid)
+    {
+        return pyramid->getNbValuePerTuple();
+    }
+
+    size_t WINAPI VTKBrickPyramid_getBrickDataSize(HVTKBrickPyramid pyramid)
+    {
+        return pyramid->getBrickDataSize();
+    }
+
+    char WINAPI VTKBrickPyramid_getBrickDescriptor(HVTKBrickPyramid pyramid, uint32_t level, uint32_t x, uint32_t y, uint32_t z, VTKStructuredPoints* descriptor)
+    {
+        return pyramid->getBrickDescriptor(level, x, y, z, descriptor);
+    }
+
+    const void* WINAPI VTKBrickPyramid_getBrick(HVTKBrickPyramid pyramid, uint32_t level, uint32_t x, uint32_t y, uint32_t z)
+    {
+        return pyramid->getBrick(level, x, y, z);
+    }
+
+    char WINAPI VTKBrickPyramid_readBrick(HVTKBrickPyramid pyramid, uint32_t level, uint32_t x, uint32_t y, uint32_t z, void* dest, size_t capacity)
+    {
+        return pyramid->readBrick(level, x, y, z, dest, capacity);
+    }
+
     void WINAPI VTKParser_free(void* data)
     {
         free(data);
@@ -120,4 +428,48 @@ namespace sereno
     {
         parser->fillUnstructuredGridCellElementBuffer(nbCells, cellValues, cellTypes, buffer);
     }
+
+    VTKMultiCellConstruction WINAPI VTKParser_getMultiCellConstructionDescriptor(uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes)
+    {
+        return VTKParser::getMultiCellConstructionDescriptor(nbCells, cellValues, cellTypes);
+    }
+
+    char WINAPI VTKParser_computeUnstructuredGridMortonOrder(HVTKParser parser, const void* points, uint32_t nbCells, const int32_t* cellValues,
+                                                             size_t nbValues, uint32_t* pointOrder, uint32_t* cellOrder)
+    {
+        return parser->computeUnstructuredGridMortonOrder(points, nbCells, cellValues, nbValues, pointOrder, cellOrder);
+    }
+
+    char WINAPI VTKParser_permuteTuples(HVTKParser parser, const void* src, uint32_t nbTuples, size_t tupleSize, const uint32_t* order, void* dest)
+    {
+        return parser->permuteTuples(src, nbTuples, tupleSize, order, dest);
+    }
+
+    char WINAPI VTKParser_remapUnstructuredGridCells(HVTKParser parser, uint32_t nbCells, const int32_t* cellValues, size_t nbValues, uint32_t nbPoints,
+                                                     const uint32_t* pointOrder, const uint32_t* cellOrder, int32_t* dest)
+    {
+        return parser->remapUnstructuredGridCells(nbCells, cellValues, nbValues, nbPoints, pointOrder, cellOrder, dest);
+    }
+
+    void WINAPI VTKParser_fillUnstructuredGridCellBuffers(HVTKParser parser, uint32_t nbCells, void* ptValues, int32_t* cellValues, int32_t* cellTypes,
+                                                          void** buffers, VTKValueFormat destFormat)
+    {
+        parser->fillUnstructuredGridCellBuffers(nbCells, ptValues, cellValues, cellTypes, buffers, destFormat);
+    }
+
+    void WINAPI VTKParser_fillUnstructuredGridCellElementBuffers(HVTKParser parser, uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes, int32_t** buffers)
+    {
+        parser->fillUnstructuredGridCellElementBuffers(nbCells, cellValues, cellTypes, buffers);
+    }
+
+    size_t WINAPI VTKParser_getUnstructuredGridCellElementBufferSize(HVTKParser parser, uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes, VTKGLMode mode)
+    {
+        return parser->getUnstructuredGridCellElementBufferSize(nbCells, cellValues, cellTypes, mode);
+    }
+
+    char WINAPI VTKParser_fillUnstructuredGridCellIndexedElementBuffer(HVTKParser parser, uint32_t nbCells, int32_t* cellValues, int32_t* cellTypes, VTKGLMode mode,
+                                                                       void* buffer, VTKIndexFormat format)
+    {
+        return parser->fillUnstructuredGridCellElementBuffer(nbCells, cellValues, cellTypes, mode, buffer, format);
+    }
 }
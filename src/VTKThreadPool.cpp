@@ -0,0 +1,130 @@
+#include <algorithm>
+#include "VTKThreadPool.h"
+
+namespace sereno
+{
+    VTKThreadPool::VTKThreadPool(uint32_t nbThreads) : m_nbThreads(nbThreads == 0 ? getHardwareNbThreads() : nbThreads)
+    {}
+
+    VTKThreadPool::~VTKThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_jobCond.notify_all();
+        for(auto& it : m_workers)
+            it.join();
+    }
+
+    uint32_t VTKThreadPool::getHardwareNbThreads()
+    {
+        uint32_t nb = std::thread::hardware_concurrency();
+        return (nb == 0 ? 1 : nb);
+    }
+
+    bool VTKThreadPool::takeChunk(Job* job, size_t& chunk)
+    {
+        if(job->nextChunk >= job->nbChunks)
+            return false;
+        chunk = job->nextChunk++;
+        return true;
+    }
+
+    void VTKThreadPool::runChunk(Job* job, size_t chunk)
+    {
+        size_t begin = chunk*job->grain;
+        std::exception_ptr exception;
+        try
+        {
+            (*job->func)(begin, std::min(begin+job->grain, job->n));
+        }
+        catch(...)
+        {
+            exception = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(exception && !job->exception)
+            job->exception = exception;
+        if(++job->doneChunks == job->nbChunks)
+            m_doneCond.notify_all();
+    }
+
+    void VTKThreadPool::workerLoop()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while(true)
+        {
+            m_jobCond.wait(lock, [this](){return m_stop || !m_jobs.empty();});
+            if(m_stop)
+                return;
+
+            Job*   job = m_jobs.front();
+            size_t chunk;
+            if(!takeChunk(job, chunk))
+            {
+                //Every chunk is distributed : the job owner waits for the running ones
+                m_jobs.pop_front();
+                continue;
+            }
+
+            lock.unlock();
+            runChunk(job, chunk);
+            lock.lock();
+        }
+    }
+
+    void VTKThreadPool::parallelFor(size_t n, size_t grain, const RangeFunction& func)
+    {
+        if(n == 0)
+            return;
+        if(grain == 0)
+            grain = 1;
+
+        Job job;
+        job.func       = &func;
+        job.n          = n;
+        job.grain      = grain;
+        job.nbChunks   = (n + grain - 1) / grain;
+        job.nextChunk  = 0;
+        job.doneChunks = 0;
+
+        //Serial path : still one call per chunk
+        if(m_nbThreads <= 1 || job.nbChunks == 1)
+        {
+            for(size_t begin = 0; begin < n; begin += grain)
+                func(begin, std::min(begin+grain, n));
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(m_workers.empty())
+                for(uint32_t i = 1; i < m_nbThreads; i++)
+                    m_workers.emplace_back(&VTKThreadPool::workerLoop, this);
+            m_jobs.push_back(&job);
+        }
+        m_jobCond.notify_all();
+
+        //The caller works on its own job too. This also avoids deadlocks on recursive calls
+        std::unique_lock<std::mutex> lock(m_mutex);
+        size_t chunk;
+        while(takeChunk(&job, chunk))
+        {
+            lock.unlock();
+            runChunk(&job, chunk);
+            lock.lock();
+        }
+
+        m_doneCond.wait(lock, [&job](){return job.doneChunks == job.nbChunks;});
+
+        auto it = std::find(m_jobs.begin(), m_jobs.end(), &job);
+        if(it != m_jobs.end())
+            m_jobs.erase(it);
+        lock.unlock();
+
+        if(job.exception)
+            std::rethrow_exception(job.exception);
+    }
+}
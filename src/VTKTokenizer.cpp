@@ -0,0 +1,308 @@
+#include <sstream>
+#include <locale>
+#include <limits>
+#include <cmath>
+#include <cstdlib>
+#include <clocale>
+#ifdef __APPLE__
+#include <xlocale.h>
+#endif
+#include "VTKTokenizer.h"
+
+namespace sereno
+{
+    /** \brief  Exact powers of ten representable by a double */
+    static const double VTK_POW10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                       1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    /**
+     * \brief  Convert [first, last) (a valid number) to a double with the "C" locale. Used for the values the fast path cannot round exactly
+     * \param first the first character
+     * \param last the character after the last one
+     * \param value[out] the value converted
+     * \return false if the value is out of the double range, true otherwise
+     */
+    static bool convertDoubleCLocale(const char* first, const char* last, double& value)
+    {
+#if defined(WIN32) || defined(__linux__) || defined(__APPLE__)
+        //strtod needs a NULL-terminated string : avoid any allocation for the usual token sizes
+        char        buffer[64];
+        std::string str;
+        const char* cstr = buffer;
+        size_t      size = last-first;
+        if(size < sizeof(buffer))
+        {
+            memcpy(buffer, first, size);
+            buffer[size] = '\0';
+        }
+        else
+        {
+            str  = std::string(first, last);
+            cstr = str.c_str();
+        }
+
+        char* end = NULL;
+#ifdef WIN32
+        static _locale_t locale = _create_locale(LC_NUMERIC, "C");
+        double v = _strtod_l(cstr, &end, locale);
+#else
+        static locale_t locale = newlocale(LC_NUMERIC_MASK, "C", (locale_t)0);
+        double v = strtod_l(cstr, &end, locale);
+#endif
+        if(end != cstr + size || std::isinf(v))
+            return false;
+        value = v;
+        return true;
+#else
+        std::istringstream stream(std::string(first, last));
+        stream.imbue(std::locale::classic());
+        double v;
+        if(!(stream >> v))
+            return false;
+        value = v;
+        return true;
+#endif
+    }
+
+    /* \brief Is c a token separator ?
+     * \param c the character to test
+     * \return true if c is a space, a tabulation or a '\r' */
+    static inline bool isSeparator(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    /* \brief Is c a digit ?
+     * \param c the character to test
+     * \return true if c is in [0-9] */
+    static inline bool isDigit(char c)
+    {
+        return (unsigned char)(c - '0') < 10;
+    }
+
+    /* \brief Compare (case insensitive) [first, last) to a lowercase word
+     * \param first the first character
+     * \param last the character after the last one
+     * \param word the lowercase NULL-terminated word
+     * \return the pointer after the word if [first, last) starts with it, NULL otherwise */
+    static const char* startsWithWord(const char* first, const char* last, const char* word)
+    {
+        for(; *word; word++, first++)
+            if(first == last || (*first | 0x20) != *word)
+                return NULL;
+        return first;
+    }
+
+    const char* VTKFromChars(const char* first, const char* last, uint32_t& value)
+    {
+        const char* p   = first;
+        uint64_t    val = 0;
+        for(; p < last && isDigit(*p); p++)
+        {
+            val = val*10 + (*p - '0');
+            if(val > UINT32_MAX)
+                return NULL;
+        }
+        if(p == first)
+            return NULL;
+        value = (uint32_t)val;
+        return p;
+    }
+
+    const char* VTKFromChars(const char* first, const char* last, int32_t& value)
+    {
+        bool neg = (first < last && *first == '-');
+        if(first < last && (*first == '-' || *first == '+'))
+            first++;
+
+        uint32_t    val;
+        const char* p = VTKFromChars(first, last, val);
+        if(p == NULL || val > (uint32_t)INT32_MAX + (neg ? 1 : 0))
+            return NULL;
+        value = (neg ? (int32_t)(0u-val) : (int32_t)val);
+        return p;
+    }
+
+    const char* VTKFromChars(const char* first, const char* last, double& value)
+    {
+        const char* p   = first;
+        bool        neg = false;
+        if(p < last && (*p == '-' || *p == '+'))
+        {
+            neg = (*p == '-');
+            p++;
+        }
+
+        //Special values
+        const char* special;
+        if((special = startsWithWord(p, last, "nan")) != NULL)
+        {
+            value = std::numeric_limits<double>::quiet_NaN();
+            return special;
+        }
+        if((special = startsWithWord(p, last, "inf")) != NULL)
+        {
+            const char* infinity = startsWithWord(special, last, "inity");
+            value = (neg ? -1 : 1)*std::numeric_limits<double>::infinity();
+            return (infinity ? infinity : special);
+        }
+
+        //Mantissa (19 significant digits at most fit in a uint64_t)
+        uint64_t mantissa  = 0;
+        int32_t  nbDigits  = 0;
+        int32_t  exp10     = 0;
+        bool     anyDigit  = false;
+        bool     truncated = false;
+
+        for(; p < last && isDigit(*p); p++)
+        {
+            anyDigit = true;
+            if(mantissa == 0 && *p == '0')
+                continue;
+            if(nbDigits < 19)
+            {
+                mantissa = mantissa*10 + (*p - '0');
+                nbDigits++;
+            }
+            else
+            {
+                exp10++;
+                truncated |= (*p != '0');
+            }
+        }
+
+        if(p < last && *p == '.')
+        {
+            p++;
+            for(; p < last && isDigit(*p); p++)
+            {
+                anyDigit = true;
+                if(mantissa == 0 && *p == '0')
+                    exp10--;
+                else if(nbDigits < 19)
+                {
+                    mantissa = mantissa*10 + (*p - '0');
+                    nbDigits++;
+                    exp10--;
+                }
+                else
+                    truncated |= (*p != '0');
+            }
+        }
+
+        if(!anyDigit)
+            return NULL;
+
+        //Exponent. Not consumed if not followed by digits
+        if(p < last && (*p == 'e' || *p == 'E'))
+        {
+            const char* e    = p+1;
+            bool        eNeg = false;
+            if(e < last && (*e == '-' || *e == '+'))
+            {
+                eNeg = (*e == '-');
+                e++;
+            }
+            if(e < last && isDigit(*e))
+            {
+                int32_t expValue = 0;
+                for(; e < last && isDigit(*e); e++)
+                    if(expValue < 100000)
+                        expValue = expValue*10 + (*e - '0');
+                exp10 += (eNeg ? -expValue : expValue);
+                p = e;
+            }
+        }
+
+        //Fast path : the mantissa and the power of ten are exact doubles, the result is correctly rounded
+        if(mantissa == 0)
+            value = (neg ? -0.0 : 0.0);
+        else if(!truncated && mantissa <= (1ull << 53) && exp10 >= -22 && exp10 <= 22)
+        {
+            double v = (double)mantissa;
+            v = (exp10 < 0 ? v / VTK_POW10[-exp10] : v * VTK_POW10[exp10]);
+            value = (neg ? -v : v);
+        }
+
+        //Slow path (long mantissas, large exponents)
+        else
+        {
+            double v;
+            if(convertDoubleCLocale(first, p, v))
+                value = v;
+            else //Out of range for the standard library (denormals, overflow)
+                value = (double)((neg ? -1.0L : 1.0L) * (long double)mantissa * std::pow(10.0L, (long double)exp10));
+        }
+        return p;
+    }
+
+    const char* VTKFromChars(const char* first, const char* last, float& value)
+    {
+        double      v;
+        const char* p = VTKFromChars(first, last, v);
+        if(p != NULL)
+            value = (float)v;
+        return p;
+    }
+
+    bool VTKTokenizer::nextLine()
+    {
+        if(m_cursor >= m_size)
+            return false;
+
+        const char* begin = m_data + m_cursor;
+        const char* end   = (const char*)memchr(begin, '\n', m_size - m_cursor);
+        if(end == NULL)
+        {
+            end      = m_data + m_size;
+            m_cursor = m_size;
+        }
+        else
+            m_cursor = end - m_data + 1;
+
+        m_lineStart  = begin;
+        m_lineCursor = begin;
+        m_lineEnd    = end;
+        return true;
+    }
+
+    bool VTKTokenizer::nextToken(VTKToken& token)
+    {
+        if(!m_lineCursor)
+            return false;
+
+        while(m_lineCursor < m_lineEnd && isSeparator(*m_lineCursor))
+            m_lineCursor++;
+        if(m_lineCursor == m_lineEnd)
+            return false;
+
+        token.str = m_lineCursor;
+        while(m_lineCursor < m_lineEnd && !isSeparator(*m_lineCursor))
+            m_lineCursor++;
+        token.size = m_lineCursor - token.str;
+        return true;
+    }
+
+    bool VTKTokenizer::nextKeyword(const char* keyword)
+    {
+        VTKToken token;
+        return nextToken(token) && token == keyword;
+    }
+
+    bool VTKTokenizer::isLineEnd()
+    {
+        if(!m_lineCursor)
+            return true;
+        while(m_lineCursor < m_lineEnd && isSeparator(*m_lineCursor))
+            m_lineCursor++;
+        return m_lineCursor == m_lineEnd;
+    }
+
+    bool VTKTokenizer::skipBytes(size_t size)
+    {
+        if(m_cursor > m_size || m_size - m_cursor < size)
+            return false;
+        m_cursor += size;
+        return true;
+    }
+}
@@ -0,0 +1,269 @@
+#include "VTKParser.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstring>
+
+using namespace sereno;
+
+/* Regression checks of the parser : results not depending on the number of threads, ASCII and BINARY files giving the same values,
+ * a second parse() of the same file and a round trip through the binary cache.
+ * The datasets are generated in the directory given as first parameter (default : the working directory). Return 0 if every check passes*/
+
+#define CHECK_NB_THREADS 4
+
+/** \brief  Everything read from a dataset by the checks */
+struct CheckValues
+{
+    std::vector<float>    points;     /*!< The points position*/
+    std::vector<int32_t>  cells;      /*!< The cells composition*/
+    std::vector<int32_t>  cellTypes;  /*!< The cells type*/
+    std::vector<double>   temperature;/*!< The point field "temperature"*/
+    std::vector<float>    velocity;   /*!< The point field "velocity"*/
+    std::vector<int32_t>  cellIDs;    /*!< The cell field "id"*/
+    std::vector<uint32_t> pointOrder; /*!< The Morton order of the points*/
+    std::vector<uint32_t> cellOrder;  /*!< The Morton order of the cells*/
+    bool                  fromCache;  /*!< Has the last parse been served by the cache ?*/
+
+    bool operator==(const CheckValues& v) const
+    {
+        return points      == v.points      && cells      == v.cells     && cellTypes == v.cellTypes &&
+               temperature == v.temperature && velocity   == v.velocity  && cellIDs   == v.cellIDs   &&
+               pointOrder  == v.pointOrder  && cellOrder  == v.cellOrder;
+    }
+};
+
+/* \brief Write values in big endian
+ * \param out the stream to write in
+ * \param values the values to write */
+template <typename T>
+static void writeBigEndian(std::ostream& out, const std::vector<T>& values)
+{
+    for(const T& v : values)
+    {
+        uint8_t bytes[sizeof(T)];
+        memcpy(bytes, &v, sizeof(T));
+        for(size_t i = 0; i < sizeof(T); i++)
+            out.put((char)bytes[sizeof(T)-1-i]);
+    }
+    out << "\n";
+}
+
+/* \brief Write values as text, with enough digits to read them back exactly
+ * \param out the stream to write in
+ * \param values the values to write */
+template <typename T>
+static void writeText(std::ostream& out, const std::vector<T>& values)
+{
+    std::ostringstream text;
+    text.precision(17);
+    for(size_t i = 0; i < values.size(); i++)
+        text << values[i] << (i%9 == 8 || i+1 == values.size() ? "\n" : " ");
+    out << text.str();
+}
+
+/* \brief Generate an unstructured grid of hexahedra, wedges and tetrahedra with two point fields and one cell field
+ * \param path the file to write
+ * \param ascii true to write an ASCII file, false to write a BINARY file
+ * \return true on success, false otherwise */
+static bool writeDataset(const std::string& path, bool ascii)
+{
+    const uint32_t nx = 30, ny = 40, nz = 25;
+
+    //Jittered lattice : the same pseudo-random sequence for both files
+    uint32_t seed = 12345;
+    auto random = [&seed]() {seed = seed*1664525u + 1013904223u; return (seed >> 8) / (float)(1u << 24);};
+
+    std::vector<float> points;
+    for(uint32_t k = 0; k < nz; k++)
+        for(uint32_t j = 0; j < ny; j++)
+            for(uint32_t i = 0; i < nx; i++)
+            {
+                points.push_back(i + 0.25f*random());
+                points.push_back(j - 0.25f*random());
+                points.push_back(0.5f*k + 0.1f*random());
+            }
+
+    std::vector<int32_t> cells;
+    std::vector<int32_t> cellTypes;
+    auto id = [&](uint32_t i, uint32_t j, uint32_t k) {return (int32_t)(i + nx*(j + ny*k));};
+    for(uint32_t k = 0; k+1 < nz; k++)
+        for(uint32_t j = 0; j+1 < ny; j++)
+            for(uint32_t i = 0; i+1 < nx; i++)
+            {
+                int32_t a = id(i, j, k),   b = id(i+1, j, k),   c = id(i+1, j+1, k),   d = id(i, j+1, k);
+                int32_t e = id(i, j, k+1), f = id(i+1, j, k+1), g = id(i+1, j+1, k+1), h = id(i, j+1, k+1);
+                switch((i+j+k)%3)
+                {
+                    case 0:
+                        cells.insert(cells.end(), {8, a, b, c, d, e, f, g, h});
+                        cellTypes.push_back(VTK_CELL_HEXAHEDRON);
+                        break;
+                    case 1:
+                        cells.insert(cells.end(), {6, a, b, d, e, f, h,  6, b, c, d, f, g, h});
+                        cellTypes.insert(cellTypes.end(), {VTK_CELL_WEDGE, VTK_CELL_WEDGE});
+                        break;
+                    default:
+                        cells.insert(cells.end(), {4, a, b, d, e});
+                        cellTypes.push_back(VTK_CELL_TETRA);
+                        break;
+                }
+            }
+
+    uint32_t nbPoints = nx*ny*nz;
+    std::vector<double>  temperature(nbPoints);
+    std::vector<float>   velocity(3*nbPoints);
+    std::vector<int32_t> cellIDs(cellTypes.size());
+    for(uint32_t i = 0; i < nbPoints; i++)
+        temperature[i] = 100.0*random() + 1e-7*i;
+    for(float& v : velocity)
+        v = 2.0f*random() - 1.0f;
+    for(size_t i = 0; i < cellIDs.size(); i++)
+        cellIDs[i] = (int32_t)i;
+
+    std::ofstream out(path, std::ios::binary);
+    if(!out)
+        return false;
+
+    auto write = [&](auto& values)
+    {
+        if(ascii)
+            writeText(out, values);
+        else
+            writeBigEndian(out, values);
+    };
+
+    out << "# vtk DataFile Version 3.0\nSereno VTKParser check\n" << (ascii ? "ASCII" : "BINARY") << "\nDATASET UNSTRUCTURED_GRID\n";
+    out << "POINTS " << nbPoints << " float\n";
+    write(points);
+    out << "CELLS " << cellTypes.size() << " " << cells.size() << "\n";
+    write(cells);
+    out << "CELL_TYPES " << cellTypes.size() << "\n";
+    write(cellTypes);
+    out << "POINT_DATA " << nbPoints << "\nFIELD FieldData 2\n";
+    out << "temperature 1 " << nbPoints << " double\n";
+    write(temperature);
+    out << "velocity 3 " << nbPoints << " float\n";
+    write(velocity);
+    out << "CELL_DATA " << cellTypes.size() << "\nFIELD FieldData 1\n";
+    out << "id 1 " << cellTypes.size() << " int\n";
+    write(cellIDs);
+    return (bool)out;
+}
+
+/* \brief Read a field, checking its format
+ * \param parser the parser to read from
+ * \param fields the field descriptors
+ * \param index the field to read
+ * \param values[out] the values read
+ * \return true on success, false otherwise */
+template <typename T>
+static bool readField(const VTKParser& parser, const std::vector<const VTKFieldValue*>& fields, size_t index, std::vector<T>& values)
+{
+    if(index >= fields.size())
+        return false;
+    values.resize((size_t)fields[index]->nbTuples*fields[index]->nbValuePerTuple);
+    return parser.parseAllFieldValues(fields[index], values.data(), values.size()).isValid();
+}
+
+/* \brief Parse a dataset and read all its values
+ * \param path the dataset to read
+ * \param nbThreads the number of threads of the parser
+ * \param cache true to enable the binary cache
+ * \param nbParses the number of times parse() is called before reading the values
+ * \param values[out] the values read
+ * \return true on success, false otherwise */
+static bool readDataset(const std::string& path, uint32_t nbThreads, bool cache, uint32_t nbParses, CheckValues& values)
+{
+    VTKParser parser(path);
+    parser.setNbThreads(nbThreads);
+    parser.setParallelThreshold(0);
+    parser.setCacheEnabled(cache);
+    for(uint32_t i = 0; i < nbParses; i++)
+        if(!parser.parse())
+            return false;
+    values.fromCache = parser.isLoadedFromCache();
+
+    VTKPointPositions pointsDesc = parser.getUnstructuredGridPointDescriptor();
+    VTKCells          cellsDesc  = parser.getUnstructuredGridCellDescriptor();
+    VTKCellTypes      typesDesc  = parser.getUnstructuredGridCellTypesDescriptor();
+
+    values.points.resize(3*(size_t)pointsDesc.nbPoints);
+    values.cells.resize(cellsDesc.wholeSize);
+    values.cellTypes.resize(typesDesc.nbCells);
+    if(!parser.parseAllUnstructuredGridPoints(values.points.data(), values.points.size()).isValid()                ||
+       !parser.parseAllUnstructuredGridCellsComposition(values.cells.data(), values.cells.size()).isValid()        ||
+       !parser.parseAllUnstructuredGridCellTypes(values.cellTypes.data(), values.cellTypes.size()).isValid())
+        return false;
+
+    std::vector<const VTKFieldValue*> pointFields = parser.getPointFieldValueDescriptors();
+    std::vector<const VTKFieldValue*> cellFields  = parser.getCellFieldValueDescriptors();
+    if(!readField(parser, pointFields, 0, values.temperature) || !readField(parser, pointFields, 1, values.velocity) ||
+       !readField(parser, cellFields, 0, values.cellIDs))
+        return false;
+
+    values.pointOrder.resize(pointsDesc.nbPoints);
+    values.cellOrder.resize(cellsDesc.nbCells);
+    return parser.computeUnstructuredGridMortonOrder(values.points.data(), cellsDesc.nbCells, values.cells.data(), values.cells.size(),
+                                                     values.pointOrder.data(), values.cellOrder.data());
+}
+
+/* \brief Print the result of a check
+ * \param name the check name
+ * \param success the check result
+ * \return success */
+static bool report(const std::string& name, bool success)
+{
+    std::cout << (success ? "[PASS] " : "[FAIL] ") << name << std::endl;
+    return success;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string directory = (argc > 1 ? std::string(argv[1]) + "/" : std::string(""));
+    std::string binaryPath = directory + "serenoVTKParserCheck_binary.vtk";
+    std::string asciiPath  = directory + "serenoVTKParserCheck_ascii.vtk";
+
+    if(!writeDataset(binaryPath, false) || !writeDataset(asciiPath, true))
+    {
+        std::cerr << "Could not write the datasets in " << (directory.empty() ? "the working directory" : directory) << std::endl;
+        return -1;
+    }
+
+    bool success = true;
+    for(const std::string& path : {binaryPath, asciiPath})
+    {
+        std::string name = (path == binaryPath ? "BINARY" : "ASCII");
+        std::remove((path + ".vtkcache").c_str());
+
+        CheckValues serial, parallel, reparsed, cacheWritten, cacheRead;
+        if(!report(name + " : read with 1 thread", readDataset(path, 1, false, 1, serial)))
+        {
+            success = false;
+            continue;
+        }
+
+        success &= report(name + " : 1 thread and " + std::to_string(CHECK_NB_THREADS) + " threads give the same values and Morton order",
+                          readDataset(path, CHECK_NB_THREADS, false, 1, parallel) && parallel == serial);
+        success &= report(name + " : parse() called twice gives the same values",
+                          readDataset(path, CHECK_NB_THREADS, false, 2, reparsed) && reparsed == serial);
+        success &= report(name + " : values written to the cache are the parsed ones",
+                          readDataset(path, CHECK_NB_THREADS, true, 1, cacheWritten) && !cacheWritten.fromCache && cacheWritten == serial);
+        success &= report(name + " : values read back from the cache are the parsed ones",
+                          readDataset(path, CHECK_NB_THREADS, true, 1, cacheRead) && cacheRead.fromCache && cacheRead == serial);
+
+        std::remove((path + ".vtkcache").c_str());
+    }
+
+    CheckValues binary, ascii;
+    success &= report("ASCII and BINARY files give the same values",
+                      readDataset(binaryPath, CHECK_NB_THREADS, false, 1, binary) && readDataset(asciiPath, CHECK_NB_THREADS, false, 1, ascii) &&
+                      binary == ascii);
+
+    std::remove(binaryPath.c_str());
+    std::remove(asciiPath.c_str());
+    return (success ? 0 : -2);
+}
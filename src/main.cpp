@@ -21,12 +21,13 @@ int main(int argc, char* argv[])
     void* data = VTKParser_parseAllUnstructuredGridPoints(parser);
     size_t nbFieldValue = 0;
     HVTKFieldValue* fieldValues = VTKParser_getPointFieldValueDescriptors(parser, &nbFieldValue);
-    std::vector<void*> datas;
+    std::vector<VTKArrayRead> reads;
     for(uint32_t i = 0; i < nbFieldValue; i++)
     {
         std::cout << VTKParser_getFieldName(fieldValues[i]) << std::endl;
-        datas.push_back(VTKParser_parseAllFieldValues(parser, fieldValues[i]));
+        reads.push_back(VTKParser_getFieldValuesRead(fieldValues[i], NULL, 0));
     }
+    VTKParser_parseArrays(parser, reads.data(), reads.size());
 
     if(VTKParser_getDatasetType(parser) == VTK_UNSTRUCTURED_GRID)
     {
@@ -39,8 +40,8 @@ int main(int argc, char* argv[])
         VTKParser_fillUnstructuredGridCellElementBuffer(parser, cellCon.nbCells, cellValues, cellsTypes, (int32_t*)cellData);
 
         //Free everything
-        for(auto& it : datas)
-            VTKParser_free(it);
+        for(auto& it : reads)
+            VTKParser_free(it.dest);
         VTKParser_free(cellsTypes);
         VTKParser_free(data);
         VTKParser_free(cellData);